@@ -1,5 +1,7 @@
 #include "KleeGenerator.h"
 
+#include "building/BitcodeCache.h"
+#include "commands/Commands.h"
 #include "environment/EnvironmentPaths.h"
 #include "exceptions/ExecutionProcessException.h"
 #include "exceptions/FileSystemException.h"
@@ -10,10 +12,16 @@
 #include "utils/KleeUtils.h"
 #include "utils/LogUtils.h"
 #include "utils/MakefileUtils.h"
+#include "utils/ParallelUtils.h"
+#include "utils/ResourceScheduler.h"
 #include "utils/SanitizerUtils.h"
+#include "utils/stats/StageStats.h"
 
 #include "loguru.h"
 
+#include <algorithm>
+#include <mutex>
+
 using namespace tests;
 
 static const std::string GENERATION_COMPILE_MAKEFILE = "GenerationCompileMakefile.mk";
@@ -22,7 +30,8 @@ static const std::string GENERATION_KLEE_MAKEFILE = "GenerationKleeMakefile.mk";
 KleeGenerator::KleeGenerator(BaseTestGen *testGen, types::TypesHandler &typesHandler,
                              PathSubstitution filePathsSubstitution)
         : testGen(testGen), typesHandler(typesHandler),
-          pathSubstitution(std::move(filePathsSubstitution)) {
+          pathSubstitution(std::move(filePathsSubstitution)),
+          compiler(Paths::getLogDir(testGen->projectContext.projectName) / "compilation.log") {
     try {
         fs::create_directories(this->testGen->serverBuildDir);
         fs::create_directories(Paths::getLogDir(this->testGen->projectContext.projectName));
@@ -37,8 +46,34 @@ KleeGenerator::buildByCDb(const CollectionUtils::MapFileTo<fs::path> &filesToBui
                           const CollectionUtils::FileSet &stubSources) {
     LOG_SCOPE_FUNCTION(DEBUG);
     auto compileCommands = getCompileCommandsForKlee(filesToBuild, stubSources);
-    printer::DefaultMakefilePrinter makefilePrinter;
+    auto entriesToCompile = BitcodeCache::getInstance().restore(compileCommands, compiler);
+    auto commandsToCompile = CollectionUtils::transform(
+            entriesToCompile, [](BitcodeCache::Entry const &entry) { return entry.command; });
+    if (commandsToCompile.empty()) {
+        LOG_S(DEBUG) << "All bitcode files are found in store";
+    } else if (Commands::compileInProcess &&
+               std::all_of(commandsToCompile.begin(), commandsToCompile.end(), InProcessCompiler::isSupported)) {
+        auto failure = compiler.compile(commandsToCompile);
+        if (failure.has_value()) {
+            LOG_S(ERROR) << StringUtils::stringFormat("Compilation for \"%s\" failed.\nCommand: \"%s\"\n%s\n",
+                                                      failure->command.getSourcePath(),
+                                                      failure->command.toString(), failure->result.output);
+            throw ExecutionProcessException(failure->command.toString(), failure->result.outPath.value());
+        }
+    } else {
+        buildByMake(commandsToCompile);
+    }
+    BitcodeCache::getInstance().store(entriesToCompile);
+
+    auto outFiles = CollectionUtils::transform(
+            compileCommands, [](utbot::CompileCommand const &compileCommand) {
+                return BuildFileInfo{compileCommand.getOutput(), compileCommand.getSourcePath()};
+            });
+    return outFiles;
+}
 
+void KleeGenerator::buildByMake(const std::vector<utbot::CompileCommand> &compileCommands) const {
+    printer::DefaultMakefilePrinter makefilePrinter;
     std::vector<std::string> outfilePaths;
     for (const auto &compileCommand: compileCommands) {
         fs::path output = compileCommand.getOutput();
@@ -64,12 +99,6 @@ KleeGenerator::buildByCDb(const CollectionUtils::MapFileTo<fs::path> &filesToBui
                 res.outPath.value()
         );
     }
-
-    auto outFiles = CollectionUtils::transform(
-            compileCommands, [](utbot::CompileCommand const &compileCommand) {
-                return BuildFileInfo{compileCommand.getOutput(), compileCommand.getSourcePath()};
-            });
-    return outFiles;
 }
 
 std::vector<KleeGenerator::BuildFileInfo>
@@ -199,12 +228,9 @@ KleeGenerator::getCompileCommandsForKlee(const CollectionUtils::MapFileTo<fs::pa
 }
 
 
-Result<fs::path> KleeGenerator::defaultBuild(const fs::path &hintPath,
-                                             const fs::path &sourceFilePath,
-                                             const fs::path &buildDirPath,
-                                             const std::vector<std::string> &flags) {
-    LOG_SCOPE_FUNCTION(DEBUG);
-    auto bitcodeFilePath = testGen->getTargetBuildDatabase()->getBitcodeFile(sourceFilePath);
+utbot::CompileCommand KleeGenerator::getDefaultBuildCommand(const fs::path &hintPath,
+                                                           const fs::path &sourceFilePath,
+                                                           const std::vector<std::string> &flags) const {
     auto optionalCommand = getCompileCommandForKlee(hintPath, {}, flags, false);
     if (!optionalCommand.has_value()) {
         std::string message = StringUtils::stringFormat(
@@ -216,7 +242,33 @@ Result<fs::path> KleeGenerator::defaultBuild(const fs::path &hintPath,
     }
     auto &command = optionalCommand.value();
     command.setSourcePath(sourceFilePath);
-    command.setOutput(bitcodeFilePath);
+    command.setOutput(testGen->getTargetBuildDatabase()->getBitcodeFile(sourceFilePath));
+    return command;
+}
+
+Result<fs::path> KleeGenerator::defaultBuild(const fs::path &hintPath,
+                                             const fs::path &sourceFilePath,
+                                             const fs::path &buildDirPath,
+                                             const std::vector<std::string> &flags) {
+    LOG_SCOPE_FUNCTION(DEBUG);
+    auto command = getDefaultBuildCommand(hintPath, sourceFilePath, flags);
+
+    auto entriesToCompile = BitcodeCache::getInstance().restore({ command }, compiler);
+    if (entriesToCompile.empty()) {
+        return command.getOutput();
+    }
+    if (Commands::compileInProcess && InProcessCompiler::isSupported(command)) {
+        auto [out, status, _] = compiler.compile(command);
+        if (status != 0) {
+            LOG_S(ERROR) << "Compilation for " << sourceFilePath << " failed.\n"
+                         << "Command: \"" << command.toString() << "\"\n"
+                         << "Directory: " << command.getDirectory() << "\n"
+                         << out << "\n";
+            return out;
+        }
+        BitcodeCache::getInstance().store(entriesToCompile);
+        return command.getOutput();
+    }
 
     printer::DefaultMakefilePrinter makefilePrinter;
     auto commandWithChangingDirectory = utbot::CompileCommand(command, true);
@@ -237,6 +289,7 @@ Result<fs::path> KleeGenerator::defaultBuild(const fs::path &hintPath,
                      << out << "\n";
         return out;
     }
+    BitcodeCache::getInstance().store(entriesToCompile);
     return command.getOutput();
 }
 
@@ -262,32 +315,91 @@ fs::path KleeGenerator::writeKleeFile(
     }
 }
 
+void KleeGenerator::compileKleeFiles(std::vector<KleeFile> &kleeFiles, const std::vector<std::string> &flags) {
+    std::vector<utbot::CompileCommand> commands;
+    commands.reserve(kleeFiles.size());
+    for (const auto &kleeFile: kleeFiles) {
+        commands.push_back(getDefaultBuildCommand(kleeFile.sourceFilePath, kleeFile.kleeFilePath, flags));
+    }
+    if (!Commands::compileInProcess ||
+        !std::all_of(commands.begin(), commands.end(), InProcessCompiler::isSupported)) {
+        // generated makefile is shared by all klee files, so they are built one by one
+        for (auto &kleeFile: kleeFiles) {
+            ExecUtils::throwIfCancelled();
+            auto kleeBitcodeFile =
+                    defaultBuild(kleeFile.sourceFilePath, kleeFile.kleeFilePath, kleeFile.buildDirPath, flags);
+            if (kleeBitcodeFile.isSuccess()) {
+                kleeFile.bitcodeFile = kleeBitcodeFile.getOpt().value();
+            }
+        }
+        return;
+    }
+
+    auto entriesToCompile = BitcodeCache::getInstance().restore(commands, compiler);
+    std::mutex resultsMutex;
+    std::vector<BitcodeCache::Entry> compiledEntries;
+    CollectionUtils::FileSet failedOutputs;
+    {
+        auto tokens = ResourceScheduler::getInstance().acquire(ResourceScheduler::Kind::COMPILER_JOB,
+                                                               MakefileUtils::getJobsNumber());
+        ParallelUtils::forEach(entriesToCompile, tokens.count(), [&](BitcodeCache::Entry &entry) {
+            auto [out, status, _] = compiler.compile(entry.command);
+            std::lock_guard<std::mutex> lock(resultsMutex);
+            if (status == 0) {
+                compiledEntries.push_back(entry);
+            } else {
+                LOG_S(ERROR) << "Compilation for " << entry.command.getSourcePath() << " failed.\n"
+                             << "Command: \"" << entry.command.toString() << "\"\n"
+                             << "Directory: " << entry.command.getDirectory() << "\n"
+                             << out << "\n";
+                failedOutputs.insert(entry.command.getOutput());
+            }
+        });
+    }
+    BitcodeCache::getInstance().store(compiledEntries);
+    for (size_t i = 0; i < kleeFiles.size(); ++i) {
+        if (!CollectionUtils::contains(failedOutputs, commands[i].getOutput())) {
+            kleeFiles[i].bitcodeFile = commands[i].getOutput();
+        }
+    }
+}
+
 std::vector<fs::path> KleeGenerator::buildKleeFiles(const tests::TestsMap &testsMap,
                                                     const std::shared_ptr<LineInfo> &lineInfo) {
     std::vector<fs::path> outFiles;
     LOG_S(DEBUG) << "Building generated klee files...";
     printer::KleePrinter kleePrinter(&typesHandler, testGen->getTargetBuildDatabase(), utbot::Language::UNKNOWN,
                                      testGen);
+    std::vector<std::string> includeFlags = {
+            CompilationUtils::getIncludePath(Paths::getFlagsDir(testGen->projectContext))};
+    // all klee files are written first, so that they are compiled together rather than one after another
+    std::vector<KleeFile> kleeFiles;
     ExecUtils::doWorkWithProgress(
-            testsMap, testGen->progressWriter, "Building generated klee files",
+            testsMap, testGen->progressWriter, "Writing generated klee files",
             [&](auto const &it) {
                 const auto &[filename, tests] = it;
                 if (lineInfo != nullptr && filename != lineInfo->filePath) {
                     return;
                 }
                 kleePrinter.srcLanguage = Paths::getSourceLanguage(filename);
-                std::vector<std::string> includeFlags = {
-                        CompilationUtils::getIncludePath(Paths::getFlagsDir(testGen->projectContext))};
                 auto buildDirPath =
                         testGen->getClientCompilationUnitInfo(filename)->getDirectory();
-
-                fs::path kleeFilePath = writeKleeFile(kleePrinter, tests, lineInfo);
+                kleeFiles.push_back({&tests, filename, writeKleeFile(kleePrinter, tests, lineInfo), buildDirPath});
+            });
+    compileKleeFiles(kleeFiles, includeFlags);
+    ExecUtils::doWorkWithProgress(
+            kleeFiles, testGen->progressWriter, "Building generated klee files",
+            [&](KleeFile const &kleeFile) {
+                const auto &filename = kleeFile.sourceFilePath;
+                const auto &tests = *kleeFile.tests;
+                const auto &buildDirPath = kleeFile.buildDirPath;
+                fs::path kleeFilePath = kleeFile.kleeFilePath;
+                kleePrinter.srcLanguage = Paths::getSourceLanguage(filename);
                 auto kleeFilesInfo =
                         testGen->getClientCompilationUnitInfo(
                                 tests.sourceFilePath)->kleeFilesInfo;
-                auto kleeBitcodeFile = defaultBuild(filename, kleeFilePath, buildDirPath, includeFlags);
-                if (kleeBitcodeFile.isSuccess()) {
-                    outFiles.emplace_back(kleeBitcodeFile.getOpt().value());
+                if (kleeFile.bitcodeFile.has_value()) {
+                    outFiles.emplace_back(kleeFile.bitcodeFile.value());
                     kleeFilesInfo->setAllAreCorrect(true);
                     LOG_S(MAX) << "Klee filepath: " << outFiles.back();
                 } else {
@@ -332,7 +444,7 @@ std::vector<fs::path> KleeGenerator::buildKleeFiles(const tests::TestsMap &tests
                                                          tests::Tests::MethodDescription const &method) -> bool {
                                                      return kleeFilesInfo->isCorrectMethod(method.name);
                                                  });
-                    kleeBitcodeFile = defaultBuild(filename, kleeFilePath, buildDirPath, includeFlags);
+                    auto kleeBitcodeFile = defaultBuild(filename, kleeFilePath, buildDirPath, includeFlags);
                     if (kleeBitcodeFile.isSuccess()) {
                         outFiles.emplace_back(kleeBitcodeFile.getOpt().value());
                     } else {
@@ -349,20 +461,22 @@ std::vector<fs::path> KleeGenerator::buildKleeFiles(const tests::TestsMap &tests
 void KleeGenerator::parseKTestsToFinalCode(
         const utbot::ProjectContext &projectContext,
         tests::Tests &tests,
-        const std::unordered_map<std::string, types::Type> &methodNameToReturnTypeMap,
         const std::vector<MethodKtests> &kleeOutput,
         const std::shared_ptr<LineInfo> &lineInfo,
         bool verbose,
         ErrorMode errorMode) {
-    for (const auto &batch: kleeOutput) {
-        bool filterByFlag = (lineInfo != nullptr && !lineInfo->forMethod && !lineInfo->forClass &&
-                             !lineInfo->predicateInfo.has_value());
-        tests::KTestObjectParser KTestObjectParser(typesHandler);
-        KTestObjectParser.parseKTest(batch, tests, methodNameToReturnTypeMap, filterByFlag,
-                                     lineInfo);
+    {
+        MEASURE_STAGE_EXECUTION_TIME("ktest parse")
+        for (const auto &batch: kleeOutput) {
+            bool filterByFlag = (lineInfo != nullptr && !lineInfo->forMethod && !lineInfo->forClass &&
+                                 !lineInfo->predicateInfo.has_value());
+            tests::KTestObjectParser KTestObjectParser(typesHandler);
+            KTestObjectParser.parseKTest(batch, tests, filterByFlag,
+                                         lineInfo);
+        }
     }
-    printer::TestsPrinter testsPrinter(testGen->projectContext, &typesHandler,
-                                       Paths::getSourceLanguage(tests.sourceFilePath));
+    MEASURE_STAGE_EXECUTION_TIME("print")
+    std::vector<Tests::MethodDescription *> methodsToPrint;
     for (auto it = tests.methods.begin(); it != tests.methods.end(); it++) {
         const std::string &methodName = it.key();
         Tests::MethodDescription &methodDescription = it.value();
@@ -377,11 +491,20 @@ void KleeGenerator::parseKTestsToFinalCode(
         if (methodDescription.testCases.empty()) {
             continue;
         }
-        auto predicate =
-                lineInfo ? lineInfo->predicateInfo : std::optional<LineInfo::PredicateInfo>{};
-        testsPrinter.genCode(methodDescription, predicate, verbose, errorMode);
+        methodsToPrint.push_back(&methodDescription);
     }
+    auto predicate =
+            lineInfo ? lineInfo->predicateInfo : std::optional<LineInfo::PredicateInfo>{};
+    // every method is printed into its own MethodDescription, so methods are independent;
+    // joinToFinalCode concatenates them in the original order
+    ParallelUtils::forEach(methodsToPrint, [&](Tests::MethodDescription *methodDescription) {
+        printer::TestsPrinter methodPrinter(testGen->projectContext, &typesHandler,
+                                            Paths::getSourceLanguage(tests.sourceFilePath));
+        methodPrinter.genCode(*methodDescription, predicate, verbose, errorMode);
+    });
 
+    printer::TestsPrinter testsPrinter(testGen->projectContext, &typesHandler,
+                                       Paths::getSourceLanguage(tests.sourceFilePath));
     printer::HeaderPrinter(Paths::getSourceLanguage(tests.sourceFilePath))
             .print(tests.testHeaderFilePath, tests.sourceFilePath, tests.headerCode);
     testsPrinter.joinToFinalCode(tests, tests.testHeaderFilePath);
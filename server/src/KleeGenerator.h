@@ -7,6 +7,7 @@
 #include "SettingsContext.h"
 #include "Tests.h"
 #include "building/BuildDatabase.h"
+#include "building/InProcessCompiler.h"
 #include "exceptions/CompilationDatabaseException.h"
 #include "printers/KleePrinter.h"
 #include "printers/TestsPrinter.h"
@@ -114,7 +115,6 @@ public:
     void parseKTestsToFinalCode(
             const utbot::ProjectContext &projectContext,
             tests::Tests &tests,
-            const std::unordered_map<std::string, types::Type> &methodNameToReturnTypeMap,
             const std::vector<MethodKtests> &kleeOutput,
             const std::shared_ptr<LineInfo> &lineInfo = nullptr,
             bool verbose = false,
@@ -149,9 +149,31 @@ private:
     BaseTestGen *testGen;
     types::TypesHandler typesHandler;
     PathSubstitution pathSubstitution;
+    InProcessCompiler compiler;
 
     CollectionUtils::MapFileTo<std::vector<std::string>> failedFunctions;
 
+    struct KleeFile {
+        const Tests *tests;
+        fs::path sourceFilePath;
+        fs::path kleeFilePath;
+        fs::path buildDirPath;
+        /// std::nullopt if the file is not compiled
+        std::optional<fs::path> bitcodeFile;
+    };
+
+    void buildByMake(const std::vector<utbot::CompileCommand> &compileCommands) const;
+
+    utbot::CompileCommand getDefaultBuildCommand(const fs::path &hintPath,
+                                                 const fs::path &sourceFilePath,
+                                                 const std::vector<std::string> &flags) const;
+
+    /**
+     * Compiles klee files of different sources in parallel when they are compiled in process,
+     * otherwise one by one, and sets bitcode files of compiled ones.
+     */
+    void compileKleeFiles(std::vector<KleeFile> &kleeFiles, const std::vector<std::string> &flags);
+
     fs::path writeKleeFile(
             printer::KleePrinter &kleePrinter,
             Tests const &tests,
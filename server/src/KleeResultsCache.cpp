@@ -0,0 +1,314 @@
+#include "KleeResultsCache.h"
+
+#include "Paths.h"
+#include "Version.h"
+#include "utils/FileSystemUtils.h"
+#include "utils/KleeUtils.h"
+
+#include "loguru.h"
+
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/IR/DebugInfoMetadata.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/ModuleSlotTracker.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/SHA1.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+    /**
+     * Metadata and attribute groups are referred by numbers which are given in order of
+     * the whole module, so they are removed from printed values outside of string literals.
+     * Debug locations are hashed by content instead.
+     */
+    std::string removeModuleNumbers(const std::string &text) {
+        std::string result;
+        result.reserve(text.size());
+        bool inQuotes = false;
+        for (size_t i = 0; i < text.size(); ++i) {
+            char c = text[i];
+            result += c;
+            if (c == '"') {
+                inQuotes = !inQuotes;
+            } else if (!inQuotes && (c == '!' || c == '#')) {
+                while (i + 1 < text.size() && std::isdigit(static_cast<unsigned char>(text[i + 1]))) {
+                    ++i;
+                }
+            }
+        }
+        return result;
+    }
+
+    void update(llvm::SHA1 &hasher, const std::string &data) {
+        hasher.update(data);
+        // separator, so that neighbouring strings are not mixed up
+        hasher.update(llvm::StringRef("", 1));
+    }
+
+    /// hash of a function or a global itself and of values it refers to
+    struct GlobalSummary {
+        std::string hash;
+        std::vector<const llvm::GlobalValue *> globals;
+        std::vector<const llvm::StructType *> types;
+    };
+
+    class GlobalSummarizer {
+    public:
+        explicit GlobalSummarizer(llvm::ModuleSlotTracker &slotTracker) : slotTracker(slotTracker) {
+        }
+
+        GlobalSummary summarize(const llvm::GlobalValue &global) {
+            std::string text;
+            llvm::raw_string_ostream stream(text);
+            if (auto function = llvm::dyn_cast<llvm::Function>(&global)) {
+                printFunction(stream, *function);
+            } else {
+                global.print(stream, slotTracker);
+                addType(global.getValueType());
+                for (const llvm::Use &operand : global.operands()) {
+                    addOperand(operand.get());
+                }
+            }
+            llvm::SHA1 hasher;
+            update(hasher, removeModuleNumbers(stream.str()));
+            summary.hash = llvm::toHex(hasher.final(), true);
+            return std::move(summary);
+        }
+
+    private:
+        llvm::ModuleSlotTracker &slotTracker;
+        GlobalSummary summary;
+        std::unordered_set<const llvm::Value *> visited;
+        std::unordered_set<const llvm::Type *> visitedTypes;
+
+        void addOperand(const llvm::Value *value) {
+            addType(value->getType());
+            if (!visited.insert(value).second) {
+                return;
+            }
+            if (auto global = llvm::dyn_cast<llvm::GlobalValue>(value)) {
+                summary.globals.push_back(global);
+            } else if (auto constant = llvm::dyn_cast<llvm::Constant>(value)) {
+                for (const llvm::Use &operand : constant->operands()) {
+                    addOperand(operand.get());
+                }
+            }
+        }
+
+        void addType(const llvm::Type *type) {
+            if (!visitedTypes.insert(type).second) {
+                return;
+            }
+            if (auto structType = llvm::dyn_cast<llvm::StructType>(type); structType && !structType->isLiteral()) {
+                summary.types.push_back(structType);
+            }
+            for (llvm::Type *subtype : type->subtypes()) {
+                addType(subtype);
+            }
+        }
+
+        void printFunction(llvm::raw_ostream &stream, const llvm::Function &function) {
+            stream << "function " << function.getName() << ' ' << function.getLinkage() << ' '
+                   << function.getAttributes().getFnAttrs().getAsString() << ' ';
+            function.getFunctionType()->print(stream);
+            addType(function.getFunctionType());
+            if (function.isDeclaration()) {
+                return;
+            }
+            slotTracker.incorporateFunction(function);
+            for (const llvm::BasicBlock &block : function) {
+                stream << '\n';
+                block.printAsOperand(stream, false, slotTracker);
+                for (const llvm::Instruction &instruction : block) {
+                    stream << '\n';
+                    instruction.print(stream, slotTracker);
+                    if (const llvm::DebugLoc &location = instruction.getDebugLoc()) {
+                        stream << " @" << location->getDirectory() << '/' << location->getFilename() << ':'
+                               << location.getLine() << ':' << location.getCol();
+                    }
+                    addType(instruction.getType());
+                    if (auto gep = llvm::dyn_cast<llvm::GetElementPtrInst>(&instruction)) {
+                        addType(gep->getSourceElementType());
+                    } else if (auto alloca = llvm::dyn_cast<llvm::AllocaInst>(&instruction)) {
+                        addType(alloca->getAllocatedType());
+                    }
+                    for (const llvm::Use &operand : instruction.operands()) {
+                        addOperand(operand.get());
+                    }
+                }
+            }
+        }
+    };
+
+    std::string getStructBody(const llvm::StructType *structType) {
+        std::string text;
+        llvm::raw_string_ostream stream(text);
+        stream << "type " << structType->getName() << (structType->isPacked() ? " packed" : "")
+               << (structType->isOpaque() ? " opaque" : "");
+        for (llvm::Type *element : structType->elements()) {
+            stream << ' ';
+            element->print(stream);
+        }
+        return stream.str();
+    }
+}
+
+struct KleeResultsCache::ModuleInfo {
+    std::unique_ptr<llvm::Module> module;
+    std::unique_ptr<llvm::ModuleSlotTracker> slotTracker;
+    /// summaries are shared by fingerprints of all functions which reach the value
+    std::unordered_map<const llvm::GlobalValue *, GlobalSummary> summaries;
+
+    const GlobalSummary &getSummary(const llvm::GlobalValue *global) {
+        auto it = summaries.find(global);
+        if (it == summaries.end()) {
+            it = summaries.emplace(global, GlobalSummarizer(*slotTracker).summarize(*global)).first;
+        }
+        return it->second;
+    }
+};
+
+const std::string KleeResultsCache::FINGERPRINT_FILE = "fingerprint";
+
+KleeResultsCache::KleeResultsCache(utbot::ProjectContext projectContext,
+                                   const utbot::SettingsContext &settingsContext,
+                                   fs::path resultsDir)
+    : projectContext(std::move(projectContext)), resultsDir(std::move(resultsDir)),
+      context(std::make_unique<llvm::LLVMContext>()) {
+    std::stringstream settings;
+    settings << UTBOT_BUILD_VERSION << ' '
+             << (settingsContext.timeoutPerFunction.has_value() ? settingsContext.timeoutPerFunction->count() : 0)
+             << ' ' << settingsContext.useDeterministicSearcher;
+    settingsFingerprint = settings.str();
+}
+
+KleeResultsCache::~KleeResultsCache() = default;
+
+std::optional<fs::path> KleeResultsCache::find(const tests::Tests &tests, const tests::TestMethod &method) {
+    fs::path methodResultsDir = getResultsDir(tests, method);
+    fs::path fingerprintPath = methodResultsDir / FINGERPRINT_FILE;
+    if (!fs::exists(fingerprintPath)) {
+        return std::nullopt;
+    }
+    std::optional<std::string> fingerprint = getFingerprint(tests, method);
+    if (!fingerprint.has_value()) {
+        return std::nullopt;
+    }
+    std::ifstream stream(fingerprintPath.string());
+    std::string savedFingerprint;
+    stream >> savedFingerprint;
+    if (savedFingerprint != fingerprint.value()) {
+        return std::nullopt;
+    }
+    LOG_S(DEBUG) << "Results of KLEE are reused for unchanged function " << method.methodName;
+    return methodResultsDir;
+}
+
+void KleeResultsCache::save(const tests::Tests &tests, const tests::TestMethod &method, const fs::path &kleeOut) {
+    fs::path methodResultsDir = getResultsDir(tests, method);
+    try {
+        if (fs::exists(methodResultsDir)) {
+            FileSystemUtils::removeAll(methodResultsDir);
+        }
+        std::optional<std::string> fingerprint = getFingerprint(tests, method);
+        if (!fingerprint.has_value() || !fs::exists(kleeOut)) {
+            return;
+        }
+        fs::create_directories(methodResultsDir.parent_path());
+        try {
+            // output of KLEE is not changed afterwards, so its files are shared instead of copied
+            std::filesystem::copy(kleeOut.string(), methodResultsDir.string(),
+                                  std::filesystem::copy_options::recursive |
+                                      std::filesystem::copy_options::create_hard_links);
+        } catch (const std::filesystem::filesystem_error &e) {
+            if (e.code() != std::errc::cross_device_link) {
+                throw;
+            }
+            // KLEE writes to another file system, see --klee-output-dir
+            FileSystemUtils::removeAll(methodResultsDir);
+            std::filesystem::copy(kleeOut.string(), methodResultsDir.string(),
+                                  std::filesystem::copy_options::recursive);
+        }
+        // the fingerprint is written last, so partially copied results are never reused
+        FileSystemUtils::writeToFile(methodResultsDir / FINGERPRINT_FILE, fingerprint.value());
+    } catch (const std::filesystem::filesystem_error &e) {
+        LOG_S(WARNING) << "Results of KLEE for " << method.methodName << " are not saved: " << e.what();
+    }
+}
+
+void KleeResultsCache::clear() {
+    if (fs::exists(resultsDir)) {
+        FileSystemUtils::removeAll(resultsDir);
+    }
+}
+
+fs::path KleeResultsCache::getResultsDir(const tests::Tests &tests, const tests::TestMethod &method) const {
+    return Paths::kleeResultsDirForEntrypoint(projectContext, resultsDir, tests.sourceFilePath,
+                                              KleeUtils::entryPointFunction(tests, method.methodName, true));
+}
+
+std::optional<std::string> KleeResultsCache::getFingerprint(const tests::Tests &tests,
+                                                            const tests::TestMethod &method) {
+    ModuleInfo *moduleInfo = getModule(method.bitcodeFilePath);
+    if (moduleInfo == nullptr) {
+        return std::nullopt;
+    }
+    const llvm::Function *entryPoint =
+        moduleInfo->module->getFunction(KleeUtils::entryPointFunction(tests, method.methodName, true));
+    if (entryPoint == nullptr) {
+        return std::nullopt;
+    }
+    llvm::SHA1 hasher;
+    update(hasher, settingsFingerprint + ' ' + std::to_string(method.is32bits));
+    // layouts of types are hashed in order of names, which doesn't depend on the traversal
+    std::map<std::string, const llvm::StructType *> types;
+    std::vector<const llvm::GlobalValue *> worklist{ entryPoint };
+    std::unordered_set<const llvm::GlobalValue *> visited{ entryPoint };
+    while (!worklist.empty()) {
+        const llvm::GlobalValue *global = worklist.back();
+        worklist.pop_back();
+        const GlobalSummary &summary = moduleInfo->getSummary(global);
+        update(hasher, summary.hash);
+        for (const llvm::GlobalValue *reference : summary.globals) {
+            if (visited.insert(reference).second) {
+                worklist.push_back(reference);
+            }
+        }
+        for (const llvm::StructType *structType : summary.types) {
+            types.emplace(structType->getName().str(), structType);
+        }
+    }
+    for (const auto &[name, structType] : types) {
+        update(hasher, getStructBody(structType));
+    }
+    return llvm::toHex(hasher.final(), true);
+}
+
+KleeResultsCache::ModuleInfo *KleeResultsCache::getModule(const fs::path &bitcodeFilePath) {
+    auto it = modules.find(bitcodeFilePath);
+    if (it == modules.end()) {
+        llvm::SMDiagnostic error;
+        std::unique_ptr<ModuleInfo> moduleInfo;
+        std::unique_ptr<llvm::Module> module = llvm::parseIRFile(bitcodeFilePath.string(), error, *context);
+        if (module != nullptr) {
+            moduleInfo = std::make_unique<ModuleInfo>();
+            moduleInfo->slotTracker = std::make_unique<llvm::ModuleSlotTracker>(module.get());
+            moduleInfo->module = std::move(module);
+        } else {
+            LOG_S(WARNING) << "Bitcode is not fingerprinted, KLEE is run for all its functions: "
+                           << bitcodeFilePath << ": " << error.getMessage().str();
+        }
+        it = modules.emplace(bitcodeFilePath, std::move(moduleInfo)).first;
+    }
+    return it->second.get();
+}
@@ -0,0 +1,82 @@
+#ifndef UNITTESTBOT_KLEERESULTSCACHE_H
+#define UNITTESTBOT_KLEERESULTSCACHE_H
+
+#include "ProjectContext.h"
+#include "SettingsContext.h"
+#include "Tests.h"
+
+#include "utils/path/FileSystemPath.h"
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace llvm {
+    class LLVMContext;
+}
+
+/**
+ * Keeps output of KLEE for every tested function between generations, so that KLEE
+ * is run again only for functions which have changed. A function is identified by
+ * a fingerprint of the linked bitcode KLEE runs: instructions and debug locations of
+ * the entry point and of all functions and globals reachable from it, layouts of used
+ * types and settings which affect KLEE. Tests of unchanged functions are printed
+ * from the kept output, as if KLEE had been run.
+ *
+ * The same store serves as the journal of a project generation: output is kept as soon as
+ * KLEE finishes for a file, so an interrupted generation is resumed from the journal.
+ */
+class KleeResultsCache {
+public:
+    /**
+     * @param resultsDir directory where output of KLEE is kept
+     */
+    KleeResultsCache(utbot::ProjectContext projectContext,
+                     const utbot::SettingsContext &settingsContext,
+                     fs::path resultsDir);
+
+    ~KleeResultsCache();
+
+    KleeResultsCache(const KleeResultsCache &) = delete;
+    KleeResultsCache &operator=(const KleeResultsCache &) = delete;
+
+    /**
+     * @return directory with output of KLEE for the method if the method has not changed
+     * since it was saved
+     */
+    std::optional<fs::path> find(const tests::Tests &tests, const tests::TestMethod &method);
+
+    /**
+     * Keeps output of KLEE for the method until the next generation. Files of the output are
+     * hard-linked, unless they are on another file system.
+     * @param kleeOut output directory of KLEE for the method
+     */
+    void save(const tests::Tests &tests, const tests::TestMethod &method, const fs::path &kleeOut);
+
+    /**
+     * Removes all kept output.
+     */
+    void clear();
+
+private:
+    /// parsed bitcode file with summaries of its functions and globals
+    struct ModuleInfo;
+
+    static const std::string FINGERPRINT_FILE;
+
+    const utbot::ProjectContext projectContext;
+    const fs::path resultsDir;
+    std::string settingsFingerprint;
+    std::unique_ptr<llvm::LLVMContext> context;
+    /// linked bitcode files parsed so far, nullptr if a file can't be parsed
+    std::map<fs::path, std::unique_ptr<ModuleInfo>> modules;
+
+    fs::path getResultsDir(const tests::Tests &tests, const tests::TestMethod &method) const;
+
+    std::optional<std::string> getFingerprint(const tests::Tests &tests, const tests::TestMethod &method);
+
+    ModuleInfo *getModule(const fs::path &bitcodeFilePath);
+};
+
+
+#endif // UNITTESTBOT_KLEERESULTSCACHE_H
@@ -1,8 +1,11 @@
 #include "KleeRunner.h"
 
+#include "KleeResultsCache.h"
 #include "Paths.h"
 #include "TimeExecStatistics.h"
 #include "SARIFGenerator.h"
+#include "clang-utils/TestHeadersGenerator.h"
+#include "commands/Commands.h"
 #include "exceptions/FileNotPresentedInArtifactException.h"
 #include "exceptions/FileNotPresentedInCommandsException.h"
 #include "tasks/RunKleeTask.h"
@@ -10,12 +13,16 @@
 #include "utils/FileSystemUtils.h"
 #include "utils/KleeUtils.h"
 #include "utils/LogUtils.h"
-#include "utils/stats/CSVReader.h"
+#include "utils/ResourceScheduler.h"
+#include "utils/stats/KleeStats.h"
+#include "utils/stats/StageStats.h"
 #include "utils/stats/TestsGenerationStats.h"
 
 #include "loguru.h"
 
+#include <filesystem>
 #include <fstream>
+#include <system_error>
 #include <utility>
 
 using namespace tests;
@@ -26,21 +33,46 @@ namespace {
         fs::remove(kleeDir / "run.istats");
     }
 
-    StatsUtils::KleeStats writeKleeStats(const fs::path &kleeOut) {
-        ShellExecTask::ExecutionParameters kleeStatsParams("klee-stats",
-                                                           {"--utbot-config", kleeOut.string(),
-                                                            "--table-format=readable-csv"});
-        auto[out, status, _] = ShellExecTask::runShellCommandTask(kleeStatsParams);
-        if (status != 0) {
-            LOG_S(ERROR) << "klee-stats call failed:" << "\n" << out;
-            return {};
+    fs::path getMethodKleeOut(const utbot::ProjectContext &projectContext,
+                              const tests::Tests &tests,
+                              const TestMethod &method,
+                              bool interactiveMode) {
+        return interactiveMode ? Paths::kleeOutDirForEntrypoints(projectContext, tests.sourceFilePath, "") /
+                                     KleeUtils::entryPointFunction(tests, method.methodName, true)
+                               : Paths::kleeOutDirForEntrypoints(projectContext, tests.sourceFilePath,
+                                                                 method.methodName);
+    }
+
+    std::map<std::string, StatsUtils::KleeStats>
+    readMethodsKleeStats(const utbot::ProjectContext &projectContext,
+                         const tests::Tests &tests,
+                         const std::vector<TestMethod> &batch,
+                         bool interactiveMode) {
+        std::map<std::string, StatsUtils::KleeStats> methodsKleeStats;
+        for (const auto &method : batch) {
+            fs::path kleeOut = getMethodKleeOut(projectContext, tests, method, interactiveMode);
+            fs::path runStats = kleeOut / "run.stats";
+            if (!fs::exists(runStats)) {
+                continue;
+            }
+            if (auto kleeStats = StatsUtils::readRunStats(runStats); kleeStats.has_value()) {
+                LOG_S(DEBUG) << "KLEE stats for " << method.methodName << ": time "
+                             << kleeStats->getKleeTime().count() << " ms, solver time "
+                             << kleeStats->getSolverTime().count() << " ms, "
+                             << kleeStats->getSolverQueries() << " queries, max states "
+                             << kleeStats->getMaxStates();
+                methodsKleeStats.emplace(method.methodName, kleeStats.value());
+            }
         }
-        LOG_S(DEBUG) << "klee-stats report:" << '\n' << out;
-        std::stringstream ss(out);
-        return StatsUtils::KleeStats(ss);
+        return methodsKleeStats;
     }
 }
 
+static void processMethod(MethodKtests &ktestChunk,
+                          tests::Tests &tests,
+                          const fs::path &kleeOut,
+                          const tests::TestMethod &method);
+
 KleeRunner::KleeRunner(utbot::ProjectContext projectContext,
                        utbot::SettingsContext settingsContext)
     : projectContext(std::move(projectContext)), settingsContext(std::move(settingsContext)) {
@@ -49,10 +81,12 @@ KleeRunner::KleeRunner(utbot::ProjectContext projectContext,
 void KleeRunner::runKlee(const std::vector<tests::TestMethod> &testMethods,
                          tests::TestsMap &testsMap,
                          const std::shared_ptr<KleeGenerator> &generator,
-                         const std::unordered_map<std::string, types::Type> &methodNameToReturnTypeMap,
                          const std::shared_ptr<LineInfo> &lineInfo,
                          TestsWriter *testsWriter,
+                         TestHeadersGenerator &testHeaders,
                          bool isBatched,
+                         bool journal,
+                         bool resume,
                          bool interactiveMode,
                          StatsUtils::TestsGenerationStatsFileMap &generationStats) {
     LOG_SCOPE_FUNCTION(DEBUG);
@@ -67,7 +101,19 @@ void KleeRunner::runKlee(const std::vector<tests::TestMethod> &testMethods,
         fileToMethods[method.sourceFilePath].push_back(method);
     }
 
-    nlohmann::json sarifResults = nlohmann::json::array();
+    sarif::SarifResultsWriter sarifWriter(projectContext, kleeOutDir / sarif::SARIF_FILE_NAME);
+    std::optional<KleeResultsCache> resultsCache;
+    if (settingsContext.incrementalGeneration) {
+        resultsCache.emplace(projectContext, settingsContext, Paths::getKleeResultsDir(projectContext));
+    }
+    // output of KLEE for generated files is journaled, so that a long generation is not started over
+    std::optional<KleeResultsCache> generationJournal;
+    if (isBatched && (journal || resume)) {
+        generationJournal.emplace(projectContext, settingsContext, Paths::getGenerationJournalDir(projectContext));
+        if (!resume) {
+            generationJournal->clear();
+        }
+    }
 
     std::function<void(tests::Tests &tests)> prepareTests = [&](tests::Tests &tests) {
         fs::path filePath = tests.sourceFilePath;
@@ -100,21 +146,58 @@ void KleeRunner::runKlee(const std::vector<tests::TestMethod> &testMethods,
             }
             LOG_S(MAX) << logStream.str();
         }
-        if (interactiveMode) {
-            processBatchWithInteractive(batch, tests, ktests);
-        } else {
-            processBatchWithoutInteractive(batch, tests, ktests);
+        std::vector<TestMethod> methodsToRun;
+        for (const auto &method : batch) {
+            std::optional<fs::path> results;
+            if (generationJournal.has_value() && resume) {
+                results = generationJournal->find(tests, method);
+            }
+            if (!results.has_value() && resultsCache.has_value()) {
+                results = resultsCache->find(tests, method);
+            }
+            if (results.has_value()) {
+                MethodKtests ktestChunk;
+                processMethod(ktestChunk, tests, results.value(), method);
+                ktests.push_back(ktestChunk);
+            } else {
+                methodsToRun.push_back(method);
+            }
+        }
+        if (resultsCache.has_value() || (generationJournal.has_value() && resume)) {
+            LOG_S(DEBUG) << "KLEE is run for " << methodsToRun.size() << " of " << batch.size()
+                         << " functions of " << filePath << ", others are unchanged";
+        }
+        {
+            MEASURE_STAGE_EXECUTION_TIME("klee")
+            if (interactiveMode) {
+                processBatchWithInteractive(methodsToRun, tests, ktests);
+            } else {
+                processBatchWithoutInteractive(methodsToRun, tests, ktests);
+            }
         }
-        auto kleeStats = writeKleeStats(Paths::kleeOutDirForFilePath(projectContext, filePath));
-        generator->parseKTestsToFinalCode(projectContext, tests, methodNameToReturnTypeMap, ktests,
+        for (const auto &method : methodsToRun) {
+            fs::path kleeOut = getMethodKleeOut(projectContext, tests, method, interactiveMode);
+            if (resultsCache.has_value()) {
+                resultsCache->save(tests, method, kleeOut);
+            }
+            if (generationJournal.has_value()) {
+                generationJournal->save(tests, method, kleeOut);
+            }
+        }
+        auto kleeStats = StatsUtils::readKleeStats(Paths::kleeOutDirForFilePath(projectContext, filePath));
+        auto methodsKleeStats = readMethodsKleeStats(projectContext, tests, methodsToRun, interactiveMode);
+        testHeaders.setTestHeader(tests);
+        generator->parseKTestsToFinalCode(projectContext, tests, ktests,
                                           lineInfo, settingsContext.verbose, settingsContext.errorMode);
-        generationStats.addFileStats(kleeStats, tests);
+        generationStats.addFileStats(kleeStats, tests, std::move(methodsKleeStats));
 
-        sarif::sarifAddTestsToResults(projectContext, tests, sarifResults);
+        MEASURE_STAGE_EXECUTION_TIME("sarif")
+        sarifWriter.addTestsToResults(tests);
     };
 
     std::function<void()> prepareTotal = [&]() {
-        testsWriter->writeReport(sarif::sarifPackResults(sarifResults),
+        sarifWriter.finish();
+        testsWriter->writeReport(kleeOutDir / sarif::SARIF_FILE_NAME,
                                  "Sarif Report was created",
                                  projectContext.getReportDirAbsPath() / sarif::SARIF_FILE_NAME);
     };
@@ -126,7 +209,15 @@ void KleeRunner::runKlee(const std::vector<tests::TestMethod> &testMethods,
         std::move(prepareTests),
         std::move(prepareTotal));
 
+    if (generationJournal.has_value()) {
+        generationJournal->clear();
+    }
     fs::remove_all(kleeOutDir);
+    if (!Commands::kleeOutputDir.empty()) {
+        // directory of the project is kept while another request of the project uses it
+        std::error_code ec;
+        std::filesystem::remove(kleeOutDir.parent_path().string(), ec);
+    }
 }
 
 static void processMethod(MethodKtests &ktestChunk,
@@ -238,6 +329,8 @@ KleeRunner::createKleeParams(const tests::TestMethod &testMethod,
         "--skip-not-symbolic-objects",
         "--use-tbaa",
         "--ubsan-runtime",
+        // assembly of the module is not read, only test cases are
+        "--output-source=false",
         "--output-dir=" + kleeOut.string()
     };
     if (Paths::isCXXFile(testMethod.sourceFilePath)) {
@@ -290,8 +383,11 @@ void KleeRunner::processBatchWithoutInteractive(const std::vector<tests::TestMet
             LOG_S(DEBUG) << "Klee command: " + StringUtils::joinWith(argvData, " ");
             MEASURE_FUNCTION_EXECUTION_TIME
 
-            RunKleeTask task(cargv.size(), cargv.data(), settingsContext.timeoutPerFunction);
-            ExecUtils::ExecutionResult result __attribute__((unused)) = task.run();
+            {
+                auto tokens = ResourceScheduler::getInstance().acquire(ResourceScheduler::Kind::KLEE_PROCESS);
+                RunKleeTask task(cargv.size(), cargv.data(), settingsContext.timeoutPerFunction);
+                ExecUtils::ExecutionResult result __attribute__((unused)) = task.run();
+            }
             ExecUtils::throwIfCancelled();
 
             MethodKtests ktestChunk;
@@ -319,10 +415,13 @@ void KleeRunner::processBatchWithInteractive(const std::vector<tests::TestMethod
     }
 
     auto [argvData, kleeOut] = createKleeParams(testMethods[0], tests, "");
+    // each process of interactive KLEE takes a token, so there are as many processes as tokens
+    std::optional<ResourceScheduler::Tokens> tokens = ResourceScheduler::getInstance().acquire(
+        ResourceScheduler::Kind::KLEE_PROCESS, KleeUtils::getProcessNumber());
     {
         // additional KLEE arguments
         argvData.emplace_back("--interactive");
-        argvData.emplace_back(KleeUtils::processNumberOption());
+        argvData.emplace_back(KleeUtils::processNumberOption(tokens->count()));
         {
             // entrypoints
             fs::path entrypoints = kleeOut.parent_path() / "entrypoints.txt";
@@ -352,6 +451,7 @@ void KleeRunner::processBatchWithInteractive(const std::vector<tests::TestMethod
                              ? settingsContext.timeoutPerFunction.value() * testMethods.size()
                              : settingsContext.timeoutPerFunction);
         ExecUtils::ExecutionResult result __attribute__((unused)) = task.run();
+        tokens.reset();
 
         ExecUtils::throwIfCancelled();
 
@@ -13,6 +13,8 @@
 
 #include <vector>
 
+class TestHeadersGenerator;
+
 class KleeRunner {
 public:
     KleeRunner(utbot::ProjectContext projectContext,
@@ -24,14 +26,18 @@ public:
      * Pass no more than `batchSize` methods to the scrypt simultaneously.
      * @param testMethods Vector of names of testing source methods and linked bitcode files where
      * they defined.
+     * @param testHeaders Generator of test headers, tests of a file are printed when its header is ready.
+     * @param journal Journal output of KLEE of batched request, so that an interrupted generation
+     * can be resumed.
+     * @param resume Reuse output of KLEE journaled by an interrupted generation of batched request.
      * @return Vector of KTestObject chunks. Each chunk contains data of
      * generated unit tests for each batch.
      * @throws ExecutionProcessException if a Clang call returns non-zero code.
      */
     void runKlee(const std::vector<tests::TestMethod> &testMethods, tests::TestsMap &testsMap,
                  const std::shared_ptr<KleeGenerator> &generator,
-                 const std::unordered_map<std::string, types::Type> &methodNameToReturnTypeMap,
-                 const std::shared_ptr<LineInfo> &lineInfo, TestsWriter *testsWriter, bool isBatched,
+                 const std::shared_ptr<LineInfo> &lineInfo, TestsWriter *testsWriter,
+                 TestHeadersGenerator &testHeaders, bool isBatched, bool journal, bool resume,
                  bool interactiveMode,
                  StatsUtils::TestsGenerationStatsFileMap &generationStats);
 
@@ -0,0 +1,118 @@
+#include "LineIndex.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    bool containsLine(const LineIndex::Borders &borders, unsigned line) {
+        return line >= borders.beginLine && line <= borders.endLine;
+    }
+}
+
+uint32_t LineIndex::addFunction(std::string name, std::string scopeName, const Borders &borders,
+                                const Borders &bodyBorders) {
+    auto body = static_cast<uint32_t>(statements.size());
+    statements.push_back({ StatementKind::OTHER, bodyBorders, NO_PARENT });
+    auto position = std::upper_bound(functions.begin(), functions.end(), bodyBorders.beginLine,
+                                     [this](unsigned line, const Function &function) {
+                                         return line < statements[function.body].borders.beginLine;
+                                     });
+    functions.insert(position, { std::move(name), std::move(scopeName), borders, body });
+    return body;
+}
+
+uint32_t LineIndex::addChildren(uint32_t parent, const std::vector<StatementBorders> &children) {
+    auto first = static_cast<uint32_t>(statements.size());
+    for (const auto &[kind, borders] : children) {
+        statements.push_back({ kind, borders, parent });
+    }
+    statements[parent].firstChild = first;
+    statements[parent].childrenCount = static_cast<uint32_t>(children.size());
+    return first;
+}
+
+bool LineIndex::empty() const {
+    return functions.empty();
+}
+
+const LineIndex::Function *LineIndex::findFunction(unsigned line) const {
+    auto it = std::upper_bound(functions.begin(), functions.end(), line,
+                               [this](unsigned line, const Function &function) {
+                                   return line < statements[function.body].borders.beginLine;
+                               });
+    // the last matched body wins, as nested functions are matched after enclosing ones
+    while (it != functions.begin()) {
+        --it;
+        if (containsLine(statements[it->body].borders, line)) {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+LineInfo LineIndex::findLine(const fs::path &filePath, unsigned line) const {
+    LineInfo lineInfo{};
+    lineInfo.filePath = filePath;
+    const Function *function = findFunction(line);
+    if (function == nullptr) {
+        return lineInfo;
+    }
+    uint32_t current = function->body;
+    bool hasInnerChild = true;
+    while (hasInnerChild) {
+        hasInnerChild = false;
+        const Statement &statement = statements[current];
+        for (uint32_t child = statement.firstChild;
+             child < statement.firstChild + statement.childrenCount; ++child) {
+            const Borders &borders = statements[child].borders;
+            if (!containsLine(borders, line)) {
+                continue;
+            }
+            current = child;
+            hasInnerChild = true;
+            if (statements[child].kind == StatementKind::BRANCH) {
+                if (line == borders.beginLine) {
+                    hasInnerChild = false;
+                } else {
+                    lineInfo.wrapInBrackets = true;
+                    lineInfo.insertAfter = false;
+                }
+            }
+            if (line == borders.beginLine && statements[child].kind == StatementKind::RETURN) {
+                lineInfo.insertAfter = false;
+            }
+            break;
+        }
+    }
+    lineInfo.begin = statements[current].borders.beginLine;
+    lineInfo.end = statements[current].borders.endLine;
+    lineInfo.methodName = function->name;
+    lineInfo.scopeName = function->scopeName;
+    lineInfo.initialized = true;
+
+    std::ifstream stream(filePath.string());
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    std::string content = buffer.str();
+    auto getText = [&content](const Borders &borders) {
+        if (borders.beginOffset >= borders.endOffset || borders.endOffset > content.size()) {
+            return std::string();
+        }
+        return content.substr(borders.beginOffset, borders.endOffset - borders.beginOffset);
+    };
+    lineInfo.stmtString = getText(statements[current].borders);
+    // extend the statement to enclosing ones while they take no more than two lines
+    uint32_t parent = statements[current].parent;
+    const Borders *parentBorders = parent == NO_PARENT ? &function->borders : &statements[parent].borders;
+    while (parentBorders != nullptr && parentBorders->endLine - parentBorders->beginLine <= 1) {
+        lineInfo.stmtString = getText(*parentBorders);
+        if (parentBorders == &function->borders) {
+            parentBorders = nullptr;
+        } else {
+            parent = statements[parent].parent;
+            parentBorders = parent == NO_PARENT ? &function->borders : &statements[parent].borders;
+        }
+    }
+    return lineInfo;
+}
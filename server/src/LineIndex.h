@@ -0,0 +1,84 @@
+#ifndef UNITTESTBOT_LINEINDEX_H
+#define UNITTESTBOT_LINEINDEX_H
+
+#include "LineInfo.h"
+
+#include "utils/path/FileSystemPath.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Line borders of function definitions of a source file and of statements in their bodies.
+ * It is filled during the main fetch pass, so that the cursor position of a line request
+ * is resolved without parsing the file again.
+ */
+class LineIndex {
+public:
+    enum class StatementKind : uint8_t {
+        OTHER, BRANCH, RETURN
+    };
+
+    struct Borders {
+        unsigned beginLine = 0;
+        unsigned endLine = 0;
+        /// offsets of the source text in the file, they are equal if the text is unavailable
+        unsigned beginOffset = 0;
+        unsigned endOffset = 0;
+    };
+
+    using StatementBorders = std::pair<StatementKind, Borders>;
+
+    /**
+     * @param borders borders of the whole definition
+     * @param bodyBorders borders of the function body
+     * @return index of the body statement
+     */
+    uint32_t addFunction(std::string name, std::string scopeName, const Borders &borders,
+                         const Borders &bodyBorders);
+
+    /**
+     * Adds all children of the statement at once.
+     * @return index of the first child
+     */
+    uint32_t addChildren(uint32_t parent, const std::vector<StatementBorders> &children);
+
+    [[nodiscard]] bool empty() const;
+
+    /**
+     * Finds the innermost statement containing the line in the body of the function
+     * containing the line, the same way as BordersFinder::findFunction does.
+     * Function is looked up by binary search over functions sorted by their borders.
+     * @return uninitialized LineInfo if no function body contains the line
+     */
+    [[nodiscard]] LineInfo findLine(const fs::path &filePath, unsigned line) const;
+
+private:
+    static const uint32_t NO_PARENT = UINT32_MAX;
+
+    struct Function {
+        std::string name;
+        std::string scopeName;
+        Borders borders;
+        uint32_t body;
+    };
+
+    struct Statement {
+        StatementKind kind;
+        Borders borders;
+        uint32_t parent;
+        uint32_t firstChild = 0;
+        uint32_t childrenCount = 0;
+    };
+
+    /// sorted by the first line of body, functions matched later go later
+    std::vector<Function> functions;
+    std::vector<Statement> statements;
+
+    [[nodiscard]] const Function *findFunction(unsigned line) const;
+};
+
+
+#endif // UNITTESTBOT_LINEINDEX_H
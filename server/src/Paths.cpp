@@ -1,7 +1,9 @@
 #include "Paths.h"
 
 #include "ProjectContext.h"
+#include "commands/Commands.h"
 #include "utils/CLIUtils.h"
+#include "utils/HashUtils.h"
 #include "utils/StringUtils.h"
 
 #include "loguru.h"
@@ -171,6 +173,16 @@ namespace Paths {
         return errFiles;
     }
 
+    fs::path getKleeOutDir(const utbot::ProjectContext &projectContext) {
+        if (Commands::kleeOutputDir.empty()) {
+            return getUTBotFiles(projectContext) / "klee_out";
+        }
+        // outputs of projects with the same name are told apart by their build directories,
+        // the digest is stable, so the directory is the same for all builds of the server
+        std::string buildDirHash = HashUtils::sha1(getUTBotFiles(projectContext).string());
+        return fs::path(Commands::kleeOutputDir) / (projectContext.projectName + "_" + buildDirHash) / "klee_out";
+    }
+
     fs::path kleeOutDirForFilePath(const utbot::ProjectContext &projectContext, const fs::path &filePath) {
         fs::path kleeOutDir = getKleeOutDir(projectContext);
         fs::path relative = fs::relative(addOrigExtensionAsSuffixAndAddNew(filePath, ""), projectContext.projectPath);
@@ -187,6 +199,14 @@ namespace Paths {
         return kleeOutDirForFile / ("klee_out_" + suffix);
     }
 
+    fs::path kleeResultsDirForEntrypoint(const utbot::ProjectContext &projectContext,
+                                         const fs::path &resultsDir,
+                                         const fs::path &srcFilePath,
+                                         const std::string &entryPoint) {
+        fs::path relative = fs::relative(addOrigExtensionAsSuffixAndAddNew(srcFilePath, ""), projectContext.projectPath);
+        return resultsDir / relative / entryPoint;
+    }
+
     //endregion
 
     //region extensions
@@ -221,6 +241,14 @@ namespace Paths {
         return getArtifactsRootDir(projectContext) / "gtest-results.json";
     }
 
+    fs::path getGtestCacheDir(const std::string &key) {
+        return getGtestCacheRootDir() / key;
+    }
+
+    fs::path getGtestCacheRootDir() {
+        return logPath / "cache" / "gtest";
+    }
+
     fs::path getFlagsDir(const utbot::ProjectContext &projectContext) {
         return getArtifactsRootDir(projectContext) / "flags";
     }
@@ -420,6 +448,10 @@ namespace Paths {
         return makefileDir / makefileName;
     }
 
+    fs::path getRunManifestPath(const fs::path &makefilePath) {
+        return replaceExtension(makefilePath, RUN_MANIFEST_EXTENSION);
+    }
+
     std::optional<fs::path> headerPathToSourcePath(const fs::path &source) {
         if (Paths::isHeaderFile(source)) {
             for (const std::string &extension: CXXFileExtensions) {
@@ -16,6 +16,7 @@
 namespace Paths {
     extern fs::path logPath;
     const std::string MAKEFILE_EXTENSION = ".mk";
+    const std::string RUN_MANIFEST_EXTENSION = ".run.json";
     const std::string CXX_EXTENSION = ".cpp";
     const std::string TEST_SUFFIX = "_test";
     const std::string STUB_SUFFIX = "_stub";
@@ -207,6 +208,10 @@ namespace Paths {
         return fs::relative(getUTBotBuildDir(projectContext), projectContext.projectPath);
     }
 
+    static inline fs::path getSynchronizationIndexPath(const utbot::ProjectContext &projectContext) {
+        return getUTBotBuildDir(projectContext) / "synchronization.json";
+    }
+
     //region json
     static inline fs::path getClientsJsonPath() {
         return getBaseLogDir() / "clients.json";
@@ -226,12 +231,26 @@ namespace Paths {
         return (projectTmpPath / "out.bc").string();
     }
 
+    static inline fs::path getBitcodeCacheDir() {
+        return logPath / "bitcode_cache";
+    }
+
     static inline fs::path getKleeTmpLogFilePath() {
         return getBaseLogDir() / "klee_tmp_log.txt";
     }
 
-    static inline fs::path getKleeOutDir(const utbot::ProjectContext &projectContext) {
-        return getUTBotFiles(projectContext) / "klee_out";
+    /**
+     * @return directory for output of KLEE, which is in the build directory of the project
+     * unless another directory is set by server options
+     */
+    fs::path getKleeOutDir(const utbot::ProjectContext &projectContext);
+
+    static inline fs::path getKleeResultsDir(const utbot::ProjectContext &projectContext) {
+        return getUTBotFiles(projectContext) / "klee_results";
+    }
+
+    static inline fs::path getGenerationJournalDir(const utbot::ProjectContext &projectContext) {
+        return getUTBotBuildDir(projectContext) / "generation_journal";
     }
 
     static inline bool isKtest(fs::path const &path) {
@@ -257,6 +276,11 @@ namespace Paths {
                                       const fs::path &srcFilePath,
                                       const std::string &methodNameOrEmptyForFolder);
 
+    fs::path kleeResultsDirForEntrypoint(const utbot::ProjectContext &projectContext,
+                                         const fs::path &resultsDir,
+                                         const fs::path &srcFilePath,
+                                         const std::string &entryPoint);
+
     //endregion
 
     //region extensions
@@ -327,6 +351,15 @@ namespace Paths {
 
     fs::path getGTestResultsJsonPath(const utbot::ProjectContext &projectContext);
 
+    /**
+     * Directory of prebuilt gtest objects shared between all projects,
+     * key identifies compiler and flags they were built with.
+     */
+    fs::path getGtestCacheDir(const std::string &key);
+
+    /// directory which contains gtest objects of all configurations
+    fs::path getGtestCacheRootDir();
+
     fs::path getFlagsDir(const utbot::ProjectContext &projectContext);
 
     fs::path getTestExecDir(const utbot::ProjectContext &projectContext);
@@ -419,6 +452,12 @@ namespace Paths {
 
     fs::path getStubsMakefilePath(const utbot::ProjectContext &projectContext, const fs::path &sourceFilePath);
 
+    /**
+     * Returns path of the manifest that describes how to launch test binaries
+     * built by the given makefile without invoking make.
+     */
+    fs::path getRunManifestPath(const fs::path &makefilePath);
+
     std::optional<fs::path> headerPathToSourcePath(const fs::path &source);
     //endregion
 
@@ -441,6 +480,10 @@ namespace Paths {
         return projectContext.getReportDirAbsPath() / "generation-stats.csv";
     }
 
+    inline fs::path getGenerationFunctionStatsCSVPath(const utbot::ProjectContext &projectContext) {
+        return projectContext.getReportDirAbsPath() / "generation-function-stats.csv";
+    }
+
     inline fs::path getExecutionStatsCSVPath(const utbot::ProjectContext &projectContext) {
         return projectContext.getReportDirAbsPath() / "execution-stats.csv";
     }
@@ -1,8 +1,17 @@
 #include "RequestEnvironment.h"
 
+#include <mutex>
+#include <unordered_map>
+
 namespace RequestEnvironment {
     thread_local std::optional<std::string> clientId;
     thread_local grpc::ServerContext *serverContext;
+    thread_local uint32_t clientIndex = 0;
+
+    namespace {
+        std::mutex clientIndicesMutex;
+        std::unordered_map<std::string, uint32_t> clientIndices;
+    }
 
     const std::string &getClientId() {
         if (!clientId.has_value()) {
@@ -13,11 +22,27 @@ namespace RequestEnvironment {
         return clientId.value();
     }
 
+    uint32_t getClientIndex() {
+        return clientIndex;
+    }
+
+    uint32_t getClientIndex(const std::string &client) {
+        std::lock_guard<std::mutex> guard(clientIndicesMutex);
+        auto it = clientIndices.find(client);
+        if (it != clientIndices.end()) {
+            return it->second;
+        }
+        auto index = static_cast<uint32_t>(clientIndices.size() + 1);
+        clientIndices.emplace(client, index);
+        return index;
+    }
+
     const grpc::ServerContext *getServerContext() {
         return serverContext;
     }
 
     void setClientId(std::string requestClientId) {
+        clientIndex = getClientIndex(requestClientId);
         clientId = std::move(requestClientId);
     }
 
@@ -6,8 +6,15 @@
 namespace RequestEnvironment {
     extern thread_local std::optional<std::string> clientId;
     extern thread_local grpc::ServerContext *serverContext;
+    extern thread_local uint32_t clientIndex;
 
     const std::string &getClientId();
+    /**
+     * Returns integer id of the current client, which is the same for all threads of
+     * the client and is cheap to compare. Threads without client have index 0.
+     */
+    uint32_t getClientIndex();
+    uint32_t getClientIndex(const std::string &client);
     const grpc::ServerContext *getServerContext();
     void setClientId(std::string requestClientId);
     void setServerContext(grpc::ServerContext *requestServerContext);
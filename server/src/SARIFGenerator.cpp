@@ -1,11 +1,13 @@
 #include "SARIFGenerator.h"
 #include "Paths.h"
+#include "exceptions/FileSystemException.h"
 
 #include "loguru.h"
 
+#include <cctype>
+#include <cerrno>
 #include <fstream>
-#include <regex>
-#include <unordered_map>
+#include <system_error>
 
 using namespace tests;
 
@@ -44,160 +46,243 @@ namespace sarif {
         return relToProject;
     }
 
-    void sarifAddTestsToResults(const utbot::ProjectContext &projectContext,
-                                const Tests &tests,
-                                json &results) {
+    std::optional<StackFrame> parseStackFrame(std::string_view line) {
+        static constexpr std::string_view IN = " in ";
+        static constexpr std::string_view AT = ") at ";
+        size_t hashPos = 0;
+        while (hashPos < line.size() && isspace(static_cast<unsigned char>(line[hashPos]))) {
+            ++hashPos;
+        }
+        if (hashPos == 0 || hashPos == line.size() || line[hashPos] != '#') {
+            return std::nullopt;
+        }
+        size_t colonPos = line.rfind(':');
+        if (colonPos == std::string_view::npos || colonPos + 1 == line.size()) {
+            return std::nullopt;
+        }
+        int lineNumber = 0;
+        for (size_t i = colonPos + 1; i < line.size(); ++i) {
+            if (!isdigit(static_cast<unsigned char>(line[i]))) {
+                return std::nullopt;
+            }
+            lineNumber = lineNumber * 10 + (line[i] - '0');
+        }
+        size_t atPos = line.rfind(AT, colonPos);
+        if (atPos == std::string_view::npos || atPos <= hashPos || atPos + AT.size() > colonPos) {
+            return std::nullopt;
+        }
+        size_t inPos = line.rfind(IN, atPos);
+        if (inPos == std::string_view::npos || inPos <= hashPos) {
+            return std::nullopt;
+        }
+        size_t functionPos = inPos + IN.size();
+        size_t argumentsPos = line.find('(', functionPos);
+        if (argumentsPos == std::string_view::npos || argumentsPos > atPos) {
+            return std::nullopt;
+        }
+        std::string_view function = line.substr(functionPos, argumentsPos - functionPos);
+        std::string_view arguments = line.substr(argumentsPos + 1, atPos - argumentsPos - 1);
+        if (function.find(' ') != std::string_view::npos || arguments.find(')') != std::string_view::npos) {
+            return std::nullopt;
+        }
+        std::string_view file = line.substr(atPos + AT.size(), colonPos - atPos - AT.size());
+        if (file.find(':') != std::string_view::npos) {
+            return std::nullopt;
+        }
+        return StackFrame{ function, file, lineNumber };
+    }
+
+    static json makeLocation(const std::string &uri, const std::string &uriBaseId, int line,
+                             const std::string &text) {
+        return { { "physicalLocation",
+                   { { "artifactLocation", { { "uri", uri }, { "uriBaseId", uriBaseId } } },
+                     { "region", { { "startLine", line } } } } },
+                 { "message", { { "text", text } } } };
+    }
+
+    static void writeIndented(std::ostream &out, const std::string &text, const std::string &indent) {
+        size_t begin = 0;
+        for (size_t end = text.find('\n'); end != std::string::npos; end = text.find('\n', begin)) {
+            out.write(text.data() + begin, static_cast<std::streamsize>(end + 1 - begin));
+            out << indent;
+            begin = end + 1;
+        }
+        out.write(text.data() + begin, static_cast<std::streamsize>(text.size() - begin));
+    }
+
+    SarifResultsWriter::SarifResultsWriter(const utbot::ProjectContext &projectContext, fs::path path)
+        : projectContext(projectContext), utbotBuildDir(Paths::getUTBotBuildDir(projectContext)),
+          path(std::move(path)), out(this->path) {
+        checkStream();
+        // the layout is the same as produced by nlohmann::json::dump(2) for the whole report
+        out << "{\n"
+               "  \"$schema\": \"https://schemastore.azurewebsites.net/schemas/json/sarif-2.1.0-rtm.5.json\",\n"
+               "  \"runs\": [\n"
+               "    {\n"
+               "      \"results\": [";
+    }
+
+    const SarifResultsWriter::ResolvedFrameFile &SarifResultsWriter::resolveFrameFile(std::string_view srcPath) {
+        std::string key(srcPath);
+        auto it = resolvedFiles.find(key);
+        if (it != resolvedFiles.end()) {
+            return it->second;
+        }
+        fs::path relPathInProject = getInProjectPath(projectContext.projectPath, key);
+        fs::path fullPathInProject = projectContext.projectPath / relPathInProject;
+        FrameSource source = FrameSource::EXTERNAL;
+        if (Paths::isSubPathOf(utbotBuildDir, fullPathInProject)) {
+            LOG_S(WARNING) << "Full path " << fullPathInProject << " is in build - skip it";
+            source = FrameSource::BUILD;
+        } else if (!relPathInProject.empty() && fs::exists(fullPathInProject)) {
+            source = FrameSource::PROJECT;
+        }
+        return resolvedFiles.emplace(std::move(key), ResolvedFrameFile{ source, relPathInProject })
+            .first->second;
+    }
+
+    void SarifResultsWriter::addTestsToResults(const Tests &tests) {
         LOG_SCOPE_FUNCTION(DEBUG);
         for (const auto &it : tests.methods) {
             for (const auto &methodTestCase : it.second.testCases) {
                 json result;
-                const std::vector<std::string> &descriptors = methodTestCase.errorDescriptors;
                 std::string key;
-                std::string value;
                 json stackLocations;
                 json codeFlowsLocations;
                 json testLocation;
                 bool canAddThisTestToSARIF = false;
-                for (const std::string &descriptor : descriptors) {
-                    std::stringstream streamOfDescriptor(descriptor);
-                    std::string lineInDescriptor;
+                for (const std::string &descriptor : methodTestCase.errorDescriptors) {
                     bool firstCallInStack = false;
-                    while (getline(streamOfDescriptor, lineInDescriptor)) {
+                    std::string_view rest = descriptor;
+                    while (!rest.empty()) {
+                        size_t lineEnd = rest.find('\n');
+                        std::string_view lineInDescriptor = rest.substr(0, lineEnd);
+                        rest.remove_prefix(lineEnd == std::string_view::npos ? rest.size() : lineEnd + 1);
                         if (lineInDescriptor.empty() || lineInDescriptor[0] == '#')
                             continue;
-                        if (isspace(lineInDescriptor[0])) {
-                            if (key == "ExecutionStack") {
-                                const std::regex stack_regex(
-                                    R"regex(\s+#(.*) in ([^ ]*)[(][^)]*[)] at ([^:]*):(\d+))regex");
-                                std::smatch stack_match;
-                                if (!std::regex_match(lineInDescriptor, stack_match, stack_regex)) {
-                                    LOG_S(ERROR) << "wrong `Stack` line: " << lineInDescriptor;
-                                } else {
-                                    const fs::path &srcPath = fs::path(stack_match[3]);
-                                    const fs::path &relPathInProject = getInProjectPath(projectContext.projectPath, srcPath);
-                                    const fs::path &fullPathInProject = projectContext.projectPath / relPathInProject;
-                                    if (Paths::isSubPathOf(Paths::getUTBotBuildDir(projectContext), fullPathInProject)) {
-                                        LOG_S(WARNING) << "Full path " << fullPathInProject << " is in build - skip it";
-                                        continue;
-                                    }
-                                    if (!relPathInProject.empty() && fs::exists(fullPathInProject)) {
-                                        // stackLocations from project source
-                                        json locationWrapper;
-                                        locationWrapper["module"] = "project";
-                                        {
-                                            json location;
-                                            location["physicalLocation"]["artifactLocation"]["uri"] = relPathInProject;
-                                            location["physicalLocation"]["artifactLocation"]["uriBaseId"] = "%SRCROOT%";
-                                            location["physicalLocation"]["region"]["startLine"] = std::stoi(stack_match[4]); // line number
-                                            // commented, duplicated in message
-                                            // location["logicalLocations"][0]["fullyQualifiedName"] = stack_match[2]; // call name
-                                            location["message"]["text"] = stack_match[2].str() + std::string(" (source)"); // info for ANALYSIS STEP
-                                            if (firstCallInStack) {
-                                                firstCallInStack = false;
-                                                result["locations"].push_back(location);
-                                                stackLocations["message"]["text"] = "UTBot generated";
-                                                codeFlowsLocations["message"]["text"] = "UTBot generated";
-                                            }
-                                            locationWrapper["location"] = location;
-                                        }
-                                        stackLocations["frames"].push_back(locationWrapper);
-                                        codeFlowsLocations["locations"].push_back(locationWrapper);
-                                    } else if (firstCallInStack) {
-                                        // stackLocations from runtime, that is called by tested function
-                                        json locationWrapper;
-                                        locationWrapper["module"] = "external";
-                                        {
-                                            json location;
-                                            location["physicalLocation"]["artifactLocation"] ["uri"] = srcPath.filename(); // just a name
-                                            location["physicalLocation"]["artifactLocation"] ["uriBaseId"] = "%PATH%";
-                                            location["physicalLocation"]["region"]["startLine"] = std::stoi(stack_match[4]); // line number
-                                            // commented, duplicated in message
-                                            // location["logicalLocations"][0]["fullyQualifiedName"] = stack_match[2]; // call name
-                                            location["message"]["text"] = stack_match[2].str() + std::string(" (external)"); // info for ANALYSIS STEP
-                                            locationWrapper["location"] = location;
-                                        }
-                                        stackLocations["frames"].push_back(locationWrapper);
-                                        codeFlowsLocations["locations"].push_back(locationWrapper);
-                                    } else {
-                                        // the rest is the KLEE calls that are not applicable for navigation
-                                        LOG_S(DEBUG) << "Skip path in stack frame :" << srcPath;
-                                    }
+                        if (isspace(static_cast<unsigned char>(lineInDescriptor[0]))) {
+                            if (key != "ExecutionStack") {
+                                continue;
+                            }
+                            auto frame = parseStackFrame(lineInDescriptor);
+                            if (!frame.has_value()) {
+                                LOG_S(ERROR) << "wrong `Stack` line: " << lineInDescriptor;
+                                continue;
+                            }
+                            const ResolvedFrameFile &frameFile = resolveFrameFile(frame->file);
+                            std::string function(frame->function);
+                            if (frameFile.source == FrameSource::BUILD) {
+                                continue;
+                            }
+                            json locationWrapper;
+                            if (frameFile.source == FrameSource::PROJECT) {
+                                // stackLocations from project source
+                                locationWrapper["module"] = "project";
+                                json location = makeLocation(frameFile.relPathInProject.string(), "%SRCROOT%",
+                                                             frame->line, function + " (source)");
+                                if (firstCallInStack) {
+                                    firstCallInStack = false;
+                                    result["locations"].push_back(location);
+                                    stackLocations["message"]["text"] = "UTBot generated";
+                                    codeFlowsLocations["message"]["text"] = "UTBot generated";
                                 }
+                                locationWrapper["location"] = std::move(location);
+                            } else if (firstCallInStack) {
+                                // stackLocations from runtime, that is called by tested function
+                                locationWrapper["module"] = "external";
+                                locationWrapper["location"] =
+                                    makeLocation(fs::path(std::string(frame->file)).filename().string(), "%PATH%",
+                                                 frame->line, function + " (external)");
+                            } else {
+                                // the rest is the KLEE calls that are not applicable for navigation
+                                LOG_S(DEBUG) << "Skip path in stack frame :" << frame->file;
+                                continue;
                             }
+                            stackLocations["frames"].push_back(locationWrapper);
+                            codeFlowsLocations["locations"].push_back(std::move(locationWrapper));
                         } else {
                             size_t pos = lineInDescriptor.find(':');
-                            if (pos == std::string::npos) {
+                            if (pos == std::string_view::npos) {
                                 LOG_S(ERROR) << "no key:" << lineInDescriptor;
-                            } else {
-                                if (key == "ExecutionStack") {
-                                    // Check stack validity
-                                    if (firstCallInStack) {
-                                        LOG_S(ERROR) << "no visible ExecutionStack in descriptor:" << descriptor;
-                                    } else {
-                                        canAddThisTestToSARIF = true;
-                                    }
+                                continue;
+                            }
+                            if (key == "ExecutionStack") {
+                                // Check stack validity
+                                if (firstCallInStack) {
+                                    LOG_S(ERROR) << "no visible ExecutionStack in descriptor:" << descriptor;
+                                } else {
+                                    canAddThisTestToSARIF = true;
                                 }
-                                firstCallInStack = true;
-
-                                key = lineInDescriptor.substr(0, pos);
-                                value = lineInDescriptor.substr(pos + 1);
-                                if (key == "Error") {
-                                    result["message"]["text"] = value;
-                                    result["level"] = "error";
-                                    result["kind"] = "fail";
-                                } else if (key == ERROR_ID_KEY) {
-                                    result["ruleId"] = value;
-                                } else if (key == "ExecutionStack") {
-                                    stackLocations = json();
-                                    codeFlowsLocations = json();
-                                } else if (key == TEST_FILE_KEY) {
-                                    testLocation = json();
-                                    testLocation["physicalLocation"]["artifactLocation"]["uri"] = fs::relative(value, projectContext.projectPath);
-                                    testLocation["physicalLocation"]["artifactLocation"]["uriBaseId"] = "%SRCROOT%";
-                                } else if (key == TEST_LINE_KEY) {
-                                    testLocation["physicalLocation"]["region"]["startLine"] = std::stoi(value); // line number
-                                } else if (key == TEST_NAME_KEY) {
-                                    // commented, duplicated in message
-                                    //  testLocation["logicalLocations"][0]["fullyQualifiedName"] = value; // call name
-                                    testLocation["message"]["text"] = value + std::string(" (test)"); // info for ANALYSIS STEP
-                                    {
-                                        json locationWrapper;
-                                        locationWrapper["location"] = testLocation;
-                                        locationWrapper["module"] = "test";
+                            }
+                            firstCallInStack = true;
 
-                                        stackLocations["frames"].push_back(locationWrapper);
-                                        codeFlowsLocations["locations"].push_back(locationWrapper);
-                                    }
-                                }
+                            key = lineInDescriptor.substr(0, pos);
+                            std::string value(lineInDescriptor.substr(pos + 1));
+                            if (key == "Error") {
+                                result["message"]["text"] = value;
+                                result["level"] = "error";
+                                result["kind"] = "fail";
+                            } else if (key == ERROR_ID_KEY) {
+                                result["ruleId"] = value;
+                            } else if (key == "ExecutionStack") {
+                                stackLocations = json();
+                                codeFlowsLocations = json();
+                            } else if (key == TEST_FILE_KEY) {
+                                testLocation = json();
+                                testLocation["physicalLocation"]["artifactLocation"] = {
+                                    { "uri", fs::relative(value, projectContext.projectPath).string() },
+                                    { "uriBaseId", "%SRCROOT%" } };
+                            } else if (key == TEST_LINE_KEY) {
+                                testLocation["physicalLocation"]["region"]["startLine"] = std::stoi(value); // line number
+                            } else if (key == TEST_NAME_KEY) {
+                                testLocation["message"]["text"] = value + std::string(" (test)"); // info for ANALYSIS STEP
+                                json locationWrapper = { { "location", testLocation }, { "module", "test" } };
+                                stackLocations["frames"].push_back(locationWrapper);
+                                codeFlowsLocations["locations"].push_back(std::move(locationWrapper));
                             }
                         }
                     }
                 }
 
                 if (canAddThisTestToSARIF) {
-                    result["stacks"].push_back(stackLocations);
-                    result["codeFlows"][0]["threadFlows"].push_back(codeFlowsLocations);
-                    results.push_back(result);
+                    result["stacks"].push_back(std::move(stackLocations));
+                    result["codeFlows"][0]["threadFlows"].push_back(std::move(codeFlowsLocations));
+                    writeResult(result);
                 }
             }
         }
+        out.flush();
     }
 
-    std::string sarifPackResults(const json &results) {
-        json sarifJson;
-        sarifJson["$schema"] = "https://schemastore.azurewebsites.net/schemas/json/sarif-2.1.0-rtm.5.json";
-        sarifJson["version"] = "2.1.0";
-        {
-            json runs;
-            {
-                json runAkaTestCase;
-                runAkaTestCase["tool"]["driver"]["name"] = "UTBotCpp";
-                runAkaTestCase["tool"]["driver"]["informationUri"] = "https://utbot.org";
-                runAkaTestCase["results"] = results;
-                runs.push_back(runAkaTestCase);
-            }
-            sarifJson["runs"] = runs;
+    void SarifResultsWriter::writeResult(const json &result) {
+        static const std::string RESULT_INDENT(8, ' ');
+        out << (resultsCount == 0 ? "\n" : ",\n") << RESULT_INDENT;
+        writeIndented(out, result.dump(2), RESULT_INDENT);
+        ++resultsCount;
+    }
+
+    void SarifResultsWriter::checkStream() const {
+        if (!out) {
+            std::error_code ec(errno, std::system_category());
+            auto error = fs::filesystem_error("writing SARIF report failed, file: " + path.string(), ec);
+            LOG_S(ERROR) << error.what();
+            throw FileSystemException(error);
         }
-        return sarifJson.dump(2);
+    }
+
+    void SarifResultsWriter::finish() {
+        json tool;
+        tool["driver"]["name"] = "UTBotCpp";
+        tool["driver"]["informationUri"] = "https://utbot.org";
+        out << (resultsCount == 0 ? "]" : "\n      ]") << ",\n"
+            << "      \"tool\": ";
+        writeIndented(out, tool.dump(2), std::string(6, ' '));
+        out << "\n"
+               "    }\n"
+               "  ],\n"
+               "  \"version\": \"2.1.0\"\n"
+               "}";
+        out.close();
+        checkStream();
     }
 }
@@ -1,6 +1,11 @@
 #include "Tests.h"
 #include "ProjectContext.h"
 
+#include <fstream>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
 namespace sarif {
     const std::string PREFIX_FOR_JSON_PATH = "// UTBOT_TEST_GENERATOR (function name,test index): ";
 
@@ -11,8 +16,59 @@ namespace sarif {
 
     const std::string SARIF_FILE_NAME = "project_code_analysis.sarif";
 
-    void sarifAddTestsToResults(const utbot::ProjectContext &projectContext,
-                                const tests::Tests &tests,
-                                nlohmann::json &results);
-    std::string sarifPackResults(const nlohmann::json &results);
+    /**
+     * Frame of KLEE `ExecutionStack` of the form
+     * "    #<index> in <function>(<arguments>) at <file>:<line>".
+     */
+    struct StackFrame {
+        std::string_view function;
+        std::string_view file;
+        int line;
+    };
+
+    /**
+     * Parses a stack line in one pass, returns std::nullopt if the line has another format.
+     */
+    std::optional<StackFrame> parseStackFrame(std::string_view line);
+
+    /**
+     * Writes SARIF report to the file as soon as results of the next tests are known,
+     * so that the whole report is never kept in memory as a json document.
+     */
+    class SarifResultsWriter {
+    public:
+        SarifResultsWriter(const utbot::ProjectContext &projectContext, fs::path path);
+
+        void addTestsToResults(const tests::Tests &tests);
+
+        /**
+         * Completes the report in the file.
+         * @throws FileSystemException if the report can't be written
+         */
+        void finish();
+
+    private:
+        enum class FrameSource {
+            PROJECT, BUILD, EXTERNAL
+        };
+
+        struct ResolvedFrameFile {
+            FrameSource source;
+            fs::path relPathInProject;
+        };
+
+        const utbot::ProjectContext &projectContext;
+        const fs::path utbotBuildDir;
+        const fs::path path;
+        std::ofstream out;
+        size_t resultsCount = 0;
+        /// stack frames mostly point to the same few files, so their lookups are cached
+        std::unordered_map<std::string, ResolvedFrameFile> resolvedFiles;
+
+        const ResolvedFrameFile &resolveFrameFile(std::string_view srcPath);
+
+        void writeResult(const nlohmann::json &result);
+
+        void checkStream() const;
+    };
 }
@@ -4,18 +4,20 @@
 #include "FeaturesFilter.h"
 #include "GTestLogger.h"
 #include "KleeRunner.h"
-#include "ReturnTypesFetcher.h"
+#include "SessionCache.h"
 #include "Synchronizer.h"
 #include "Version.h"
 #include "building/Linker.h"
 #include "building/UserProjectConfiguration.h"
-#include "clang-utils/SourceToHeaderRewriter.h"
+#include "clang-utils/TestHeadersGenerator.h"
+#include "commands/Commands.h"
 #include "coverage/CoverageAndResultsGenerator.h"
 #include "exceptions/EnvironmentException.h"
 #include "exceptions/FileNotPresentedInArtifactException.h"
 #include "exceptions/FileNotPresentedInCommandsException.h"
 #include "exceptions/FileSystemException.h"
 #include "printers/CCJsonPrinter.h"
+#include "printers/NativeMakefilePrinter.h"
 #include "printers/StubsPrinter.h"
 #include "streams/FileTargetsWriter.h"
 #include "streams/ProjectConfigWriter.h"
@@ -31,10 +33,12 @@
 #include "utils/ServerUtils.h"
 #include "utils/stats/TestsGenerationStats.h"
 #include "utils/stats/TestsExecutionStats.h"
+#include "utils/stats/StageStats.h"
 #include "utils/TypeUtils.h"
 #include "utils/JsonUtils.h"
 #include "building/ProjectBuildDatabase.h"
 
+#include <algorithm>
 #include <thread>
 #include <fstream>
 
@@ -48,6 +52,8 @@ void Server::run(uint16_t customPort) {
     LOG_S(INFO) << "Logs directory: " << Paths::logPath;
     LOG_S(INFO) << "Latest log path: " << Paths::getUtbotLogAllFilePath();
     LOG_S(INFO) << "Executable path: " << fs::current_path();
+    // no makefile uses the cache before requests are accepted
+    printer::NativeMakefilePrinter::trimGtestCache(Paths::getGtestCacheRootDir());
 
     host = "0.0.0.0";
     if (customPort != 0) {
@@ -98,10 +104,17 @@ Server::~Server() {
     }
 }
 
-Server::TestsGenServiceImpl::TestsGenServiceImpl() {
+Server::TestsGenServiceImpl::TestsGenServiceImpl() : activeRequests(getMaxActiveRequests()) {
     ServerUtils::loadClientsData(clients);
 }
 
+unsigned int Server::TestsGenServiceImpl::getMaxActiveRequests() {
+    if (Commands::maxActiveRequests != 0) {
+        return Commands::maxActiveRequests;
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
 Server::TestsGenServiceImpl::TestsGenServiceImpl(bool testMode) : TestsGenServiceImpl() {
     this->testMode = testMode;
 }
@@ -197,22 +210,31 @@ Status Server::TestsGenServiceImpl::ProcessBaseTestRequest(BaseTestGen &testGen,
         auto preprocessingStartTime = std::chrono::steady_clock::now();
         types::TypesHandler::SizeContext sizeContext;
 
+        auto lineTestGen = dynamic_cast<LineTestGen *>(&testGen);
+
         static std::string logMessage = "Traversing sources AST tree and fetching declarations.";
         LOG_S(DEBUG) << logMessage;
-        Fetcher fetcher(Fetcher::Options::Value::ALL,
-                        testGen.getTargetBuildDatabase()->compilationDatabase, testGen.tests, &testGen.types,
-                        &sizeContext.maximumAlignment,
-                        testGen.compileCommandsJsonPath, false);
-        fetcher.fetchWithProgress(testGen.progressWriter, logMessage);
+        Fetcher::Options::Value fetcherOptions = Fetcher::Options::Value::ALL;
+        if (lineTestGen != nullptr) {
+            // borders of statements are needed to find the requested line without parsing it again
+            fetcherOptions = fetcherOptions | Fetcher::Options::Value::LINE_INDEX;
+        }
+        std::shared_ptr<Fetcher::FileToStringSet> structsToDeclare;
+        {
+            MEASURE_STAGE_EXECUTION_TIME("fetch")
+            // declarations of sources unchanged since previous requests are taken from cache
+            structsToDeclare = SessionCache::getInstance().fetch(testGen, fetcherOptions,
+                                                                 &sizeContext.maximumAlignment, logMessage);
+        }
         types::TypesHandler typesHandler{testGen.types, sizeContext};
         testGen.progressWriter->writeProgress("Generating stub files", 0.0);
         StubGen stubGen(testGen);
         {
+            MEASURE_STAGE_EXECUTION_TIME("synchronize")
             Synchronizer synchronizer(&testGen, &sizeContext);
             synchronizer.synchronize(typesHandler);
         }
         std::shared_ptr<LineInfo> lineInfo = nullptr;
-        auto lineTestGen = dynamic_cast<LineTestGen *>(&testGen);
 
         if (lineTestGen != nullptr) {
             if (isSameType<ClassTestGen>(testGen) && Paths::isHeaderFile(lineTestGen->filePath)) {
@@ -296,35 +318,44 @@ Status Server::TestsGenServiceImpl::ProcessBaseTestRequest(BaseTestGen &testGen,
             }
         }
         auto generator = std::make_shared<KleeGenerator>(&testGen, typesHandler, pathSubstitution);
+        LOG_S(DEBUG) << "Temporary build directory path: " << testGen.serverBuildDir;
         {
-            ReturnTypesFetcher returnTypesFetcher(&testGen);
-            returnTypesFetcher.fetch(testGen.progressWriter);
+            MEASURE_STAGE_EXECUTION_TIME("klee files build")
+            generator->buildKleeFiles(testGen.tests, lineInfo);
+            generator->handleFailedFunctions(testGen.tests);
         }
-        LOG_S(DEBUG) << "Temporary build directory path: " << testGen.serverBuildDir;
-        generator->buildKleeFiles(testGen.tests, lineInfo);
-        generator->handleFailedFunctions(testGen.tests);
         testGen.progressWriter->writeProgress("Building files", 0.0);
         Linker linker{testGen, stubGen, lineInfo, generator};
-        linker.prepareArtifacts();
+        {
+            MEASURE_STAGE_EXECUTION_TIME("link")
+            linker.prepareArtifacts();
+        }
         auto testMethods = linker.getTestMethods();
         auto selectedTargets = linker.getSelectedTargets();
-        SourceToHeaderRewriter(testGen.projectContext, testGen.getTargetBuildDatabase()->compilationDatabase,
-                               fetcher.getStructsToDeclare(), testGen.serverBuildDir, typesHandler)
-                .generateTestHeaders(testGen.tests, stubGen, selectedTargets, testGen.progressWriter);
+        TestHeadersGenerator testHeaders(testGen.projectContext,
+                                         testGen.getTargetBuildDatabase()->compilationDatabase, structsToDeclare,
+                                         testGen.serverBuildDir, typesHandler, testGen.tests, stubGen,
+                                         selectedTargets);
         KleeRunner kleeRunner{testGen.projectContext, testGen.settingsContext};
-        bool interactiveMode = (dynamic_cast<ProjectTestGen *>(&testGen) != nullptr);
+        auto projectTestGen = dynamic_cast<ProjectTestGen *>(&testGen);
+        bool interactiveMode = (projectTestGen != nullptr);
+        bool resume = projectTestGen != nullptr && projectTestGen->getRequest()->resume();
+        bool journal = resume || (projectTestGen != nullptr && projectTestGen->getRequest()->journal());
         auto generationStartTime = std::chrono::steady_clock::now();
         StatsUtils::TestsGenerationStatsFileMap generationStatsMap(testGen.projectContext,
                                                                    std::chrono::duration_cast<std::chrono::milliseconds>(
                                                                            generationStartTime -
                                                                            preprocessingStartTime));
-        kleeRunner.runKlee(testMethods, testGen.tests, generator, testGen.methodNameToReturnTypeMap,
-                           lineInfo, testsWriter, testGen.isBatched(), interactiveMode, generationStatsMap);
+        kleeRunner.runKlee(testMethods, testGen.tests, generator,
+                           lineInfo, testsWriter, testHeaders, testGen.isBatched(), journal, resume,
+                           interactiveMode, generationStatsMap);
         LOG_S(INFO) << "KLEE time: " << std::chrono::duration_cast<std::chrono::milliseconds>
                 (generationStatsMap.getTotal().kleeStats.getKleeTime()).count() << " ms\n";
         printer::CSVPrinter printer = generationStatsMap.toCSV();
         FileSystemUtils::writeToFile(Paths::getGenerationStatsCSVPath(testGen.projectContext),
                                      printer.getStream().str());
+        FileSystemUtils::writeToFile(Paths::getGenerationFunctionStatsCSVPath(testGen.projectContext),
+                                     generationStatsMap.functionsToCSV().getStream().str());
         LOG_S(INFO) << StringUtils::stringFormat("See generation stats here: %s",
                                                  Paths::getGenerationStatsCSVPath(testGen.projectContext));
     } catch (const ExecutionProcessException &e) {
@@ -354,23 +385,42 @@ Status Server::TestsGenServiceImpl::ProcessBaseTestRequest(BaseTestGen &testGen,
     return Status::OK;
 }
 
+namespace {
+    /**
+     * Uses borders of statements recorded by the main fetch, if the file was fetched,
+     * otherwise parses the file.
+     */
+    LineInfo findLine(LineTestGen &lineTestGen) {
+        auto tests = lineTestGen.tests.find(lineTestGen.filePath);
+        if (tests != lineTestGen.tests.end() && !tests->second.lineIndex.empty()) {
+            LineInfo lineInfo = tests->second.lineIndex.findLine(lineTestGen.filePath, lineTestGen.line);
+            auto method = tests->second.methods.find(lineInfo.methodName);
+            if (method != tests->second.methods.end()) {
+                lineInfo.functionReturnType = method->second.returnType;
+            }
+            return lineInfo;
+        }
+        BordersFinder stmtFinder(lineTestGen.filePath, lineTestGen.line,
+                                 lineTestGen.getTargetBuildDatabase()->compilationDatabase,
+                                 lineTestGen.compileCommandsJsonPath);
+        stmtFinder.findFunction();
+        return stmtFinder.getLineInfo();
+    }
+}
+
 std::shared_ptr<LineInfo> Server::TestsGenServiceImpl::getLineInfo(LineTestGen &lineTestGen) {
-    BordersFinder stmtFinder(lineTestGen.filePath, lineTestGen.line,
-                             lineTestGen.getTargetBuildDatabase()->compilationDatabase,
-                             lineTestGen.compileCommandsJsonPath);
-    stmtFinder.findFunction();
-    if (!stmtFinder.getLineInfo().initialized) {
+    auto lineInfo = std::make_shared<LineInfo>(findLine(lineTestGen));
+    if (!lineInfo->initialized) {
         LOG_S(ERROR) << "Cant generate for this line\n"
-                     << stmtFinder.getLineInfo().stmtString;
+                     << lineInfo->stmtString;
         throw NoTestGeneratedException("Maybe you tried to generate tests placing cursor on invalid line.");
     }
     if (isSameType<AssertionTestGen>(lineTestGen) &&
-        !StringUtils::contains(stmtFinder.getLineInfo().stmtString, "assert")) {
+        !StringUtils::contains(lineInfo->stmtString, "assert")) {
         LOG_S(ERROR) << "No assert found on this line\n"
-                     << stmtFinder.getLineInfo().stmtString;
+                     << lineInfo->stmtString;
         throw NoTestGeneratedException("No assert found on this line.");
     }
-    auto lineInfo = std::make_shared<LineInfo>(stmtFinder.getLineInfo());
     if (auto predicateInfo = dynamic_cast<PredicateTestGen *>(&lineTestGen)) {
         lineInfo->predicateInfo = LineInfo::PredicateInfo(
                 {predicateInfo->type, predicateInfo->predicate, predicateInfo->returnValue});
@@ -389,39 +439,26 @@ std::string extractMessage(const loguru::Message &message) {
 }
 
 void Server::logToClient(void *channel, const loguru::Message &message) {
-    auto data = reinterpret_cast<WriterData *>(channel);
-    if (data == nullptr) {
+    auto reactor = reinterpret_cast<LogChannelReactor *>(channel);
+    if (reactor == nullptr) {
         LOG_S(ERROR) << "Couldn't handle logging to client, data is null";
         throw BaseException("Couldn't handle logging to client, data is null");
     }
-    std::vector<char> thread_name(LOGURU_BUFFER_SIZE);
-    loguru::get_thread_name(thread_name.data(), LOGURU_BUFFER_SIZE, false);
-
-    if (std::string(thread_name.data()) == data->client &&
-        std::string(message.filename) != std::string(GTestLogger::fileName())) {
-        LogEntry logEntry;
-        std::string extractedMessage = extractMessage(message);
-        logEntry.set_message(extractedMessage);
-        std::lock_guard<std::mutex> guard(data->writerMutex);
-        data->writer->Write(logEntry);
+    if (RequestEnvironment::getClientIndex() == reactor->clientIndex &&
+        strcmp(message.filename, GTestLogger::fileName()) != 0) {
+        reactor->push(extractMessage(message));
     }
 }
 
 void Server::gtestLog(void *channel, const loguru::Message &message) {
-    auto data = reinterpret_cast<WriterData *>(channel);
-    if (data == nullptr) {
+    auto reactor = reinterpret_cast<LogChannelReactor *>(channel);
+    if (reactor == nullptr) {
         LOG_S(ERROR) << "Can't interpret gtest log channel";
         throw BaseException("Can't interpret gtest log channel");
     }
-    std::vector<char> thread_name(LOGURU_BUFFER_SIZE);
-    loguru::get_thread_name(thread_name.data(), LOGURU_BUFFER_SIZE, false);
-
-    if (std::string(thread_name.data()) == data->client &&
-        std::string(message.filename) == std::string(GTestLogger::fileName())) {
-        LogEntry logEntry;
-        logEntry.set_message(message.message);
-        std::lock_guard<std::mutex> guard(data->writerMutex);
-        data->writer->Write(logEntry);
+    if (RequestEnvironment::getClientIndex() == reactor->clientIndex &&
+        strcmp(message.filename, GTestLogger::fileName()) == 0) {
+        reactor->push(message.message);
     }
 }
 
@@ -434,88 +471,141 @@ loguru::Verbosity MaxNameToVerbosityCallback(const char *name) {
     return loguru::Verbosity_INVALID;
 }
 
-Status Server::TestsGenServiceImpl::provideLoggingCallbacks(
+namespace {
+    class FinishedLogChannelReactor : public ServerWriteReactor<LogEntry> {
+    public:
+        explicit FinishedLogChannelReactor(const Status &status) {
+            Finish(status);
+        }
+
+        void OnDone() override {
+            delete this;
+        }
+    };
+}
+
+ServerWriteReactor<LogEntry> *Server::TestsGenServiceImpl::openLogChannel(
+        CallbackServerContext *context,
         const std::string &callbackPrefix,
-        ServerWriter<LogEntry> *writer,
         const std::string &logLevel,
         loguru::log_handler_t handler,
-        std::map<std::string, std::atomic_bool> &channelStorage,
+        std::map<std::string, bool> &channelStorage,
         bool openFiles) {
-    const auto &client = RequestEnvironment::getClientId();
-    auto oldValue = channelStorage[client].load(std::memory_order_relaxed);
-    if (!oldValue && channelStorage[client].compare_exchange_weak(
-            oldValue, true, std::memory_order_release, std::memory_order_relaxed)) {
-        WriterData data{writer, std::mutex(), client};
-        fs::path logFilePath = Paths::getLogDir();
-        if (!fs::exists(logFilePath)) {
-            fs::create_directories(logFilePath);
-        }
-        fs::path allLogPath = logFilePath / "everything.log";
-        fs::path latestLogPath = logFilePath / "latest_readable.log";
-        auto callbackName = callbackPrefix + client;
-        loguru::set_name_to_verbosity_callback(&::MaxNameToVerbosityCallback);
-        loguru::add_callback(callbackName.c_str(), handler, &data,
-                             loguru::get_verbosity_from_name(logLevel.c_str()));
-        if (openFiles) {
-            loguru::add_file(allLogPath.c_str(), loguru::Append,
-                             loguru::Verbosity_MAX);
-            loguru::add_file(latestLogPath.c_str(), loguru::Truncate,
-                             loguru::Verbosity_INFO);
+    auto clientId = ServerUtils::getClientId(context, testMode);
+    if (!clientId.has_value()) {
+        LOG_S(ERROR) << "Tried to open log channel for unnamed client";
+        return new FinishedLogChannelReactor(Status::CANCELLED);
+    }
+    const std::string client = clientId.value();
+    {
+        std::lock_guard<std::mutex> guard(channelStorageMutex);
+        if (channelStorage[client]) {
+            return new FinishedLogChannelReactor(Status::OK);
         }
-        holdLockFlag[callbackName] = true;
-        /*
-         * We use spinlocks here, because ServerWriter<LogEntry> *writer
-         * is invalidated when Status::OK is sent, and therefore we can
-         * not send logs to clients when they issue requests to UTBot. Possible
-         * ways of redesigning logging system and removing the spinlock are:
-         * 1. Using gRPC async API
-         * 2. Issuing a request from UTBot to a specific client on every log entry.
-         */
-        using namespace std::chrono_literals;
-        while (holdLockFlag[callbackName].exchange(true, std::memory_order_acquire)) {
-            std::this_thread::sleep_for(1ms);
+        channelStorage[client] = true;
+    }
+    fs::path logFilePath = Paths::getLogDir();
+    if (!fs::exists(logFilePath)) {
+        fs::create_directories(logFilePath);
+    }
+    fs::path allLogPath = logFilePath / "everything.log";
+    fs::path latestLogPath = logFilePath / "latest_readable.log";
+    auto callbackName = callbackPrefix + client;
+    auto reactor = std::make_shared<LogChannelReactor>(
+        RequestEnvironment::getClientIndex(client),
+        [callbackName, allLogPath, latestLogPath, openFiles]() {
+            // loguru calls callbacks under its lock, so none of them uses the reactor afterwards
+            loguru::remove_callback(callbackName.c_str());
+            if (openFiles) {
+                loguru::remove_callback(allLogPath.c_str());
+                loguru::remove_callback(latestLogPath.c_str());
+            }
+        },
+        [this, callbackName, client, &channelStorage](LogChannelReactor *reactor) {
+            // the reactor is deleted when the last owner releases it, after the lock
+            std::shared_ptr<LogChannelReactor> owner;
+            std::lock_guard<std::mutex> guard(logChannelsMutex);
+            auto [begin, end] = logChannels.equal_range(callbackName);
+            for (auto it = begin; it != end; ++it) {
+                if (it->second.get() == reactor) {
+                    owner = std::move(it->second);
+                    logChannels.erase(it);
+                    break;
+                }
+            }
+            // the channel may be opened again while this one was being completed
+            if (logChannels.count(callbackName) == 0) {
+                std::lock_guard<std::mutex> storageGuard(channelStorageMutex);
+                channelStorage[client] = false;
+            }
+        });
+    std::vector<std::shared_ptr<LogChannelReactor>> stale;
+    {
+        std::lock_guard<std::mutex> guard(logChannelsMutex);
+        auto [begin, end] = logChannels.equal_range(callbackName);
+        for (auto it = begin; it != end; ++it) {
+            stale.push_back(it->second);
         }
-        loguru::remove_callback(callbackName.c_str());
-        if (openFiles) {
-            loguru::remove_callback(allLogPath.c_str());
-            loguru::remove_callback(latestLogPath.c_str());
+        logChannels.emplace(callbackName, reactor);
+    }
+    // channel of an outdated client may be still not completed, it must not log to the client
+    // together with the new one
+    for (const auto &staleReactor : stale) {
+        staleReactor->close();
+    }
+    loguru::set_name_to_verbosity_callback(&::MaxNameToVerbosityCallback);
+    loguru::add_callback(callbackName.c_str(), handler, reactor.get(),
+                         loguru::get_verbosity_from_name(logLevel.c_str()));
+    if (openFiles) {
+        loguru::add_file(allLogPath.c_str(), loguru::Append,
+                         loguru::Verbosity_MAX);
+        loguru::add_file(latestLogPath.c_str(), loguru::Truncate,
+                         loguru::Verbosity_INFO);
+    }
+    return reactor.get();
+}
+
+void Server::TestsGenServiceImpl::closeLogChannel(const std::string &callbackName) {
+    std::vector<std::shared_ptr<LogChannelReactor>> reactors;
+    {
+        std::lock_guard<std::mutex> guard(logChannelsMutex);
+        auto [begin, end] = logChannels.equal_range(callbackName);
+        for (auto it = begin; it != end; ++it) {
+            reactors.push_back(it->second);
         }
-        channelStorage[client] = false;
     }
-    return Status::OK;
+    // the lock is released first, because the RPC may be completed inline and OnDone takes it
+    for (const auto &reactor : reactors) {
+        reactor->close();
+    }
 }
 
-Status Server::TestsGenServiceImpl::OpenLogChannel(ServerContext *context,
-                                                   const LogChannelRequest *request,
-                                                   ServerWriter<LogEntry> *writer) {
-    ServerUtils::setThreadOptions(context, testMode);
-    return provideLoggingCallbacks(logPrefix, writer, request->loglevel(), logToClient, openedChannel,
-                                   true);
+ServerWriteReactor<LogEntry> *
+Server::TestsGenServiceImpl::OpenLogChannel(CallbackServerContext *context,
+                                            const LogChannelRequest *request) {
+    return openLogChannel(context, logPrefix, request->loglevel(), logToClient, openedChannel, true);
 }
 
 Status Server::TestsGenServiceImpl::CloseLogChannel(ServerContext *context,
                                                     const DummyRequest *request,
                                                     DummyResponse *response) {
     ServerUtils::setThreadOptions(context, testMode);
-    const std::string callbackName = logPrefix + RequestEnvironment::getClientId();
-    holdLockFlag[callbackName].store(false, std::memory_order_release);
+    closeLogChannel(logPrefix + RequestEnvironment::getClientId());
     return Status::OK;
 }
 
-Status Server::TestsGenServiceImpl::OpenGTestChannel(ServerContext *context,
-                                                     const LogChannelRequest *request,
-                                                     ServerWriter<LogEntry> *writer) {
-    ServerUtils::setThreadOptions(context, testMode);
-    return provideLoggingCallbacks(gtestLogPrefix, writer, request->loglevel(), gtestLog,
-                                   openedGTestChannel, false);
+ServerWriteReactor<LogEntry> *
+Server::TestsGenServiceImpl::OpenGTestChannel(CallbackServerContext *context,
+                                              const LogChannelRequest *request) {
+    return openLogChannel(context, gtestLogPrefix, request->loglevel(), gtestLog, openedGTestChannel,
+                          false);
 }
 
 Status Server::TestsGenServiceImpl::CloseGTestChannel(ServerContext *context,
                                                       const DummyRequest *request,
                                                       DummyResponse *response) {
     ServerUtils::setThreadOptions(context, testMode);
-    const std::string callbackName = gtestLogPrefix + RequestEnvironment::getClientId();
-    holdLockFlag[callbackName].store(false, std::memory_order_release);
+    closeLogChannel(gtestLogPrefix + RequestEnvironment::getClientId());
     return Status::OK;
 }
 
@@ -751,14 +841,25 @@ RequestLockMutex &Server::TestsGenServiceImpl::getLock() {
     return iterator->second;
 }
 
-std::unique_lock<RequestLockMutex>
+Server::TestsGenServiceImpl::RequestLock
 Server::TestsGenServiceImpl::acquireLock(ProgressWriter *writer) {
+    RequestLock requestLock;
     auto &lock = getLock();
     if (lock.try_lock()) {
-        return std::unique_lock{lock, std::adopt_lock};
+        requestLock.clientLock = std::unique_lock{lock, std::adopt_lock};
+    } else {
+        if (writer != nullptr) {
+            writer->writeProgress("Waiting for previous task to be finished");
+        }
+        requestLock.clientLock = std::unique_lock{lock};
     }
-    if (writer != nullptr) {
-        writer->writeProgress("Waiting for previous task to be finished");
+    if (activeRequests.try_lock()) {
+        requestLock.activeRequestSlot = std::unique_lock{activeRequests, std::adopt_lock};
+    } else {
+        if (writer != nullptr) {
+            writer->writeProgress("Waiting for tasks of other users to be finished");
+        }
+        requestLock.activeRequestSlot = std::unique_lock{activeRequests};
     }
-    return std::unique_lock{lock};
+    return requestLock;
 }
@@ -9,6 +9,7 @@
 #include "exceptions/ExecutionProcessException.h"
 #include "exceptions/NoTestGeneratedException.h"
 #include "printers/TestsPrinter.h"
+#include "streams/LogChannelReactor.h"
 #include "streams/stubs/StubsWriter.h"
 #include "streams/tests/ServerTestsWriter.h"
 #include "streams/tests/TestsWriter.h"
@@ -22,6 +23,7 @@
 #include "testgens/PredicateTestGen.h"
 #include "testgens/ProjectTestGen.h"
 #include "testgens/SnippetTestGen.h"
+#include "utils/FairSemaphore.h"
 #include "utils/LogUtils.h"
 #include "utils/RequestLockMutex.h"
 #include "utils/ServerUtils.h"
@@ -41,8 +43,10 @@
 
 using json = nlohmann::json;
 
+using grpc::CallbackServerContext;
 using grpc::ServerBuilder;
 using grpc::ServerContext;
+using grpc::ServerWriteReactor;
 using grpc::ServerWriter;
 using grpc::Status;
 using grpc::StatusCode;
@@ -58,7 +62,14 @@ public:
 
     void run(uint16_t customPort = 0);
 
-    class TestsGenServiceImpl final : public TestsGenService::Service {
+    /**
+     * Log channels stay open for the whole session of a client, so they are served
+     * by callback API and don't occupy threads of the synchronous server.
+     */
+    using TestsGenServiceBase = TestsGenService::WithCallbackMethod_OpenLogChannel<
+        TestsGenService::WithCallbackMethod_OpenGTestChannel<TestsGenService::Service>>;
+
+    class TestsGenServiceImpl final : public TestsGenServiceBase {
     public:
         TestsGenServiceImpl();
 
@@ -68,17 +79,15 @@ public:
                          const VersionInfo *request,
                          VersionInfo *response) override;
 
-        Status OpenLogChannel(ServerContext *context,
-                              const LogChannelRequest *request,
-                              ServerWriter<LogEntry> *writer) override;
+        ServerWriteReactor<LogEntry> *OpenLogChannel(CallbackServerContext *context,
+                                                     const LogChannelRequest *request) override;
 
         Status CloseLogChannel(ServerContext *context,
                                const DummyRequest *request,
                                DummyResponse *response) override;
 
-        Status OpenGTestChannel(ServerContext *context,
-                                const LogChannelRequest *request,
-                                ServerWriter<LogEntry> *writer) override;
+        ServerWriteReactor<LogEntry> *OpenGTestChannel(CallbackServerContext *context,
+                                                       const LogChannelRequest *request) override;
 
         Status CloseGTestChannel(ServerContext *context,
                                const DummyRequest *request,
@@ -192,13 +201,20 @@ public:
         static Status ProcessProjectStubsRequest(BaseTestGen *testGen, StubsWriter *stubsWriter);
 
         friend bool LogUtils::logChannelsWatcher(Server &server);
+        friend void LogUtils::closeOutdatedLogChannels(Server &server, const TimeUtils::systemClockTimePoint &now);
     private:
         std::mutex logChannelOperationsMutex;
 
         std::map <std::string, TimeUtils::systemClockTimePoint> linkedWithClient;
-        std::map <std::string, std::atomic_bool> openedChannel;
-        std::map <std::string, std::atomic_bool> openedGTestChannel;
-        std::map <std::string, std::atomic_bool> holdLockFlag;
+        /// guards openedChannel and openedGTestChannel
+        std::mutex channelStorageMutex;
+        std::map <std::string, bool> openedChannel;
+        std::map <std::string, bool> openedGTestChannel;
+        std::mutex logChannelsMutex;
+        /// reactors of channels whose RPCs are not completed yet, a reactor is deleted only after
+        /// its OnDone removes it from here. A channel which is closed but not completed yet
+        /// may be opened again, so there may be several reactors with the same callback name.
+        std::multimap <std::string, std::shared_ptr<LogChannelReactor>> logChannels;
         concurrent_set<std::string> clients;
 
         template <class Key, class Value>
@@ -206,20 +222,33 @@ public:
 
         ConcurrentMap<std::string, RequestLockMutex> locks;
 
+        /// bounds the number of requests processed at once, clients are served in turn
+        /// because each of them has at most one request waiting for a slot
+        FairSemaphore activeRequests;
+
+        struct RequestLock {
+            std::unique_lock<RequestLockMutex> clientLock;
+            std::unique_lock<FairSemaphore> activeRequestSlot;
+        };
+
         RequestLockMutex &getLock();
 
-        std::unique_lock<RequestLockMutex> acquireLock(ProgressWriter *writer = nullptr);
+        RequestLock acquireLock(ProgressWriter *writer = nullptr);
 
         static std::shared_ptr<LineInfo> getLineInfo(LineTestGen &lineTestGen);
 
         static Status failedToLoadCDbStatus(const CompilationDatabaseException &e);
 
-        Status provideLoggingCallbacks(const std::string &callbackPrefix,
-                                       ServerWriter<LogEntry> *writer,
-                                       const std::string &logLevel,
-                                       loguru::log_handler_t handler,
-                                       std::map<std::string, std::atomic_bool> &channelStorage,
-                                       bool openFiles);
+        ServerWriteReactor<LogEntry> *openLogChannel(CallbackServerContext *context,
+                                                     const std::string &callbackPrefix,
+                                                     const std::string &logLevel,
+                                                     loguru::log_handler_t handler,
+                                                     std::map<std::string, bool> &channelStorage,
+                                                     bool openFiles);
+
+        void closeLogChannel(const std::string &callbackName);
+
+        static unsigned int getMaxActiveRequests();
 
     protected:
         bool testMode = false;
@@ -227,6 +256,7 @@ public:
 
     TestsGenServiceImpl testsService;
     friend bool LogUtils::logChannelsWatcher(Server &server);
+    friend void LogUtils::closeOutdatedLogChannels(Server &server, const TimeUtils::systemClockTimePoint &now);
 private:
     std::string host;
     uint16_t port;
@@ -245,15 +275,6 @@ private:
 
     static uint16_t getPort();
 
-    struct WriterData {
-        ServerWriter<LogEntry> *writer;
-        std::mutex writerMutex;
-        const std::string client;
-    };
-
-    //recommended size from loguru
-    const static size_t LOGURU_BUFFER_SIZE = 17;
-
     static void logToClient(void *channel, const loguru::Message &message);
 
     static void gtestLog(void *channel, const loguru::Message &message);
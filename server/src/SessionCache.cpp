@@ -0,0 +1,211 @@
+#include "SessionCache.h"
+
+#include "Paths.h"
+#include "SynchronizationIndex.h"
+#include "commands/Commands.h"
+#include "testgens/BaseTestGen.h"
+#include "utils/ExecUtils.h"
+#include "utils/HashUtils.h"
+#include "utils/StringUtils.h"
+
+#include "loguru.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+SessionCache &SessionCache::getInstance() {
+    static SessionCache instance(Commands::sessionCacheSize);
+    return instance;
+}
+
+SessionCache::SessionCache(size_t capacity) : capacity(capacity) {
+}
+
+std::optional<std::string> SessionCache::getContentHash(const fs::path &path) {
+    std::ifstream stream(path.string());
+    if (!stream.is_open()) {
+        return std::nullopt;
+    }
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    return HashUtils::sha1(buffer.str());
+}
+
+std::string SessionCache::getSessionKey(const utbot::ProjectContext &projectContext,
+                                        bool skipObjectWithoutSource) {
+    std::string itfPath = projectContext.hasItfPath() ? projectContext.getItfAbsPath().string() : "";
+    return StringUtils::joinWith(std::vector<std::string>{ projectContext.projectName,
+                                                           projectContext.projectPath.string(),
+                                                           projectContext.clientProjectPath.string(),
+                                                           projectContext.getTestDirAbsPath().string(),
+                                                           projectContext.getReportDirAbsPath().string(),
+                                                           projectContext.getBuildDirAbsPath().string(),
+                                                           itfPath,
+                                                           std::to_string(skipObjectWithoutSource) },
+                                 "\n");
+}
+
+std::shared_ptr<SessionCache::Session> SessionCache::getSession(const std::string &key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = sessionsByKey.find(key);
+    if (it != sessionsByKey.end()) {
+        sessions.splice(sessions.begin(), sessions, it->second);
+        return it->second->second;
+    }
+    sessions.emplace_front(key, std::make_shared<Session>());
+    sessionsByKey[key] = sessions.begin();
+    while (sessions.size() > capacity) {
+        // requests which still use the evicted session keep it alive until they are finished
+        LOG_S(DEBUG) << "Session of project is dropped from cache:\n" << sessions.back().first;
+        sessionsByKey.erase(sessions.back().first);
+        sessions.pop_back();
+    }
+    return sessions.front().second;
+}
+
+std::shared_ptr<ProjectBuildDatabase> SessionCache::lendBuildDatabase(const std::shared_ptr<Session> &session) {
+    session->buildDatabaseLent = true;
+    std::shared_ptr<ProjectBuildDatabase> buildDatabase = session->buildDatabase;
+    // the deleter keeps the database alive and marks it free once the request drops all copies
+    return std::shared_ptr<ProjectBuildDatabase>(buildDatabase.get(), [session, buildDatabase](ProjectBuildDatabase *) {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        if (session->buildDatabase == buildDatabase) {
+            session->buildDatabaseLent = false;
+        }
+    });
+}
+
+std::shared_ptr<ProjectBuildDatabase>
+SessionCache::getProjectBuildDatabase(const fs::path &compileCommandsJsonPath,
+                                      const fs::path &serverBuildDir,
+                                      const utbot::ProjectContext &projectContext,
+                                      bool skipObjectWithoutSource) {
+    if (capacity == 0) {
+        return std::make_shared<ProjectBuildDatabase>(compileCommandsJsonPath, serverBuildDir, projectContext,
+                                                      skipObjectWithoutSource);
+    }
+    auto session = getSession(getSessionKey(projectContext, skipObjectWithoutSource));
+    std::lock_guard<std::mutex> lock(session->mutex);
+    auto compileCommandsHash = getContentHash(compileCommandsJsonPath / "compile_commands.json");
+    auto linkCommandsHash = getContentHash(compileCommandsJsonPath / "link_commands.json");
+    bool isUpToDate = session->buildDatabase != nullptr && compileCommandsHash.has_value() &&
+                      linkCommandsHash.has_value() &&
+                      session->compileCommandsHash == compileCommandsHash &&
+                      session->linkCommandsHash == linkCommandsHash;
+    if (isUpToDate && session->buildDatabaseLent) {
+        LOG_S(DEBUG) << "Cached build database is used by another request, a new one is created";
+        return std::make_shared<ProjectBuildDatabase>(compileCommandsJsonPath, serverBuildDir, projectContext,
+                                                      skipObjectWithoutSource);
+    }
+    if (isUpToDate) {
+        LOG_S(DEBUG) << "Cached build database is used";
+        for (const auto &objectInfo : session->buildDatabase->getAllCompileCommands()) {
+            objectInfo->kleeFilesInfo->setCorrectMethods({});
+            objectInfo->kleeFilesInfo->setAllAreCorrect(false);
+        }
+        return lendBuildDatabase(session);
+    }
+    session->buildDatabase = std::make_shared<ProjectBuildDatabase>(compileCommandsJsonPath, serverBuildDir,
+                                                                    projectContext, skipObjectWithoutSource);
+    session->compileCommandsHash = compileCommandsHash;
+    session->linkCommandsHash = linkCommandsHash;
+    return lendBuildDatabase(session);
+}
+
+std::shared_ptr<Fetcher::FileToStringSet> SessionCache::fetch(BaseTestGen &testGen,
+                                                              Fetcher::Options options,
+                                                              size_t *maximumAlignment,
+                                                              const std::string &logMessage) {
+    auto compilationDatabase = testGen.getTargetBuildDatabase()->compilationDatabase;
+    if (capacity == 0) {
+        Fetcher fetcher(options, compilationDatabase, testGen.tests, &testGen.types, maximumAlignment,
+                        testGen.compileCommandsJsonPath, false);
+        fetcher.fetchWithProgress(testGen.progressWriter, logMessage);
+        return fetcher.getStructsToDeclare();
+    }
+
+    auto session = getSession(getSessionKey(testGen.projectContext, testGen.settingsContext.skipObjectWithoutSource));
+    auto index = SynchronizationIndex::getInstance(Paths::getSynchronizationIndexPath(testGen.projectContext));
+    std::unordered_map<std::string, std::optional<std::string>> fingerprints;
+    for (auto it = testGen.tests.begin(); it != testGen.tests.end(); ++it) {
+        const fs::path &sourcePath = it.key();
+        std::list<std::string> commandLine;
+        fs::path directory = testGen.projectContext.projectPath;
+        if (testGen.getTargetBuildDatabase()->hasUnitInfo(sourcePath)) {
+            const auto &command = testGen.getClientCompilationUnitInfo(sourcePath)->command;
+            commandLine = command.getCommandLine();
+            directory = command.getDirectory();
+        }
+        fingerprints[sourcePath.string()] = index->getFingerprint(sourcePath, commandLine, directory,
+                                                                  testGen.projectContext.projectPath);
+    }
+    index->save();
+
+    Snapshot sources;
+    std::vector<fs::path> changedSources;
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        const Snapshot &snapshot = session->snapshots[static_cast<int>(options.value)];
+        for (auto it = testGen.tests.begin(); it != testGen.tests.end(); ++it) {
+            const fs::path &sourcePath = it.key();
+            const auto &fingerprint = fingerprints[sourcePath.string()];
+            auto cached = snapshot.find(sourcePath.string());
+            if (fingerprint.has_value() && cached != snapshot.end() && cached->second->fingerprint == fingerprint) {
+                sources[sourcePath.string()] = cached->second;
+            } else {
+                changedSources.push_back(sourcePath);
+            }
+        }
+    }
+    LOG_S(DEBUG) << "Sources to fetch: " << changedSources.size() << " of " << testGen.tests.size();
+
+    if (!changedSources.empty()) {
+        ExecUtils::doWorkWithProgress(changedSources, testGen.progressWriter, logMessage,
+                                      [&](const fs::path &sourcePath) {
+            auto source = std::make_shared<SourceSnapshot>();
+            source->fingerprint = fingerprints[sourcePath.string()];
+            source->maximumAlignment = *maximumAlignment;
+            tests::TestsMap sourceTests;
+            sourceTests[sourcePath] = testGen.tests.at(sourcePath);
+            Fetcher fetcher(options, compilationDatabase, sourceTests, &source->types, &source->maximumAlignment,
+                            testGen.compileCommandsJsonPath, false);
+            fetcher.fetch();
+            source->tests = sourceTests.at(sourcePath);
+            auto structs = fetcher.getStructsToDeclare()->find(sourcePath);
+            if (structs != fetcher.getStructsToDeclare()->end()) {
+                source->structsToDeclare = structs->second;
+            }
+            sources[sourcePath.string()] = std::move(source);
+        });
+        std::lock_guard<std::mutex> lock(session->mutex);
+        Snapshot &snapshot = session->snapshots[static_cast<int>(options.value)];
+        for (const fs::path &sourcePath : changedSources) {
+            snapshot[sourcePath.string()] = sources[sourcePath.string()];
+        }
+    } else {
+        LOG_S(DEBUG) << "All sources are fetched already";
+    }
+
+    auto structsToDeclare = std::make_shared<Fetcher::FileToStringSet>();
+    testGen.types = {};
+    for (auto it = testGen.tests.begin(); it != testGen.tests.end(); ++it) {
+        const fs::path &sourcePath = it.key();
+        const SourceSnapshot &source = *sources.at(sourcePath.string());
+        tests::Tests &tests = it.value();
+        tests = source.tests;
+        // storages are filled by later stages of the request, so they are not shared
+        for (auto methodIt = tests.methods.begin(); methodIt != tests.methods.end(); ++methodIt) {
+            methodIt.value().stubsParamStorage = std::make_shared<StubsStorage>();
+            methodIt.value().stubsStorage = std::make_shared<StubsStorage>();
+        }
+        if (!source.structsToDeclare.empty()) {
+            (*structsToDeclare)[sourcePath] = source.structsToDeclare;
+        }
+        // types of headers are the same for all sources which include them
+        testGen.types.structs.insert(source.types.structs.begin(), source.types.structs.end());
+        testGen.types.enums.insert(source.types.enums.begin(), source.types.enums.end());
+        *maximumAlignment = std::max(*maximumAlignment, source.maximumAlignment);
+    }
+    return structsToDeclare;
+}
@@ -0,0 +1,111 @@
+#ifndef UNITTESTBOT_SESSIONCACHE_H
+#define UNITTESTBOT_SESSIONCACHE_H
+
+#include "ProjectContext.h"
+#include "Tests.h"
+#include "building/ProjectBuildDatabase.h"
+#include "fetchers/Fetcher.h"
+#include "types/Types.h"
+
+#include "utils/path/FileSystemPath.h"
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+class BaseTestGen;
+
+/**
+ * Keeps compilation databases and parsed sources of recently used projects between
+ * requests, so that repeated requests of an IDE don't parse the whole target again.
+ * A build database is rebuilt when compile_commands.json or link_commands.json
+ * changes. Declarations are fetched again only for sources whose fingerprint
+ * (content, flags and project headers, see SynchronizationIndex) has changed.
+ * The least recently used projects are dropped when the cache is full.
+ */
+class SessionCache {
+public:
+    static SessionCache &getInstance();
+
+    /**
+     * @param capacity number of projects kept in memory, 0 disables the cache
+     */
+    explicit SessionCache(size_t capacity);
+
+    SessionCache(const SessionCache &) = delete;
+    SessionCache &operator=(const SessionCache &) = delete;
+
+    /**
+     * Returns the cached build database if its build commands are not changed and it is
+     * not used by another request at the moment, otherwise creates a new one.
+     * Information about klee files of the cached database is reset, as it is filled per request.
+     */
+    std::shared_ptr<ProjectBuildDatabase> getProjectBuildDatabase(const fs::path &compileCommandsJsonPath,
+                                                                  const fs::path &serverBuildDir,
+                                                                  const utbot::ProjectContext &projectContext,
+                                                                  bool skipObjectWithoutSource);
+
+    /**
+     * Fills tests, types and maximum alignment of the request the same way Fetcher does.
+     * Only sources which are not fetched yet or have changed since are parsed, one by one,
+     * so that types are known per source; results for other sources are copied from the cache.
+     * Requests of the same project may parse the same changed source concurrently.
+     * @return structs which should be declared in test headers of the sources
+     */
+    std::shared_ptr<Fetcher::FileToStringSet> fetch(BaseTestGen &testGen,
+                                                    Fetcher::Options options,
+                                                    size_t *maximumAlignment,
+                                                    const std::string &logMessage);
+
+private:
+    /// declarations of a single source, they are never changed, so requests share them
+    struct SourceSnapshot {
+        /// std::nullopt for sources which are fetched by every request
+        std::optional<std::string> fingerprint;
+        tests::Tests tests;
+        /// types of the source and of headers it includes, so a type removed from a header
+        /// disappears as soon as sources including the header are fetched again
+        types::TypeMaps types;
+        size_t maximumAlignment = 0;
+        std::unordered_set<std::string> structsToDeclare;
+    };
+
+    /// declarations of sources fetched with the same options
+    using Snapshot = std::unordered_map<std::string, std::shared_ptr<const SourceSnapshot>>;
+
+    /// mutex is held only while the session is read or updated, sources are parsed without it
+    struct Session {
+        std::mutex mutex;
+        std::shared_ptr<ProjectBuildDatabase> buildDatabase;
+        /// klee files info of a database is filled per request, so it is lent to one request at a time
+        bool buildDatabaseLent = false;
+        /// build commands are rewritten by every request, so their content is compared
+        std::optional<std::string> compileCommandsHash, linkCommandsHash;
+        std::map<int, Snapshot> snapshots;
+    };
+
+    using SessionList = std::list<std::pair<std::string, std::shared_ptr<Session>>>;
+
+    const size_t capacity;
+    std::mutex mutex;
+    /// the most recently used session goes first
+    SessionList sessions;
+    std::unordered_map<std::string, SessionList::iterator> sessionsByKey;
+
+    std::shared_ptr<Session> getSession(const std::string &key);
+
+    /// @return the database of the session which is given back when the request drops it
+    static std::shared_ptr<ProjectBuildDatabase> lendBuildDatabase(const std::shared_ptr<Session> &session);
+
+    /// SHA-1 of the file, the same digest SynchronizationIndex uses for sources
+    static std::optional<std::string> getContentHash(const fs::path &path);
+
+    static std::string getSessionKey(const utbot::ProjectContext &projectContext, bool skipObjectWithoutSource);
+};
+
+
+#endif // UNITTESTBOT_SESSIONCACHE_H
@@ -22,7 +22,8 @@ namespace utbot {
                         bool useStubs,
                         testsgen::ErrorMode errorMode,
                         bool differentVariablesOfTheSameType,
-                        bool skipObjectWithoutSource);
+                        bool skipObjectWithoutSource,
+                        bool incrementalGeneration);
 
         const bool generateForStaticFunctions;
         const bool verbose;
@@ -32,6 +33,8 @@ namespace utbot {
         testsgen::ErrorMode errorMode;
         const bool differentVariablesOfTheSameType;
         const bool skipObjectWithoutSource;
+        /// KLEE is not run again for functions unchanged since the previous generation
+        const bool incrementalGeneration;
     };
 }
 
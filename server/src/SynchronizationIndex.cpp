@@ -0,0 +1,426 @@
+#include "SynchronizationIndex.h"
+
+#include "Paths.h"
+#include "Version.h"
+#include "utils/CollectionUtils.h"
+#include "utils/HashUtils.h"
+#include "utils/JsonUtils.h"
+
+#include "loguru.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <queue>
+#include <sstream>
+#include <system_error>
+#include <unordered_set>
+
+namespace {
+    std::optional<std::pair<int64_t, uintmax_t>> getFileStat(const fs::path &path) {
+        std::error_code ec;
+        auto time = std::filesystem::last_write_time(path.string(), ec);
+        if (ec) {
+            return std::nullopt;
+        }
+        uintmax_t size = std::filesystem::file_size(path.string(), ec);
+        if (ec) {
+            return std::nullopt;
+        }
+        return std::make_pair(static_cast<int64_t>(time.time_since_epoch().count()), size);
+    }
+
+    std::string readFile(const fs::path &path) {
+        std::ifstream stream(path.string());
+        std::stringstream buffer;
+        buffer << stream.rdbuf();
+        return buffer.str();
+    }
+
+    size_t skipSpaces(const std::string &line, size_t pos) {
+        while (pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos]))) {
+            ++pos;
+        }
+        return pos;
+    }
+
+    /**
+     * Finds include directives without running preprocessor. Conditional includes are
+     * taken into account too, which causes extra regeneration at worst.
+     * @return included names with delimiters, e.g. "foo.h" or <foo.h>, or the rest of the
+     * directive if the name is given by a macro
+     */
+    std::vector<std::string> findIncludes(const std::string &content) {
+        static const std::vector<std::string> DIRECTIVES = { "include_next", "include" };
+        std::vector<std::string> includes;
+        std::istringstream stream(content);
+        std::string line;
+        while (std::getline(stream, line)) {
+            size_t pos = skipSpaces(line, 0);
+            if (pos == line.size() || line[pos] != '#') {
+                continue;
+            }
+            pos = skipSpaces(line, pos + 1);
+            auto directive = std::find_if(DIRECTIVES.begin(), DIRECTIVES.end(), [&](const std::string &name) {
+                return line.compare(pos, name.size(), name) == 0;
+            });
+            if (directive == DIRECTIVES.end()) {
+                continue;
+            }
+            size_t namePos = pos + directive->size();
+            if (namePos < line.size() && std::isalnum(static_cast<unsigned char>(line[namePos]))) {
+                continue;
+            }
+            pos = skipSpaces(line, namePos);
+            if (pos == line.size()) {
+                continue;
+            }
+            if (line[pos] != '"' && line[pos] != '<') {
+                includes.push_back(line.substr(pos));
+                continue;
+            }
+            size_t end = line.find(line[pos] == '"' ? '"' : '>', pos + 1);
+            if (end != std::string::npos) {
+                includes.push_back(line.substr(pos, end - pos + 1));
+            }
+        }
+        return includes;
+    }
+
+    /**
+     * Directories which the preprocessor looks through for included files, in its order.
+     */
+    struct SearchPaths {
+        /// -iquote, only for includes with quotes
+        std::vector<fs::path> quoteDirs;
+        /// -I, -isystem and -idirafter
+        std::vector<fs::path> dirs;
+        /// -include and -imacros, which are processed before the source
+        std::vector<std::string> forcedIncludes;
+    };
+
+    SearchPaths getSearchPaths(const std::list<std::string> &commandLine, const fs::path &directory) {
+        enum class Kind { QUOTE, REGULAR, SYSTEM, AFTER, FORCED, IGNORED };
+        // longer spellings go first, as each of them is matched as a prefix of a joined argument
+        static const std::vector<std::pair<std::string, Kind>> FLAGS = {
+            { "--include-directory-after", Kind::AFTER },
+            { "--include-directory", Kind::REGULAR },
+            { "--include", Kind::FORCED },
+            { "-include-pch", Kind::IGNORED },
+            { "-include", Kind::FORCED },
+            { "-imacros", Kind::FORCED },
+            { "-idirafter", Kind::AFTER },
+            { "-isystem-after", Kind::AFTER },
+            { "-isystem", Kind::SYSTEM },
+            { "-iquote", Kind::QUOTE },
+            { "-I", Kind::REGULAR },
+        };
+        SearchPaths searchPaths;
+        std::vector<fs::path> systemDirs, afterDirs;
+        for (auto it = commandLine.begin(); it != commandLine.end(); ++it) {
+            for (const auto &[flag, kind] : FLAGS) {
+                if (it->rfind(flag, 0) != 0) {
+                    continue;
+                }
+                std::string value = it->substr(flag.size());
+                if (value.empty()) {
+                    if (std::next(it) == commandLine.end()) {
+                        break;
+                    }
+                    value = *++it;
+                } else if (flag.rfind("--", 0) == 0) {
+                    if (value[0] != '=') {
+                        continue;
+                    }
+                    value.erase(0, 1);
+                }
+                fs::path dir = fs::is_absolute(value) ? fs::path(value) : directory / value;
+                switch (kind) {
+                case Kind::QUOTE:
+                    searchPaths.quoteDirs.push_back(dir);
+                    break;
+                case Kind::REGULAR:
+                    searchPaths.dirs.push_back(dir);
+                    break;
+                case Kind::SYSTEM:
+                    systemDirs.push_back(dir);
+                    break;
+                case Kind::AFTER:
+                    afterDirs.push_back(dir);
+                    break;
+                case Kind::FORCED:
+                    searchPaths.forcedIncludes.push_back("\"" + value + "\"");
+                    break;
+                case Kind::IGNORED:
+                    break;
+                }
+                break;
+            }
+        }
+        CollectionUtils::extend(searchPaths.dirs, systemDirs);
+        CollectionUtils::extend(searchPaths.dirs, afterDirs);
+        return searchPaths;
+    }
+
+    /**
+     * @param currentDir directory of the including file, which is looked through first
+     * for includes with quotes
+     * @return std::nullopt if the file is not found or its name is given by a macro
+     */
+    std::optional<fs::path> resolveInclude(const std::string &include,
+                                           const fs::path &currentDir,
+                                           const SearchPaths &searchPaths) {
+        if (include.size() < 2 || (include[0] != '"' && include[0] != '<')) {
+            return std::nullopt;
+        }
+        std::string name = include.substr(1, include.size() - 2);
+        std::vector<fs::path> candidates;
+        if (fs::is_absolute(name)) {
+            candidates.emplace_back(name);
+        } else {
+            if (include[0] == '"') {
+                candidates.push_back(currentDir / name);
+                for (const fs::path &dir : searchPaths.quoteDirs) {
+                    candidates.push_back(dir / name);
+                }
+            }
+            for (const fs::path &dir : searchPaths.dirs) {
+                candidates.push_back(dir / name);
+            }
+        }
+        for (const fs::path &candidate : candidates) {
+            std::error_code ec;
+            if (std::filesystem::is_regular_file(candidate.string(), ec)) {
+                return candidate.lexically_normal();
+            }
+        }
+        return std::nullopt;
+    }
+}
+
+const int SynchronizationIndex::FORMAT = 2;
+
+std::shared_ptr<SynchronizationIndex> SynchronizationIndex::getInstance(const fs::path &indexPath) {
+    static std::mutex instancesMutex;
+    static std::map<fs::path, std::shared_ptr<SynchronizationIndex>> instances;
+    std::lock_guard<std::mutex> lock(instancesMutex);
+    auto &instance = instances[indexPath];
+    if (instance == nullptr) {
+        instance = std::make_shared<SynchronizationIndex>(indexPath);
+    }
+    return instance;
+}
+
+SynchronizationIndex::SynchronizationIndex(fs::path indexPath) : indexPath(std::move(indexPath)) {
+    load();
+}
+
+void SynchronizationIndex::load() {
+    if (!fs::exists(indexPath)) {
+        return;
+    }
+    try {
+        nlohmann::json index = JsonUtils::getJsonFromFile(indexPath);
+        if (index.value("version", "") != UTBOT_BUILD_VERSION || index.value("format", 0) != FORMAT) {
+            LOG_S(DEBUG) << "Synchronization index was created by another version or in another format, it is ignored";
+            return;
+        }
+        for (const auto &[path, file] : index.at("files").items()) {
+            files[path] = { file.at("time"), file.at("size"), file.at("hash").get<std::string>(),
+                            file.at("includes").get<std::vector<std::string>>() };
+        }
+        for (const auto &[path, artifact] : index.at("artifacts").items()) {
+            setArtifact(path, { artifact.at("fingerprint").get<std::string>(), artifact.at("time"),
+                                artifact.at("hash").get<std::string>(),
+                                artifact.at("symbols").get<std::vector<std::string>>() });
+        }
+    } catch (const std::exception &e) {
+        LOG_S(WARNING) << "Failed to read synchronization index " << indexPath << ": " << e.what();
+        files.clear();
+        artifacts.clear();
+        artifactsBySymbol.clear();
+    }
+}
+
+void SynchronizationIndex::save() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!changed) {
+        return;
+    }
+    nlohmann::json index;
+    index["version"] = UTBOT_BUILD_VERSION;
+    index["format"] = FORMAT;
+    index["files"] = nlohmann::json::object();
+    for (const auto &[path, file] : files) {
+        index["files"][path] = { { "time", file.time },
+                                 { "size", file.size },
+                                 { "hash", file.hash },
+                                 { "includes", file.includes } };
+    }
+    index["artifacts"] = nlohmann::json::object();
+    for (const auto &[path, artifact] : artifacts) {
+        index["artifacts"][path] = { { "fingerprint", artifact.fingerprint },
+                                     { "time", artifact.time },
+                                     { "hash", artifact.hash },
+                                     { "symbols", artifact.symbols } };
+    }
+    try {
+        fs::create_directories(indexPath.parent_path());
+        // index is replaced atomically, so an interrupted server doesn't leave it broken
+        fs::path tmpPath = indexPath.string() + ".tmp";
+        JsonUtils::writeJsonToFile(tmpPath, index);
+        fs::rename(tmpPath, indexPath);
+        changed = false;
+    } catch (const std::exception &e) {
+        LOG_S(WARNING) << "Failed to save synchronization index " << indexPath << ": " << e.what();
+    }
+}
+
+const SynchronizationIndex::FileState &SynchronizationIndex::getFileState(const fs::path &path) {
+    FileState &state = files[path.string()];
+    auto stat = getFileStat(path);
+    if (!stat.has_value()) {
+        state = FileState();
+        return state;
+    }
+    if (state.time == stat->first && state.size == stat->second) {
+        return state;
+    }
+    std::string content = readFile(path);
+    state = { stat->first, stat->second, HashUtils::sha1(content), findIncludes(content) };
+    changed = true;
+    return state;
+}
+
+std::optional<std::string> SynchronizationIndex::getFingerprint(const fs::path &sourcePath,
+                                                                const std::list<std::string> &commandLine,
+                                                                const fs::path &directory,
+                                                                const fs::path &projectPath) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::string> parts(commandLine.begin(), commandLine.end());
+    // number of arguments separates them from the files
+    parts.push_back(std::to_string(commandLine.size()));
+    auto searchPaths = getSearchPaths(commandLine, directory);
+    std::unordered_set<std::string> visited;
+    std::queue<fs::path> queue;
+    auto enqueue = [&](const std::string &include, const fs::path &currentDir) {
+        auto header = resolveInclude(include, currentDir, searchPaths);
+        if (!header.has_value()) {
+            // an include with quotes which is not found may be a changed file of the project,
+            // ones with angle brackets which are not found are taken for system headers
+            return include[0] == '<';
+        }
+        if (Paths::isSubPathOf(projectPath, header.value()) && visited.insert(header->string()).second) {
+            queue.push(header.value());
+        }
+        return true;
+    };
+    for (const std::string &include : searchPaths.forcedIncludes) {
+        // forced includes are looked for in the directory of the command instead of the source's one
+        if (!enqueue(include, directory)) {
+            LOG_S(DEBUG) << "Forced include " << include << " of " << sourcePath << " is not found";
+            return std::nullopt;
+        }
+    }
+    visited.insert(sourcePath.string());
+    queue.push(sourcePath);
+    while (!queue.empty()) {
+        fs::path path = queue.front();
+        queue.pop();
+        const FileState &state = getFileState(path);
+        parts.push_back(path.string());
+        parts.push_back(state.hash);
+        for (const std::string &include : state.includes) {
+            if (!enqueue(include, path.parent_path())) {
+                LOG_S(DEBUG) << "Include " << include << " of " << path << " is not found, "
+                             << sourcePath << " is treated as changed";
+                return std::nullopt;
+            }
+        }
+    }
+    return HashUtils::sha1(parts);
+}
+
+bool SynchronizationIndex::isUpToDate(const fs::path &artifactPath, const std::string &fingerprint) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = artifacts.find(artifactPath.string());
+    if (it == artifacts.end() || it->second.fingerprint.empty() || it->second.fingerprint != fingerprint) {
+        return false;
+    }
+    ArtifactState &artifact = it->second;
+    auto stat = getFileStat(artifactPath);
+    if (!stat.has_value()) {
+        return false;
+    }
+    if (artifact.time == stat->first) {
+        return true;
+    }
+    if (artifact.hash != HashUtils::sha1(readFile(artifactPath))) {
+        return false;
+    }
+    artifact.time = stat->first;
+    changed = true;
+    return true;
+}
+
+void SynchronizationIndex::update(const fs::path &artifactPath, std::optional<std::string> fingerprint,
+                                  std::vector<std::string> symbols) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto stat = getFileStat(artifactPath);
+    if (!stat.has_value()) {
+        eraseArtifact(artifactPath.string());
+    } else {
+        setArtifact(artifactPath.string(),
+                    { std::move(fingerprint).value_or(""), stat->first, HashUtils::sha1(readFile(artifactPath)),
+                      std::move(symbols) });
+    }
+    changed = true;
+}
+
+void SynchronizationIndex::forget(const fs::path &artifactPath) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (artifacts.count(artifactPath.string()) > 0) {
+        eraseArtifact(artifactPath.string());
+        changed = true;
+    }
+}
+
+std::vector<fs::path> SynchronizationIndex::findArtifactsBySymbol(const std::string &symbol) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<fs::path> result;
+    auto it = artifactsBySymbol.find(symbol);
+    if (it == artifactsBySymbol.end()) {
+        return result;
+    }
+    for (const std::string &artifactPath : it->second) {
+        if (fs::exists(artifactPath)) {
+            result.emplace_back(artifactPath);
+        }
+    }
+    return result;
+}
+
+void SynchronizationIndex::setArtifact(const std::string &artifactPath, ArtifactState artifact) {
+    eraseArtifact(artifactPath);
+    for (const std::string &symbol : artifact.symbols) {
+        artifactsBySymbol[symbol].insert(artifactPath);
+    }
+    artifacts[artifactPath] = std::move(artifact);
+}
+
+void SynchronizationIndex::eraseArtifact(const std::string &artifactPath) {
+    auto it = artifacts.find(artifactPath);
+    if (it == artifacts.end()) {
+        return;
+    }
+    for (const std::string &symbol : it->second.symbols) {
+        auto symbolIt = artifactsBySymbol.find(symbol);
+        symbolIt->second.erase(artifactPath);
+        if (symbolIt->second.empty()) {
+            artifactsBySymbol.erase(symbolIt);
+        }
+    }
+    artifacts.erase(it);
+}
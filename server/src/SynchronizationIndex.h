@@ -0,0 +1,113 @@
+#ifndef UNITTESTBOT_SYNCHRONIZATIONINDEX_H
+#define UNITTESTBOT_SYNCHRONIZATIONINDEX_H
+
+#include "utils/path/FileSystemPath.h"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Persistent index which tells whether generated stubs and wrappers are up to date.
+ * Every artifact is stored with a fingerprint of its source: SHA-1 of the source content,
+ * of its compilation flags and of project headers it includes. Hashes are kept between
+ * runs, so they don't depend on the build of the server. Content hashes are
+ * recomputed only for files whose modification time or size has changed, so touching
+ * a file or checking out the same revision again doesn't cause regeneration.
+ * Functions defined in generated stubs are indexed too, so stubs are found by symbol
+ * without parsing them.
+ */
+class SynchronizationIndex {
+public:
+    /**
+     * Index of the project is loaded from disk once per server and shared by all requests.
+     */
+    static std::shared_ptr<SynchronizationIndex> getInstance(const fs::path &indexPath);
+
+    explicit SynchronizationIndex(fs::path indexPath);
+
+    SynchronizationIndex(const SynchronizationIndex &) = delete;
+    SynchronizationIndex &operator=(const SynchronizationIndex &) = delete;
+
+    /**
+     * @param sourcePath source file which artifacts are generated from
+     * @param commandLine command line the source file is compiled with
+     * @param directory directory the command is run in
+     * @param projectPath only headers inside the project are treated as dependencies
+     * @return std::nullopt if some included file is not found, so its changes can't be
+     * tracked and artifacts of the source should be treated as outdated
+     */
+    std::optional<std::string> getFingerprint(const fs::path &sourcePath,
+                                              const std::list<std::string> &commandLine,
+                                              const fs::path &directory,
+                                              const fs::path &projectPath);
+
+    /**
+     * @return true if artifact exists, is not modified since it was generated, and was
+     * generated from the source with the same fingerprint.
+     */
+    bool isUpToDate(const fs::path &artifactPath, const std::string &fingerprint);
+
+    /**
+     * @param fingerprint std::nullopt if the source can't be fingerprinted, then the artifact
+     * is never up to date, but its symbols are still found
+     * @param symbols functions defined in the artifact
+     */
+    void update(const fs::path &artifactPath, std::optional<std::string> fingerprint,
+                std::vector<std::string> symbols = {});
+
+    void forget(const fs::path &artifactPath);
+
+    /**
+     * Writes the index to disk if it was changed.
+     */
+    void save();
+
+    /**
+     * @return existing artifacts which define the function
+     */
+    std::vector<fs::path> findArtifactsBySymbol(const std::string &symbol);
+
+private:
+    /// indexes of other formats are ignored
+    static const int FORMAT;
+
+    struct FileState {
+        int64_t time = 0;
+        uintmax_t size = 0;
+        std::string hash;
+        std::vector<std::string> includes;
+    };
+
+    struct ArtifactState {
+        /// empty if the source can't be fingerprinted
+        std::string fingerprint;
+        int64_t time = 0;
+        std::string hash;
+        std::vector<std::string> symbols;
+    };
+
+    const fs::path indexPath;
+    std::mutex mutex;
+    std::unordered_map<std::string, FileState> files;
+    std::unordered_map<std::string, ArtifactState> artifacts;
+    std::unordered_map<std::string, std::unordered_set<std::string>> artifactsBySymbol;
+    bool changed = false;
+
+    void load();
+
+    const FileState &getFileState(const fs::path &path);
+
+    void setArtifact(const std::string &artifactPath, ArtifactState artifact);
+
+    void eraseArtifact(const std::string &artifactPath);
+};
+
+
+#endif // UNITTESTBOT_SYNCHRONIZATIONINDEX_H
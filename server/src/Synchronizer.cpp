@@ -14,7 +14,7 @@
 
 #include <iterator>
 #include <utility>
-#include <fstream>
+#include <list>
 
 using StubSet = std::unordered_set<StubOperator, HashUtils::StubHash>;
 
@@ -41,57 +41,52 @@ bool StubOperator::isHeader() const {
 
 Synchronizer::Synchronizer(BaseTestGen *testGen,
                            types::TypesHandler::SizeContext *sizeContext)
-    : testGen(testGen), sizeContext(sizeContext) {
+    : testGen(testGen), sizeContext(sizeContext),
+      index(SynchronizationIndex::getInstance(Paths::getSynchronizationIndexPath(testGen->projectContext))) {
 }
 
-long long Synchronizer::getFileOutdatedTime(const fs::path &filePath) const {
-    return TimeUtils::convertFileToSystemClock(fs::last_write_time(filePath))
-                           .time_since_epoch()
-                           .count();
-}
-
-bool Synchronizer::isProbablyOutdatedStubs(const fs::path &srcFilePath) const {
-    fs::path stubFilePath = Paths::sourcePathToStubPath(testGen->projectContext, srcFilePath);
-    if (!fs::exists(stubFilePath)) {
-        return true;
-    }
-    std::ifstream stubFile(stubFilePath);
-    std::string sLine;
-    getline(stubFile, sLine);
-    long long stubTimestamp, srcTimestamp;
-    try {
-        stubTimestamp = std::stoll(sLine.substr(2));
-    } catch (...) {
-        return true;
+std::optional<std::string> Synchronizer::getFingerprint(const fs::path &srcFilePath) const {
+    auto it = fingerprints.find(srcFilePath);
+    if (it != fingerprints.end()) {
+        return it->second;
     }
-    if (!fs::exists(srcFilePath)) {
-        srcTimestamp = time(nullptr);
-    } else {
-        srcTimestamp = Synchronizer::getFileOutdatedTime(srcFilePath);
+    std::list<std::string> commandLine;
+    fs::path directory = testGen->projectContext.projectPath;
+    auto buildDatabase = testGen->getProjectBuildDatabase();
+    if (buildDatabase->hasUnitInfo(srcFilePath)) {
+        const auto &command = buildDatabase->getClientCompilationUnitInfo(srcFilePath)->command;
+        commandLine = command.getCommandLine();
+        directory = command.getDirectory();
     }
-    return stubTimestamp <= srcTimestamp;
+    auto fingerprint = index->getFingerprint(srcFilePath, commandLine, directory,
+                                             testGen->projectContext.projectPath);
+    fingerprints.emplace(srcFilePath, fingerprint);
+    return fingerprint;
 }
 
-bool Synchronizer::isProbablyOutdatedWrappers(const fs::path &srcFilePath) const {
-    fs::path wrapperFilePath = Paths::getWrapperFilePath(testGen->projectContext, srcFilePath);
-    if (!fs::exists(wrapperFilePath)) {
+bool Synchronizer::isOutdatedStub(const StubOperator &stub) const {
+    if (!fs::exists(stub.getSourceFilePath())) {
         return true;
     }
-    long long wrapperTimestamp, srcTimestamp;
-    wrapperTimestamp = Synchronizer::getFileOutdatedTime(wrapperFilePath);
+    auto fingerprint = getFingerprint(stub.getSourceFilePath());
+    return !fingerprint.has_value() ||
+           !index->isUpToDate(stub.getStubPath(testGen->projectContext), fingerprint.value());
+}
+
+bool Synchronizer::isOutdatedWrapper(const fs::path &srcFilePath) const {
     if (!fs::exists(srcFilePath)) {
-        srcTimestamp = time(nullptr);
-    } else {
-        srcTimestamp = Synchronizer::getFileOutdatedTime(srcFilePath);
+        return true;
     }
-    return wrapperTimestamp <= srcTimestamp;
+    auto fingerprint = getFingerprint(srcFilePath);
+    return !fingerprint.has_value() ||
+           !index->isUpToDate(Paths::getWrapperFilePath(testGen->projectContext, srcFilePath),
+                              fingerprint.value());
 }
 
 CollectionUtils::FileSet Synchronizer::getOutdatedSourcePaths() const {
-    auto allFiles = testGen->getTargetSourceFiles();
     auto outdatedSources = CollectionUtils::filterOut(testGen->getTargetSourceFiles(),
                                                       [this](fs::path const &sourcePath) {
-                                                          return !isProbablyOutdatedWrappers(sourcePath);
+                                                          return !isOutdatedWrapper(sourcePath);
                                                       });
     return outdatedSources;
 }
@@ -99,7 +94,7 @@ CollectionUtils::FileSet Synchronizer::getOutdatedSourcePaths() const {
 StubSet Synchronizer::getOutdatedStubs() const {
     auto allFiles = getStubsFiles();
     auto outdatedStubs = CollectionUtils::filterOut(allFiles, [this](StubOperator const &stubOperator) {
-        return !isProbablyOutdatedStubs(stubOperator.getSourceFilePath());
+        return !isOutdatedStub(stubOperator);
     });
     return outdatedStubs;
 }
@@ -155,6 +150,7 @@ void Synchronizer::synchronize(const types::TypesHandler &typesHandler) {
     }
     auto outdatedSourcePaths = getOutdatedSourcePaths();
     synchronizeWrappers(outdatedSourcePaths, typesHandler);
+    index->save();
 }
 
 void Synchronizer::synchronizeStubs(StubSet &outdatedStubs,
@@ -197,6 +193,7 @@ void Synchronizer::synchronizeStubs(StubSet &outdatedStubs,
     SourceToHeaderRewriter(testGen->projectContext, testGen->getProjectBuildDatabase()->compilationDatabase,
                            stubFetcher.getStructsToDeclare(), testGen->serverBuildDir, typesHandler);
 
+    std::unordered_map<fs::path, std::vector<std::string>, HashUtils::PathHash> stubSymbols;
     for (const StubOperator &outdatedStub : outdatedStubs) {
         fs::path stubPath = outdatedStub.getStubPath(testGen->projectContext);
         Tests const &methodDescription = stubFilesMap[stubPath];
@@ -209,9 +206,21 @@ void Synchronizer::synchronizeStubs(StubSet &outdatedStubs,
             printer::StubsPrinter stubsPrinter(Paths::getSourceLanguage(stubPath));
             Stubs stubFile = stubsPrinter.genStubFile(tests, typesHandler, testGen->projectContext);
             testGen->synchronizedStubs.emplace_back(stubFile);
+            for (const auto &[methodName, _] : tests.methods) {
+                stubSymbols[stubPath].push_back(methodName);
+            }
         }
     }
     StubsWriter::writeStubsFilesOnServer(testGen->synchronizedStubs, testGen->projectContext.getTestDirAbsPath());
+    for (const StubOperator &outdatedStub : outdatedStubs) {
+        fs::path stubPath = outdatedStub.getStubPath(testGen->projectContext);
+        if (fs::exists(outdatedStub.getSourceFilePath())) {
+            index->update(stubPath, getFingerprint(outdatedStub.getSourceFilePath()),
+                          std::move(stubSymbols[stubPath]));
+        } else {
+            index->forget(stubPath);
+        }
+    }
 }
 
 std::shared_ptr<CompilationDatabase>
@@ -244,6 +253,8 @@ void Synchronizer::synchronizeWrappers(const CollectionUtils::FileSet &outdatedS
                                                           testGen->serverBuildDir, typesHandler);
             std::string wrapper = sourceToHeaderRewriter.generateWrapper(sourceFilePath);
             printer::SourceWrapperPrinter(Paths::getSourceLanguage(sourceFilePath)).print(testGen->projectContext, sourceFilePath, wrapper);
+            index->update(Paths::getWrapperFilePath(testGen->projectContext, sourceFilePath),
+                          getFingerprint(sourceFilePath));
         });
 }
 
@@ -2,6 +2,7 @@
 #define UNITTESTBOT_SYNCHRONIZER_H
 
 #include "ProjectContext.h"
+#include "SynchronizationIndex.h"
 
 #include "stubs/StubGen.h"
 #include "types/Types.h"
@@ -22,16 +23,23 @@ private:
 class Synchronizer {
     BaseTestGen *const testGen;
     types::TypesHandler::SizeContext *sizeContext;
+    std::shared_ptr<SynchronizationIndex> index;
+    mutable std::unordered_map<fs::path, std::optional<std::string>, HashUtils::PathHash> fingerprints;
 
     [[nodiscard]] CollectionUtils::FileSet getOutdatedSourcePaths() const;
 
     [[nodiscard]] std::unordered_set<StubOperator, HashUtils::StubHash> getOutdatedStubs() const;
 
-    [[nodiscard]] long long getFileOutdatedTime(const fs::path &filePath) const;
+    /**
+     * Fingerprint of source file, its compilation flags and project headers it includes.
+     * It is computed once per synchronization.
+     * @return std::nullopt if artifacts of the source can't be checked and are always outdated
+     */
+    [[nodiscard]] std::optional<std::string> getFingerprint(const fs::path &srcFilePath) const;
 
-    [[nodiscard]] bool isProbablyOutdatedStubs(const fs::path &srcFilePath) const;
+    [[nodiscard]] bool isOutdatedStub(const StubOperator &stub) const;
 
-    [[nodiscard]] bool isProbablyOutdatedWrappers(const fs::path &srcFilePath) const;
+    [[nodiscard]] bool isOutdatedWrapper(const fs::path &srcFilePath) const;
 
     bool removeStubIfSourceAbsent(const StubOperator &stub) const;
 
@@ -10,6 +10,7 @@
 #include "loguru.h"
 
 #include <algorithm>
+#include <array>
 #include <iterator>
 
 using namespace tests;
@@ -44,36 +45,34 @@ static const std::unordered_map<std::string, std::string> FPSpecialValuesMapping
     {"-inf", "-INFINITY"}
 };
 
-static std::string makeDecimalConstant(std::string value, const std::string &typeName) {
-    if (typeName == "long") {
-        if (value == INT64_MIN_STRING) {
-            return "(-9223372036854775807L - 1)";
-        }
-        return value + "L";
-    }
-    if (typeName == "long long") {
-        if (value == INT64_MIN_STRING) {
-            return "(-9223372036854775807LL - 1)";
-        }
-        return value + "LL";
-    }
-    if (typeName == "unsigned int") {
-        return value + "U";
-    }
-    if (typeName == "unsigned long") {
-        return value + "UL";
-    }
-    if (typeName == "unsigned long long") {
-        return value + "ULL";
-    }
-    if (typeName == "long double") {
-        if ( FPSpecialValuesMappings.find(value) == FPSpecialValuesMappings.end()) {
-            // we need it to avoid overflow in exponent for const like 1.18973e+4932L
-            // BUT! Skip the NAN/INFINITY values
+static std::string makeDecimalConstant(std::string value, types::PrimitiveKind kind) {
+    switch (kind) {
+        case types::PrimitiveKind::LONG:
+            if (value == INT64_MIN_STRING) {
+                return "(-9223372036854775807L - 1)";
+            }
             return value + "L";
-        }
+        case types::PrimitiveKind::LONG_LONG:
+            if (value == INT64_MIN_STRING) {
+                return "(-9223372036854775807LL - 1)";
+            }
+            return value + "LL";
+        case types::PrimitiveKind::UNSIGNED_INT:
+            return value + "U";
+        case types::PrimitiveKind::UNSIGNED_LONG:
+            return value + "UL";
+        case types::PrimitiveKind::UNSIGNED_LONG_LONG:
+            return value + "ULL";
+        case types::PrimitiveKind::LONG_DOUBLE:
+            if ( FPSpecialValuesMappings.find(value) == FPSpecialValuesMappings.end()) {
+                // we need it to avoid overflow in exponent for const like 1.18973e+4932L
+                // BUT! Skip the NAN/INFINITY values
+                return value + "L";
+            }
+            return value;
+        default:
+            return value;
     }
-    return value;
 }
 
 namespace tests {
@@ -97,20 +96,102 @@ std::string processFPSpecialValue(const std::string &value) {
     }
 }
 
+static std::string primitiveValueToCode(std::string value,
+                                        types::PrimitiveKind kind,
+                                        bool isBool,
+                                        bool isCharacter) {
+    value = makeDecimalConstant(std::move(value), kind);
+    value = processFPSpecialValue(value);
+    if (isBool) {
+        return value != "0" ? "true" : "false";
+    }
+    if (isCharacter) {
+        return "\'" + StringUtils::charCodeToLiteral(std::stoi(value)) + "\'";
+    }
+    return value;
+}
+
 std::shared_ptr<PrimitiveValueView> KTestObjectParser::primitiveView(const std::vector<char> &byteArray,
                                                                      const types::Type &type,
                                                                      size_t offsetInBits,
                                                                      size_t lenInBits) {
     Type readType = types::TypesHandler::isVoid(type) ? Type::minimalScalarType() : type;
-    std::string value = readBytesAsValueForType(byteArray, readType.baseType(), offsetInBits, lenInBits);
-    value = makeDecimalConstant(value, type.baseType());
-    value = processFPSpecialValue(value);
-    if (types::TypesHandler::isBoolType(type)) {
-        return std::make_shared<PrimitiveValueView>(primitiveBoolView(value));
+    std::string value = readBytesAsValueForKind(byteArray, readType.primitiveKind(), offsetInBits, lenInBits);
+    return std::make_shared<PrimitiveValueView>(
+        primitiveValueToCode(std::move(value), type.primitiveKind(), types::TypesHandler::isBoolType(type),
+                             types::TypesHandler::isCharacterType(type.baseTypeObj())));
+}
+
+PrimitiveArrayValueView::PrimitiveArrayValueView(std::vector<char> bytes,
+                                                 const types::Type &elementType,
+                                                 size_t elementLenInBits)
+    : bytes(std::move(bytes)),
+      elementLenInBits(elementLenInBits),
+      readKind(types::TypesHandler::isVoid(elementType) ? Type::minimalScalarType().primitiveKind()
+                                                        : elementType.primitiveKind()),
+      valueKind(elementType.primitiveKind()),
+      isBool(types::TypesHandler::isBoolType(elementType)),
+      isCharacter(types::TypesHandler::isCharacterType(elementType)) {
+}
+
+size_t PrimitiveArrayValueView::size() const {
+    return SizeUtils::bytesToBits(bytes.size()) / elementLenInBits;
+}
+
+std::string PrimitiveArrayValueView::getElementValue(size_t index) const {
+    std::string value = readBytesAsValueForKind(bytes, readKind, index * elementLenInBits, elementLenInBits);
+    return primitiveValueToCode(std::move(value), valueKind, isBool, isCharacter);
+}
+
+bool PrimitiveArrayValueView::isZeroElement(size_t index) const {
+    auto begin = bytes.begin() + index * elementLenInBits / CHAR_BIT;
+    return std::all_of(begin, begin + elementLenInBits / CHAR_BIT, [](char byte) { return byte == 0; });
+}
+
+std::string PrimitiveArrayValueView::getEntryValue(printer::TestsPrinter *printer) const {
+    return getEntryValue(printer, false);
+}
+
+std::string PrimitiveArrayValueView::getEntryValue(printer::TestsPrinter *printer, bool trimTrailingZeros) const {
+    size_t printedSize = size();
+    if (trimTrailingZeros && !isCharacter) {
+        while (printedSize > 1 && isZeroElement(printedSize - 1)) {
+            --printedSize;
+        }
+    }
+    std::string result = "{";
+    for (size_t i = 0; i < printedSize; ++i) {
+        if (i > 0) {
+            result += ", ";
+        }
+        result += getElementValue(i);
+    }
+    result += "}";
+    return result;
+}
+
+const std::vector<std::shared_ptr<AbstractValueView>> &PrimitiveArrayValueView::getSubViews() const {
+    if (elementViews.empty()) {
+        elementViews.reserve(size());
+        for (size_t i = 0; i < size(); ++i) {
+            elementViews.push_back(std::make_shared<PrimitiveValueView>(getElementValue(i)));
+        }
     }
-    return std::make_shared<PrimitiveValueView>(primitiveCharView(type.baseTypeObj(), value));
+    return elementViews;
 }
 
+bool PrimitiveArrayValueView::containsFPSpecialValue() {
+    if (valueKind != types::PrimitiveKind::FLOAT && valueKind != types::PrimitiveKind::DOUBLE &&
+        valueKind != types::PrimitiveKind::LONG_DOUBLE) {
+        return false;
+    }
+    for (size_t i = 0; i < size(); ++i) {
+        if (isFPSpecialValue(getElementValue(i))) {
+            return true;
+        }
+    }
+    return false;
+}
 
 std::shared_ptr<EnumValueView> KTestObjectParser::enumView(const std::vector<char> &byteArray,
                                                            const types::EnumInfo &enumInfo,
@@ -150,6 +231,40 @@ std::shared_ptr<StringValueView> KTestObjectParser::stringLiteralView(const std:
     return std::make_shared<StringValueView>(value);
 }
 
+static std::vector<std::shared_ptr<AbstractValueView>>
+groupArrayViews(const std::vector<std::shared_ptr<AbstractValueView>> &views, size_t size) {
+    std::vector<std::shared_ptr<AbstractValueView>> newViews;
+    for (size_t j = 0; j < views.size(); j += size) {
+        std::vector<std::shared_ptr<AbstractValueView>> curViews =
+            std::vector(views.begin() + j, views.begin() + j + size);
+        newViews.push_back(std::make_shared<ArrayValueView>(curViews));
+    }
+    return newViews;
+}
+
+/**
+ * Checks whether array of primitives can be stored as PrimitiveArrayValueView:
+ * it is byte aligned, consists of whole elements and lies inside of byteArray.
+ */
+static bool isPackedPrimitiveArray(const std::vector<char> &byteArray,
+                                   size_t arraySizeInBits,
+                                   size_t offsetInBits,
+                                   size_t elementLenInBits) {
+    return elementLenInBits > 0 && elementLenInBits % CHAR_BIT == 0 &&
+           offsetInBits % CHAR_BIT == 0 && arraySizeInBits % elementLenInBits == 0 &&
+           (offsetInBits + arraySizeInBits) / CHAR_BIT <= byteArray.size();
+}
+
+static std::shared_ptr<PrimitiveArrayValueView> packedPrimitiveArrayView(const std::vector<char> &byteArray,
+                                                                          const types::Type &elementType,
+                                                                          size_t arraySizeInBits,
+                                                                          size_t offsetInBits,
+                                                                          size_t elementLenInBits) {
+    auto begin = byteArray.begin() + offsetInBits / CHAR_BIT;
+    std::vector<char> bytes(begin, begin + arraySizeInBits / CHAR_BIT);
+    return std::make_shared<PrimitiveArrayValueView>(std::move(bytes), elementType, elementLenInBits);
+}
+
 std::shared_ptr<ArrayValueView> KTestObjectParser::multiArrayView(const std::vector<char> &byteArray,
                                                                   const std::vector<Pointer> &lazyPointersArray,
                                                                   const types::Type &type,
@@ -162,6 +277,19 @@ std::shared_ptr<ArrayValueView> KTestObjectParser::multiArrayView(const std::vec
     size_t elementLenInBits = (types::TypesHandler::isVoid(baseType))
                               ? typesHandler.typeSize(Type::minimalScalarType())
                               : typesHandler.typeSize(baseType);
+    std::vector<size_t> sizes = type.arraysSizes(usage);
+
+    if (typesHandler.getTypeKind(baseType) == TypeKind::PRIMITIVE && sizes.size() > 1 &&
+        isPackedPrimitiveArray(byteArray, arraySizeInBits, offsetInBits, elementLenInBits * sizes.back())) {
+        size_t rowLenInBits = elementLenInBits * sizes.back();
+        for (size_t curPos = offsetInBits; curPos < offsetInBits + arraySizeInBits; curPos += rowLenInBits) {
+            views.push_back(packedPrimitiveArrayView(byteArray, baseType, rowLenInBits, curPos, elementLenInBits));
+        }
+        for (size_t i = sizes.size() - 2; i > 0; i--) {
+            views = groupArrayViews(views, sizes[i]);
+        }
+        return std::make_shared<ArrayValueView>(views);
+    }
 
     for (size_t curPos = offsetInBits; curPos < offsetInBits + arraySizeInBits; curPos += elementLenInBits) {
         switch (typesHandler.getTypeKind(baseType)) {
@@ -195,16 +323,8 @@ std::shared_ptr<ArrayValueView> KTestObjectParser::multiArrayView(const std::vec
         }
     }
 
-    std::vector<size_t> sizes = type.arraysSizes(usage);
     for (size_t i = sizes.size() - 1; i > 0; i--) {
-        size_t size = sizes[i];
-        std::vector<std::shared_ptr<AbstractValueView>> newViews;
-        for (size_t j = 0; j < views.size(); j += size) {
-            std::vector<std::shared_ptr<AbstractValueView>> curViews =
-                std::vector(views.begin() + j, views.begin() + j + size);
-            newViews.push_back(std::make_shared<ArrayValueView>(curViews));
-        }
-        views = newViews;
+        views = groupArrayViews(views, sizes[i]);
     }
 
     return std::make_shared<ArrayValueView>(views);
@@ -235,6 +355,12 @@ std::shared_ptr<ArrayValueView> KTestObjectParser::arrayView(const std::vector<c
                               ? typesHandler.typeSize(Type::minimalScalarType())
                               : typesHandler.typeSize(type);
 
+    if (typesHandler.getTypeKind(type) == TypeKind::PRIMITIVE &&
+        isPackedPrimitiveArray(byteArray, arraySizeInBits, offsetInBits, elementLenInBits)) {
+        return packedPrimitiveArrayView(byteArray, type.baseTypeObj(), arraySizeInBits, offsetInBits,
+                                        elementLenInBits);
+    }
+
     for (size_t curPos = offsetInBits; curPos < offsetInBits + arraySizeInBits; curPos += elementLenInBits) {
         switch (typesHandler.getTypeKind(type)) {
             case TypeKind::STRUCT_LIKE:
@@ -380,7 +506,7 @@ std::shared_ptr<StructValueView> KTestObjectParser::structView(const std::vector
             }
                 break;
             case TypeKind::OBJECT_POINTER: {
-                std::string res = readBytesAsValueForType(byteArray, PointerWidthType,
+                std::string res = readBytesAsValueForKind(byteArray, PointerWidthKind,
                                                           fieldStartOffset, PointerWidthSizeInBits);
                 auto pointerIterator =
                     std::find_if(lazyPointersArray.begin(), lazyPointersArray.end(),
@@ -441,77 +567,49 @@ std::shared_ptr<StructValueView> KTestObjectParser::structView(const std::vector
                                              anonymousField, isInitializedStruct, dirtyInitializedStruct, fieldIndexToInitUnion);
 }
 
-std::string KTestObjectParser::primitiveCharView(const types::Type &type, std::string value) {
-    if (types::TypesHandler::isCharacterType(type)) {
-        return "\'" + StringUtils::charCodeToLiteral(std::stoi(value)) + "\'";
-    }
-    return value;
+std::string readBytesAsValueForType(const std::vector<char> &byteArray,
+                                    const std::string &typeName,
+                                    size_t offsetInBits,
+                                    size_t lenInBits) {
+    return readBytesAsValueForKind(byteArray, types::getPrimitiveKind(typeName), offsetInBits, lenInBits);
 }
 
-std::string KTestObjectParser::primitiveBoolView(const std::string &value) {
-    if (value != "0") {
-        return "true";
-    }
-    return "false";
+namespace {
+    using BytesDecoder = std::string (*)(const std::vector<char> &, size_t, size_t);
+
+    std::string readNothing(const std::vector<char> &, size_t, size_t) {
+        return "";
+    }
+
+    // indexed by types::PrimitiveKind, keep in sync with its declaration
+    const std::array<BytesDecoder, static_cast<size_t>(types::PrimitiveKind::COUNT)> bytesDecoders = {
+        readNothing,
+        //we use different name for utbot_byte to not trigger char processing
+        readBytesAsValue<char>,
+        readBytesAsValue<short>,
+        readBytesAsValue<int>,
+        readBytesAsValue<long>,
+        readBytesAsValue<long long>,
+        readBytesAsValue<unsigned short>,
+        readBytesAsValue<unsigned int>,
+        readBytesAsValue<unsigned long>,
+        readBytesAsValue<unsigned long long>,
+        readBytesAsValue<char>,
+        readBytesAsValue<signed char>,
+        readBytesAsValue<unsigned char>,
+        readBytesAsValue<bool>,
+        readBytesAsValue<float>,
+        readBytesAsValue<double>,
+        readBytesAsValue<long double>,
+        readBytesAsValue<std::uintptr_t>
+    };
 }
 
-std::string readBytesAsValueForType(const std::vector<char> &byteArray,
-                                    const std::string &typeName,
+std::string readBytesAsValueForKind(const std::vector<char> &byteArray,
+                                    types::PrimitiveKind kind,
                                     size_t offsetInBits,
                                     size_t lenInBits) {
-    if (typeName == "utbot_byte") {
-        //we use different name to not trigger char processing
-        return readBytesAsValue<char>(byteArray, offsetInBits, lenInBits);
-    }
-    if (typeName == "short") {
-        return readBytesAsValue<short>(byteArray, offsetInBits, lenInBits);
-    }
-    if (typeName == "int") {
-        return readBytesAsValue<int>(byteArray, offsetInBits, lenInBits);
-    }
-    if (typeName == "long") {
-        return readBytesAsValue<long>(byteArray, offsetInBits, lenInBits);
-    }
-    if (typeName == "long long") {
-        return readBytesAsValue<long long>(byteArray, offsetInBits, lenInBits);
-    }
-    if (typeName == "unsigned short") {
-        return readBytesAsValue<unsigned short>(byteArray, offsetInBits, lenInBits);
-    }
-    if (typeName == "unsigned int") {
-        return readBytesAsValue<unsigned int>(byteArray, offsetInBits, lenInBits);
-    }
-    if (typeName == "unsigned long") {
-        return readBytesAsValue<unsigned long>(byteArray, offsetInBits, lenInBits);
-    }
-    if (typeName == "unsigned long long") {
-        return readBytesAsValue<unsigned long long>(byteArray, offsetInBits, lenInBits);
-    }
-    if (typeName == "char") {
-        return readBytesAsValue<char>(byteArray, offsetInBits, lenInBits);
-    }
-    if (typeName == "signed char") {
-        return readBytesAsValue<signed char>(byteArray, offsetInBits, lenInBits);
-    }
-    if (typeName == "unsigned char") {
-        return readBytesAsValue<unsigned char>(byteArray, offsetInBits, lenInBits);
-    }
-    if (typeName == "bool" || typeName == "_Bool") {
-        return readBytesAsValue<bool>(byteArray, offsetInBits, lenInBits);
-    }
-    if (typeName == "float") {
-        return readBytesAsValue<float>(byteArray, offsetInBits, lenInBits);
-    }
-    if (typeName == "double") {
-        return readBytesAsValue<double>(byteArray, offsetInBits, lenInBits);
-    }
-    if (typeName == "long double") {
-        return readBytesAsValue<long double>(byteArray, offsetInBits, lenInBits);
-    }
-    if (typeName == "std::uintptr_t" || typeName == "uintptr_t") {
-        return readBytesAsValue<std::uintptr_t>(byteArray, offsetInBits, lenInBits);
-    }
-    return "";
+    return bytesDecoders[static_cast<size_t>(kind)](byteArray, offsetInBits, lenInBits);
 }
 
 namespace { //Predicate utilities.
@@ -567,7 +665,6 @@ namespace { //Predicate utilities.
 
 void KTestObjectParser::parseKTest(const MethodKtests &batch,
                                    tests::Tests &tests,
-                                   const std::unordered_map<std::string, types::Type> &methodNameToReturnTypeMap,
                                    bool filterByLineFlag,
                                    const std::shared_ptr<LineInfo> &lineInfo) {
     LOG_SCOPE_FUNCTION(DEBUG);
@@ -576,7 +673,7 @@ void KTestObjectParser::parseKTest(const MethodKtests &batch,
         auto it = tests.methods.find<std::string, tests::Tests::MethodDescriptionToStringEqual>(
             testMethod.methodName);
         LOG_S(DEBUG) << "Parse klee for method: " << testMethod.methodName;
-        parseTestCases(testCases, filterByLineFlag, it.value(), methodNameToReturnTypeMap, lineInfo);
+        parseTestCases(testCases, filterByLineFlag, it.value(), lineInfo);
     }
 }
 
@@ -807,7 +904,6 @@ void KTestObjectParser::assignAllLazyPointers(
 void KTestObjectParser::parseTestCases(const UTBotKTestList &cases,
                                        bool filterByLineFlag,
                                        Tests::MethodDescription &methodDescription,
-                                       const std::unordered_map<std::string, types::Type>& methodNameToReturnTypeMap,
                                        const std::shared_ptr<LineInfo> &lineInfo) {
     /* Replace the return type for predicate scenario
      * to treat strings in specific way. This is done to retrieve
@@ -828,7 +924,6 @@ void KTestObjectParser::parseTestCases(const UTBotKTestList &cases,
             std::vector<Tests::TestCaseParamValue> paramValues;
 
             Tests::TestCaseDescription testCaseDescription = parseTestCaseParameters(case_, methodDescription,
-                                                                                     methodNameToReturnTypeMap,
                                                                                      traceStream);
             size_t size = case_.objects.size();
             bool isVoidOrFPointer = types::TypesHandler::skipTypeInReturn(methodDescription.returnType);
@@ -920,15 +1015,13 @@ KTestObjectParser::getKleeParamOrThrow(const std::vector<RawKleeParam> &rawKleeP
 Tests::TestCaseDescription
 KTestObjectParser::parseTestCaseParameters(const UTBotKTest &testCases,
                                            Tests::MethodDescription &methodDescription,
-                                           const std::unordered_map<std::string, types::Type>& methodNameToReturnTypeMap,
                                            std::stringstream &traceStream) {
-    return parseTestCaseParams(testCases, methodDescription, methodNameToReturnTypeMap, traceStream);
+    return parseTestCaseParams(testCases, methodDescription, traceStream);
 }
 
 Tests::TestCaseDescription KTestObjectParser::parseTestCaseParams(
     const UTBotKTest &ktest,
     const Tests::MethodDescription &methodDescription,
-    const std::unordered_map<std::string, types::Type> &methodNameToReturnTypeMap,
     const std::stringstream &traceStream) {
     std::vector<RawKleeParam> rawKleeParams;
     for (auto const &param : ktest.objects) {
@@ -984,7 +1077,7 @@ Tests::TestCaseDescription KTestObjectParser::parseTestCaseParams(
         processSymbolicFiles(testCaseDescription, rawKleeParams);
     }
 
-    processStubParamValue(methodDescription, testCaseDescription, methodNameToReturnTypeMap, rawKleeParams);
+    processStubParamValue(methodDescription, testCaseDescription, rawKleeParams);
     if (!types::TypesHandler::skipTypeInReturn(methodDescription.returnType)) {
         const auto kleeResParam =
                 getKleeParamOrThrow(rawKleeParams, KleeUtils::RESULT_VARIABLE_NAME);
@@ -1165,7 +1258,6 @@ void KTestObjectParser::processParamPostValue(Tests::TestCaseDescription &testCa
 void KTestObjectParser::processStubParamValue(
         const Tests::MethodDescription &methodDescription,
         Tests::TestCaseDescription &testCaseDescription,
-        const std::unordered_map<std::string, types::Type> &methodNameToReturnTypeMap,
         std::vector<RawKleeParam> &rawKleeParams) {
     for (const auto &kleeParam: rawKleeParams) {
         auto maybeFunctionInfo = methodDescription.stubsStorage->getFunctionInfoByKTestObjectName(kleeParam.paramName);
@@ -1203,7 +1295,7 @@ std::shared_ptr<AbstractValueView> KTestObjectParser::testParameterView(
         case TypeKind::OBJECT_POINTER:
             if (usage == types::PointerUsage::LAZY) {
                 std::string res =
-                    readBytesAsValueForType(rawData, PointerWidthType, 0, PointerWidthSizeInBits);
+                    readBytesAsValueForKind(rawData, PointerWidthKind, 0, PointerWidthSizeInBits);
                 return getLazyPointerView(objects, initReferences, param.varName, res, paramType,
                                           !kleeParam.pointers.empty());
             } else if (types::TypesHandler::isCStringType(paramType)) {
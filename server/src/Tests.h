@@ -2,6 +2,7 @@
 #define UNITTESTBOT_TESTS_H
 
 #include "Include.h"
+#include "LineIndex.h"
 #include "LineInfo.h"
 #include "NameDecorator.h"
 #include "types/Types.h"
@@ -15,8 +16,10 @@
 #include "Paths.h"
 #include "stubs/StubsStorage.h"
 
+#include <algorithm>
 #include <cassert>
 #include <climits>
+#include <cstring>
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
@@ -228,6 +231,46 @@ namespace tests {
             }
             return false;
         }
+
+    protected:
+        ArrayValueView() = default;
+    };
+
+    /**
+     * Representation of one-dimensional array of primitive values. Raw bytes of the array are stored
+     * instead of a view per element: elements are formatted when the value is printed and subviews
+     * are created only if they are requested.
+     */
+    struct PrimitiveArrayValueView : ArrayValueView {
+        PrimitiveArrayValueView(std::vector<char> bytes, const types::Type &elementType, size_t elementLenInBits);
+
+        [[nodiscard]] std::string getEntryValue(printer::TestsPrinter *printer) const override;
+
+        /**
+         * @param trimTrailingZeros if true, trailing zero elements are omitted, which is valid only
+         * for arrays declared with explicit size, as aggregate initialization zero-fills them.
+         * Character arrays are never trimmed, since they may be declared without size.
+         */
+        [[nodiscard]] std::string getEntryValue(printer::TestsPrinter *printer, bool trimTrailingZeros) const;
+
+        [[nodiscard]] const std::vector<std::shared_ptr<AbstractValueView>> &getSubViews() const override;
+
+        bool containsFPSpecialValue() override;
+
+    private:
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] std::string getElementValue(size_t index) const;
+
+        [[nodiscard]] bool isZeroElement(size_t index) const;
+
+        std::vector<char> bytes;
+        size_t elementLenInBits;
+        types::PrimitiveKind readKind;
+        types::PrimitiveKind valueKind;
+        bool isBool;
+        bool isCharacter;
+        mutable std::vector<std::shared_ptr<AbstractValueView>> elementViews{};
     };
 
     /**
@@ -621,6 +664,7 @@ namespace tests {
         std::vector<Include> headersBeforeMainHeader;
         std::optional<Include> mainHeader;
         MethodsMap methods; // method's name -> description
+        LineIndex lineIndex; // filled only for line requests
         std::string code;       // contains final code of test file
         std::string headerCode; // contains code of header
         std::vector<std::string> commentBlocks{};
@@ -668,7 +712,6 @@ namespace tests {
          */
         void parseKTest(const MethodKtests &batch,
                         tests::Tests &tests,
-                        const std::unordered_map<std::string, types::Type> &methodNameToReturnTypeMap,
                         bool filterByLineFlag,
                         const std::shared_ptr<LineInfo> &lineInfo);
     private:
@@ -710,7 +753,6 @@ namespace tests {
         void parseTestCases(const UTBotKTestList &cases,
                             bool filterByLineFlag,
                             Tests::MethodDescription &methodDescription,
-                            const std::unordered_map<std::string, types::Type> &methodNameToReturnTypeMap,
                             const std::shared_ptr<LineInfo> &lineInfo);
         /**
          * Parses parameters that are stored in given objects. Then parameters
@@ -724,7 +766,6 @@ namespace tests {
         Tests::TestCaseDescription
         parseTestCaseParameters(const UTBotKTest &testCases,
                                 Tests::MethodDescription &methodDescription,
-                                const std::unordered_map<std::string, types::Type>& methodNameToReturnTypeMap,
                                 std::stringstream &traceStream);
 
         std::shared_ptr<AbstractValueView>
@@ -786,12 +827,9 @@ namespace tests {
                                                           size_t offsetInBits,
                                                           size_t lenInBits);
 
-        std::string primitiveCharView(const types::Type &type, std::string value);
-        static std::string primitiveBoolView(const std::string &value);
-
         constexpr static const char *const KLEE_PATH_FLAG = "kleePathFlag";
 
-        const std::string PointerWidthType = "std::uintptr_t";
+        const types::PrimitiveKind PointerWidthKind = types::PrimitiveKind::UINTPTR;
         const size_t PointerWidthSizeInBits = SizeUtils::bytesToBits(sizeof(std::uintptr_t));
 
         constexpr static const char *const KLEE_PATH_FLAG_SYMBOLIC = "kleePathFlagSymbolic";
@@ -802,7 +840,6 @@ namespace tests {
         Tests::TestCaseDescription
         parseTestCaseParams(const UTBotKTest &ktest,
                             const Tests::MethodDescription &methodDescription,
-                            const std::unordered_map<std::string, types::Type> &methodNameToReturnTypeMap,
                             const std::stringstream &traceStream);
 
         void processGlobalParamPreValue(Tests::TestCaseDescription &testCaseDescription,
@@ -829,7 +866,6 @@ namespace tests {
 
         void processStubParamValue(const Tests::MethodDescription &methodDescription,
                                    Tests::TestCaseDescription &testCaseDescription,
-                                   const std::unordered_map<std::string, types::Type> &methodNameToReturnTypeMap,
                                    std::vector<RawKleeParam> &rawKleeParams);
 
         static void addToOrder(const std::vector<UTBotKTestObject> &objects,
@@ -951,15 +987,13 @@ namespace tests {
                 }
             }
         } else {
-            for (size_t j = 0; j < len / CHAR_BIT; j++) {
-                bytes[j] = byteArray[offset / CHAR_BIT + j];
-            }
+            std::memcpy(bytes, byteArray.data() + offset / CHAR_BIT, std::min(len / CHAR_BIT, sizeof(T)));
         }
         if constexpr(std::is_signed_v<T>) {
             sext(bytes, sizeof(T), len - 1);
         }
-        T *pTypeValue = (T *) bytes;
-        T pValue = *pTypeValue;
+        T pValue;
+        std::memcpy(&pValue, bytes, sizeof(T));
         return primitiveValueToString<T>(pValue);
     }
 
@@ -976,5 +1010,19 @@ namespace tests {
                                         const std::string &typeName,
                                         size_t offsetInBits,
                                         size_t lenInBits);
+
+    /**
+     * Same as readBytesAsValueForType, but takes type that is already resolved
+     * to primitive kind, so the decoder is picked by table lookup.
+     * @param kind - primitive kind of type
+     * @param byteArray - array of bytes
+     * @param offsetInBits - initial position in bits
+     * @param lenInBits - number of bits to read
+     * @return string representation of value, empty string if kind is PrimitiveKind::NONE.
+     */
+    std::string readBytesAsValueForKind(const std::vector<char> &byteArray,
+                                        types::PrimitiveKind kind,
+                                        size_t offsetInBits,
+                                        size_t lenInBits);
 } // tests
 #endif // UNITTESTBOT_TESTS_H
@@ -0,0 +1,234 @@
+#include "BitcodeCache.h"
+
+#include "Paths.h"
+#include "commands/Commands.h"
+#include "utils/CollectionUtils.h"
+#include "utils/MakefileUtils.h"
+#include "utils/ParallelUtils.h"
+#include "utils/ResourceScheduler.h"
+
+#include "loguru.h"
+
+#include <clang/Basic/Version.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Support/SHA1.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <tuple>
+#include <unistd.h>
+#include <unordered_set>
+
+namespace {
+    /// options whose values only name files written by the command
+    const std::unordered_set<std::string> OUTPUT_OPTIONS = { "-o", "-MF", "-MT", "-MQ" };
+    const std::unordered_set<std::string> OUTPUT_FLAGS = { "-MD", "-MMD" };
+
+    void update(llvm::SHA1 &hasher, const std::string &data) {
+        hasher.update(data);
+        // separator, so that neighbouring strings are not mixed up
+        hasher.update(llvm::StringRef("", 1));
+    }
+}
+
+const std::string BitcodeCache::USED_MARKER_EXTENSION = ".used";
+const std::string BitcodeCache::TEMPORARY_EXTENSION = ".tmp";
+
+BitcodeCache &BitcodeCache::getInstance() {
+    // keys are computed by the in-process preprocessor, which is not run unless it is enabled
+    static BitcodeCache instance(Paths::getBitcodeCacheDir(),
+                                 Commands::compileInProcess ? Commands::bitcodeCacheSize * 1024 * 1024 : 0);
+    return instance;
+}
+
+BitcodeCache::BitcodeCache(fs::path storeDir, uint64_t capacity)
+    : storeDir(std::move(storeDir)), capacity(capacity) {
+}
+
+std::vector<BitcodeCache::Entry> BitcodeCache::restore(const std::vector<utbot::CompileCommand> &commands,
+                                                       InProcessCompiler &compiler) {
+    struct Lookup {
+        Entry entry;
+        bool found = false;
+    };
+    std::vector<Lookup> lookups;
+    lookups.reserve(commands.size());
+    for (const auto &command : commands) {
+        lookups.push_back({ { command, std::nullopt } });
+    }
+    if (capacity != 0) {
+        auto tokens = ResourceScheduler::getInstance().acquire(ResourceScheduler::Kind::COMPILER_JOB,
+                                                               MakefileUtils::getJobsNumber());
+        ParallelUtils::forEach(lookups, tokens.count(), [&](Lookup &lookup) {
+            lookup.entry.key = getKey(lookup.entry.command, compiler);
+            lookup.found = lookup.entry.key.has_value() &&
+                           restore(lookup.entry.key.value(), lookup.entry.command.getOutput());
+        });
+    }
+
+    std::vector<Entry> misses;
+    for (auto &lookup : lookups) {
+        if (!lookup.found) {
+            misses.push_back(std::move(lookup.entry));
+        }
+    }
+    LOG_S(DEBUG) << "Bitcode files found in store: " << commands.size() - misses.size() << " of "
+                 << commands.size();
+    return misses;
+}
+
+void BitcodeCache::store(const std::vector<Entry> &entries) {
+    if (capacity == 0) {
+        return;
+    }
+    bool stored = false;
+    for (const auto &entry : entries) {
+        if (entry.key.has_value()) {
+            store(entry.key.value(), entry.command.getOutput());
+            stored = true;
+        }
+    }
+    if (stored) {
+        trim();
+    }
+}
+
+std::optional<std::string> BitcodeCache::getKey(const utbot::CompileCommand &command,
+                                                InProcessCompiler &compiler) const {
+    if (!InProcessCompiler::isSupported(command)) {
+        return std::nullopt;
+    }
+    std::optional<std::string> preprocessed = compiler.preprocess(command);
+    if (!preprocessed.has_value()) {
+        return std::nullopt;
+    }
+    llvm::SHA1 hasher;
+    update(hasher, clang::getClangFullVersion());
+    update(hasher, command.getDirectory().string());
+    const auto &commandLine = command.getCommandLine();
+    for (auto it = commandLine.begin(); it != commandLine.end(); ++it) {
+        if (CollectionUtils::contains(OUTPUT_OPTIONS, *it)) {
+            if (std::next(it) != commandLine.end()) {
+                ++it;
+            }
+            continue;
+        }
+        if (!CollectionUtils::contains(OUTPUT_FLAGS, *it)) {
+            update(hasher, *it);
+        }
+    }
+    update(hasher, preprocessed.value());
+    return llvm::toHex(hasher.final(), true);
+}
+
+fs::path BitcodeCache::getStorePath(const std::string &key) const {
+    return storeDir / key.substr(0, 2) / (key.substr(2) + ".bc");
+}
+
+bool BitcodeCache::restore(const std::string &key, const fs::path &output) const {
+    std::filesystem::path storePath = getStorePath(key).string();
+    std::filesystem::path outputPath = output.string();
+    std::error_code errorCode;
+    if (!std::filesystem::exists(storePath, errorCode)) {
+        return false;
+    }
+    std::filesystem::create_directories(outputPath.parent_path(), errorCode);
+    std::filesystem::remove(outputPath, errorCode);
+    std::filesystem::create_hard_link(storePath, outputPath, errorCode);
+    if (errorCode) {
+        // the store may be on another file system
+        if (!std::filesystem::copy_file(storePath, outputPath, errorCode)) {
+            return false;
+        }
+    }
+    // time of the last use is what old files are removed by. It is kept by a marker, because
+    // the stored file shares its inode and its modification time with the linked outputs,
+    // which make compares with sources
+    std::filesystem::path markerPath = storePath.string() + USED_MARKER_EXTENSION;
+    if (!std::filesystem::exists(markerPath, errorCode)) {
+        std::ofstream marker(markerPath);
+    }
+    std::filesystem::last_write_time(markerPath, std::filesystem::file_time_type::clock::now(), errorCode);
+    return true;
+}
+
+void BitcodeCache::store(const std::string &key, const fs::path &output) const {
+    std::filesystem::path storePath = getStorePath(key).string();
+    std::error_code errorCode;
+    if (std::filesystem::exists(storePath, errorCode)) {
+        return;
+    }
+    std::filesystem::create_directories(storePath.parent_path(), errorCode);
+    // the file is renamed into place, so other servers never link a partially written file
+    std::filesystem::path temporaryPath =
+        storePath.string() + "." + std::to_string(getpid()) + "." +
+        std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + TEMPORARY_EXTENSION;
+    if (!std::filesystem::copy_file(output.string(), temporaryPath,
+                                    std::filesystem::copy_options::overwrite_existing, errorCode)) {
+        LOG_S(WARNING) << "Bitcode file is not stored: " << output << ": " << errorCode.message();
+        return;
+    }
+    // stored files are linked into build directories, so they are protected from writing through the links
+    std::filesystem::permissions(temporaryPath,
+                                 std::filesystem::perms::owner_read | std::filesystem::perms::group_read |
+                                     std::filesystem::perms::others_read,
+                                 errorCode);
+    std::filesystem::rename(temporaryPath, storePath, errorCode);
+    if (errorCode) {
+        LOG_S(WARNING) << "Bitcode file is not stored: " << output << ": " << errorCode.message();
+        std::filesystem::remove(temporaryPath, errorCode);
+    }
+}
+
+void BitcodeCache::trim() {
+    std::lock_guard<std::mutex> lock(trimMutex);
+    std::vector<std::tuple<std::filesystem::file_time_type, uintmax_t, std::filesystem::path>> files;
+    uint64_t totalSize = 0;
+    std::error_code errorCode;
+    for (std::filesystem::recursive_directory_iterator it(storeDir.string(), errorCode), end;
+         !errorCode && it != end; it.increment(errorCode)) {
+        // markers are removed together with their files, temporary files are being written
+        // by other servers and are renamed into place by them
+        std::string extension = it->path().extension().string();
+        if (!it->is_regular_file(errorCode) || extension == USED_MARKER_EXTENSION ||
+            extension == TEMPORARY_EXTENSION) {
+            errorCode.clear();
+            continue;
+        }
+        uintmax_t size = it->file_size(errorCode);
+        auto time = it->last_write_time(errorCode);
+        if (errorCode) {
+            errorCode.clear();
+            continue;
+        }
+        std::error_code markerErrorCode;
+        auto usedTime = std::filesystem::last_write_time(it->path().string() + USED_MARKER_EXTENSION,
+                                                         markerErrorCode);
+        if (!markerErrorCode) {
+            time = std::max(time, usedTime);
+        }
+        files.emplace_back(time, size, it->path());
+        totalSize += size;
+    }
+    if (totalSize <= capacity) {
+        return;
+    }
+    // a tenth of the store is freed at once, so that it is not trimmed by every request
+    uint64_t targetSize = capacity - capacity / 10;
+    std::sort(files.begin(), files.end());
+    size_t removed = 0;
+    for (const auto &[time, size, path] : files) {
+        if (totalSize <= targetSize) {
+            break;
+        }
+        if (std::filesystem::remove(path, errorCode)) {
+            std::filesystem::remove(path.string() + USED_MARKER_EXTENSION, errorCode);
+            totalSize -= size;
+            ++removed;
+        }
+    }
+    LOG_S(DEBUG) << "Bitcode files removed from store: " << removed;
+}
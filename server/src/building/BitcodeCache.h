@@ -0,0 +1,76 @@
+#ifndef UNITTESTBOT_BITCODECACHE_H
+#define UNITTESTBOT_BITCODECACHE_H
+
+#include "building/CompileCommand.h"
+#include "building/InProcessCompiler.h"
+
+#include "utils/path/FileSystemPath.h"
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * Store of bitcode compiled for KLEE shared by all projects of the server, like ccache.
+ * A bitcode file is addressed by hash of the preprocessed source and the compile command
+ * without its output, so a source compiled once is not compiled again after its
+ * build directory is removed, for another checkout at the same path or for another target.
+ * Found files are hard linked into the build directory. Paths stay in the key,
+ * as debug information of bitcode which KLEE reports locations by contains them.
+ * The least recently used files are removed when the store exceeds its size.
+ * The store is used only with --compile-in-process, as keys are computed by the
+ * in-process preprocessor.
+ */
+class BitcodeCache {
+public:
+    struct Entry {
+        utbot::CompileCommand command;
+        /// std::nullopt if output of the command can't be stored
+        std::optional<std::string> key;
+    };
+
+    static BitcodeCache &getInstance();
+
+    /**
+     * @param capacity size of the store in bytes, 0 disables the store
+     */
+    BitcodeCache(fs::path storeDir, uint64_t capacity);
+
+    BitcodeCache(const BitcodeCache &) = delete;
+    BitcodeCache &operator=(const BitcodeCache &) = delete;
+
+    /**
+     * Preprocesses sources of the commands in parallel and links outputs found in the store.
+     * Commands which are not supported by the in-process compiler are never found.
+     * @return commands whose outputs are not found and should be compiled
+     */
+    std::vector<Entry> restore(const std::vector<utbot::CompileCommand> &commands, InProcessCompiler &compiler);
+
+    /**
+     * Copies outputs of compiled commands to the store and removes old files if it is full.
+     */
+    void store(const std::vector<Entry> &entries);
+
+private:
+    /// suffix of the empty file whose modification time is the last use of the stored file
+    static const std::string USED_MARKER_EXTENSION;
+    static const std::string TEMPORARY_EXTENSION;
+
+    const fs::path storeDir;
+    const uint64_t capacity;
+    std::mutex trimMutex;
+
+    std::optional<std::string> getKey(const utbot::CompileCommand &command, InProcessCompiler &compiler) const;
+
+    fs::path getStorePath(const std::string &key) const;
+
+    bool restore(const std::string &key, const fs::path &output) const;
+
+    void store(const std::string &key, const fs::path &output) const;
+
+    void trim();
+};
+
+
+#endif // UNITTESTBOT_BITCODECACHE_H
@@ -0,0 +1,252 @@
+#include "InProcessCompiler.h"
+
+#include "Paths.h"
+#include "environment/EnvironmentPaths.h"
+#include "utils/MakefileUtils.h"
+#include "utils/ParallelUtils.h"
+#include "utils/ResourceScheduler.h"
+
+#include "loguru.h"
+
+#include <clang/Basic/FileManager.h>
+#include <clang/CodeGen/CodeGenAction.h>
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Frontend/TextDiagnosticPrinter.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/VirtualFileSystem.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+class InProcessCompiler::HeaderCache {
+public:
+    std::mutex mutex;
+    std::unordered_map<std::string, llvm::ErrorOr<llvm::vfs::Status>> statuses;
+    std::unordered_map<std::string, std::shared_ptr<llvm::MemoryBuffer>> buffers;
+};
+
+namespace {
+    /**
+     * Sources are not cached, as klee files are rewritten between compilations of a request.
+     */
+    bool isCached(const std::string &path) {
+        return !Paths::isSourceFile(path);
+    }
+
+    class CachedFile : public llvm::vfs::File {
+    public:
+        CachedFile(llvm::vfs::Status fileStatus, std::shared_ptr<llvm::MemoryBuffer> buffer)
+            : fileStatus(std::move(fileStatus)), buffer(std::move(buffer)) {
+        }
+
+        llvm::ErrorOr<llvm::vfs::Status> status() override {
+            return fileStatus;
+        }
+
+        llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> getBuffer(const llvm::Twine &name,
+                                                                     int64_t fileSize,
+                                                                     bool requiresNullTerminator,
+                                                                     bool isVolatile) override {
+            return llvm::MemoryBuffer::getMemBuffer(buffer->getBuffer(), name.str(), requiresNullTerminator);
+        }
+
+        std::error_code close() override {
+            return {};
+        }
+
+    private:
+        llvm::vfs::Status fileStatus;
+        std::shared_ptr<llvm::MemoryBuffer> buffer;
+    };
+
+    /**
+     * Working directory is set per compilation, so every compilation has its own file system
+     * and only the cache behind it is shared.
+     */
+    class CachingFileSystem : public llvm::vfs::ProxyFileSystem {
+    public:
+        CachingFileSystem(llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem,
+                          std::shared_ptr<InProcessCompiler::HeaderCache> cache)
+            : ProxyFileSystem(std::move(fileSystem)), cache(std::move(cache)) {
+        }
+
+        llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine &path) override {
+            std::optional<std::string> key = getKey(path);
+            if (!key.has_value()) {
+                return ProxyFileSystem::status(path);
+            }
+            {
+                std::lock_guard<std::mutex> lock(cache->mutex);
+                auto it = cache->statuses.find(key.value());
+                if (it != cache->statuses.end()) {
+                    if (!it->second) {
+                        return it->second.getError();
+                    }
+                    return llvm::vfs::Status::copyWithNewName(it->second.get(), path.str());
+                }
+            }
+            auto result = ProxyFileSystem::status(path);
+            if (result || result.getError() == std::errc::no_such_file_or_directory) {
+                std::lock_guard<std::mutex> lock(cache->mutex);
+                cache->statuses.emplace(key.value(), result);
+            }
+            return result;
+        }
+
+        llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> openFileForRead(const llvm::Twine &path) override {
+            std::optional<std::string> key = getKey(path);
+            if (!key.has_value()) {
+                return ProxyFileSystem::openFileForRead(path);
+            }
+            {
+                std::lock_guard<std::mutex> lock(cache->mutex);
+                auto buffer = cache->buffers.find(key.value());
+                auto fileStatus = cache->statuses.find(key.value());
+                if (buffer != cache->buffers.end() && fileStatus != cache->statuses.end() && fileStatus->second) {
+                    return std::make_unique<CachedFile>(
+                        llvm::vfs::Status::copyWithNewName(fileStatus->second.get(), path.str()), buffer->second);
+                }
+            }
+            auto file = ProxyFileSystem::openFileForRead(path);
+            if (!file) {
+                return file;
+            }
+            auto fileStatus = (*file)->status();
+            if (!fileStatus) {
+                return fileStatus.getError();
+            }
+            auto buffer = (*file)->getBuffer(path, fileStatus->getSize(), true, false);
+            if (!buffer) {
+                return buffer.getError();
+            }
+            std::shared_ptr<llvm::MemoryBuffer> sharedBuffer;
+            {
+                // buffers given to compilations don't own the data, so a buffer in the cache is never
+                // replaced: a parallel compilation which has read the same file uses the first buffer
+                std::lock_guard<std::mutex> lock(cache->mutex);
+                cache->statuses.emplace(key.value(), fileStatus);
+                sharedBuffer = cache->buffers.emplace(key.value(), std::move(buffer.get())).first->second;
+            }
+            return std::make_unique<CachedFile>(fileStatus.get(), sharedBuffer);
+        }
+
+    private:
+        std::shared_ptr<InProcessCompiler::HeaderCache> cache;
+
+        std::optional<std::string> getKey(const llvm::Twine &path) const {
+            llvm::SmallString<256> absolutePath;
+            path.toVector(absolutePath);
+            if (makeAbsolute(absolutePath)) {
+                return std::nullopt;
+            }
+            // only "." components are removed, ".." may follow a symbolic link
+            llvm::sys::path::remove_dots(absolutePath, false);
+            std::string key = absolutePath.str().str();
+            if (!isCached(key)) {
+                return std::nullopt;
+            }
+            return key;
+        }
+    };
+}
+
+InProcessCompiler::InProcessCompiler(fs::path logPath)
+    : headerCache(std::make_shared<HeaderCache>()), logPath(std::move(logPath)) {
+    static std::once_flag targetsInitialized;
+    std::call_once(targetsInitialized, []() {
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmParser();
+    });
+}
+
+bool InProcessCompiler::isSupported(const utbot::CompileCommand &command) {
+    fs::path buildTool = command.getBuildTool();
+    return buildTool == Paths::getUTBotClang() || buildTool == Paths::getUTBotClangPP();
+}
+
+ExecUtils::ExecutionResult InProcessCompiler::compile(const utbot::CompileCommand &command) {
+    LOG_S(MAX) << "Compiling in process: " << command.toString();
+    fs::create_directories(command.getOutput().parent_path());
+
+    std::string diagnostics;
+    llvm::raw_string_ostream diagnosticsStream(diagnostics);
+    clang::TextDiagnosticPrinter diagnosticPrinter(diagnosticsStream, new clang::DiagnosticOptions());
+    bool success = run(command, std::make_unique<clang::EmitBCAction>(), &diagnosticPrinter);
+    diagnosticsStream.flush();
+
+    if (!success || !diagnostics.empty()) {
+        std::lock_guard<std::mutex> lock(logMutex);
+        std::ofstream log(logPath, std::ios::app);
+        log << command.toString() << '\n' << diagnostics;
+    }
+    return { diagnostics, success ? 0 : 1, logPath };
+}
+
+std::optional<std::string> InProcessCompiler::preprocess(const utbot::CompileCommand &command) {
+    utbot::CompileCommand preprocessCommand = command;
+    preprocessCommand.addFlagToBegin("-E");
+    fs::path preprocessedPath = command.getOutput().string() + ".i";
+    preprocessCommand.setOutput(preprocessedPath);
+    fs::create_directories(preprocessedPath.parent_path());
+
+    // diagnostics are reported by the compilation itself
+    clang::IgnoringDiagConsumer diagnosticConsumer;
+    bool success = run(preprocessCommand, std::make_unique<clang::PrintPreprocessedAction>(), &diagnosticConsumer);
+    std::optional<std::string> preprocessed;
+    if (success) {
+        std::ifstream stream(preprocessedPath.string());
+        std::stringstream buffer;
+        buffer << stream.rdbuf();
+        preprocessed = buffer.str();
+    }
+    std::error_code errorCode;
+    std::filesystem::remove(preprocessedPath.string(), errorCode);
+    return preprocessed;
+}
+
+bool InProcessCompiler::run(const utbot::CompileCommand &command,
+                            std::unique_ptr<clang::FrontendAction> action,
+                            clang::DiagnosticConsumer *diagnosticConsumer) {
+    const auto &commandLine = command.getCommandLine();
+    std::vector<std::string> arguments(commandLine.begin(), commandLine.end());
+
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem(
+        new CachingFileSystem(llvm::vfs::createPhysicalFileSystem().release(), headerCache));
+    fileSystem->setCurrentWorkingDirectory(command.getDirectory().string());
+    clang::FileSystemOptions fileSystemOptions;
+    fileSystemOptions.WorkingDir = command.getDirectory().string();
+    llvm::IntrusiveRefCntPtr<clang::FileManager> fileManager(
+        new clang::FileManager(fileSystemOptions, fileSystem));
+
+    clang::tooling::ToolInvocation invocation(std::move(arguments), std::move(action), fileManager.get());
+    invocation.setDiagnosticConsumer(diagnosticConsumer);
+    return invocation.run();
+}
+
+std::optional<InProcessCompiler::Failure> InProcessCompiler::compile(std::vector<utbot::CompileCommand> commands) {
+    auto tokens = ResourceScheduler::getInstance().acquire(ResourceScheduler::Kind::COMPILER_JOB,
+                                                           MakefileUtils::getJobsNumber());
+    std::mutex failureMutex;
+    std::optional<Failure> failure;
+    std::atomic_bool failed = false;
+    ParallelUtils::forEach(commands, tokens.count(), [&](const utbot::CompileCommand &command) {
+        if (failed) {
+            return;
+        }
+        auto result = compile(command);
+        if (result.status != 0) {
+            std::lock_guard<std::mutex> lock(failureMutex);
+            if (!failure.has_value()) {
+                failure = Failure{ command, std::move(result) };
+            }
+            failed = true;
+        }
+    });
+    return failure;
+}
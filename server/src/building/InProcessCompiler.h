@@ -0,0 +1,74 @@
+#ifndef UNITTESTBOT_INPROCESSCOMPILER_H
+#define UNITTESTBOT_INPROCESSCOMPILER_H
+
+#include "building/CompileCommand.h"
+#include "utils/ExecutionResult.h"
+
+#include "utils/path/FileSystemPath.h"
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace clang {
+    class DiagnosticConsumer;
+    class FrontendAction;
+}
+
+/**
+ * Compiles sources to LLVM bitcode with clang libraries linked into the server instead of
+ * running make and a compiler process for every source. Several sources are compiled at once.
+ * Stat results and contents of headers are shared by all compilations of an instance, so
+ * headers included by many sources are looked up and read from disk only once. Therefore
+ * an instance should not outlive a request, headers generated by the request are not reread.
+ */
+class InProcessCompiler {
+public:
+    /// shared by file systems of compilations
+    class HeaderCache;
+
+    struct Failure {
+        utbot::CompileCommand command;
+        ExecUtils::ExecutionResult result;
+    };
+
+    /**
+     * @param logPath diagnostics of all compilations are appended to this file
+     */
+    explicit InProcessCompiler(fs::path logPath);
+
+    /**
+     * @return true if command is run by UTBot clang, so the same compiler is used in process
+     */
+    static bool isSupported(const utbot::CompileCommand &command);
+
+    /**
+     * @return result with diagnostics in output and path to the log in outPath
+     */
+    ExecUtils::ExecutionResult compile(const utbot::CompileCommand &command);
+
+    /**
+     * Compiles commands in parallel using compiler job tokens of the request.
+     * @return the first failed compilation, remaining commands are skipped after it
+     */
+    std::optional<Failure> compile(std::vector<utbot::CompileCommand> commands);
+
+    /**
+     * Runs only the preprocessor of the command, the output of the command is not created.
+     * @return preprocessed source or std::nullopt if preprocessing has failed
+     */
+    std::optional<std::string> preprocess(const utbot::CompileCommand &command);
+
+private:
+    std::shared_ptr<HeaderCache> headerCache;
+    fs::path logPath;
+    std::mutex logMutex;
+
+    bool run(const utbot::CompileCommand &command,
+             std::unique_ptr<clang::FrontendAction> action,
+             clang::DiagnosticConsumer *diagnosticConsumer);
+};
+
+
+#endif // UNITTESTBOT_INPROCESSCOMPILER_H
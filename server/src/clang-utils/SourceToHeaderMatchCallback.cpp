@@ -327,7 +327,7 @@ void SourceToHeaderMatchCallback::generateUnnamedTypeDecls(const clang::RecordDe
     clang::QualType canonicalType = context.getTypeDeclType(decl).getCanonicalType();
     uint64_t id = types::Type::getIdFromCanonicalType(canonicalType);
     if (typesHandler.isStructLike(id)) {
-        types::StructInfo info = typesHandler.getStructInfo(id);
+        const types::StructInfo &info = typesHandler.getStructInfo(id);
         generateUnnamedTypeDeclsForFields(info);
     }
 }
@@ -338,12 +338,12 @@ void SourceToHeaderMatchCallback::generateUnnamedTypeDeclsForFields(const types:
             continue;
         }
         if (typesHandler.isStructLike(field.type)) {
-            types::StructInfo fieldInfo = typesHandler.getStructInfo(field.type);
+            const types::StructInfo &fieldInfo = typesHandler.getStructInfo(field.type);
             printUnnamedTypeDecl(info.name, field.name, fieldInfo.name);
             generateUnnamedTypeDeclsForFields(fieldInfo);
         }
         if (typesHandler.isEnum(field.type)) {
-            types::EnumInfo enumInfo = typesHandler.getEnumInfo(field.type);
+            const types::EnumInfo &enumInfo = typesHandler.getEnumInfo(field.type);
             printUnnamedTypeDecl(info.name, field.name, enumInfo.name);
         }
     }
@@ -117,17 +117,12 @@ std::string SourceToHeaderRewriter::generateStubHeader(const tests::Tests &tests
     LOG_IF_S(WARNING, Paths::isCXXFile(sourceFilePath))
     << "Stubs feature for C++ sources has not been tested thoroughly; some problems may occur";
     auto sourceDeclarations = generateSourceDeclarations(sourceFilePath, true, false);
-    long long creationTime = TimeUtils::convertFileToSystemClock(fs::file_time_type::clock::now())
-            .time_since_epoch().count();
     printer::StubsPrinter stubsPrinter(Paths::getSourceLanguage(sourceFilePath));
     stubsPrinter.ss << StringUtils::stringFormat(
-            "//%s\n"
-            "//Please, do not change the line above\n"
             "%s\n"
             "#define _Alignas(x)\n"
             "%s\n",
-            std::to_string(creationTime), Copyright::GENERATED_C_CPP_FILE_HEADER,
-            sourceDeclarations.externalDeclarations);
+            Copyright::GENERATED_C_CPP_FILE_HEADER, sourceDeclarations.externalDeclarations);
     for (const auto &[methodName, methodDescription]: tests.methods) {
         std::string stubSymbolicVarName = StubsUtils::getStubSymbolicVarName(methodName, "");
         if (!types::TypesHandler::omitMakeSymbolic(methodDescription.returnType)) {
@@ -152,21 +147,3 @@ std::string SourceToHeaderRewriter::generateWrapper(const fs::path &sourceFilePa
     wrapperStream.flush();
     return result;
 }
-
-void SourceToHeaderRewriter::generateTestHeaders(tests::TestsMap &tests,
-                                                 const StubGen &stubGen,
-                                                 const CollectionUtils::MapFileTo<fs::path> &selectedTargets,
-                                                 ProgressWriter const *progressWriter) {
-    std::string logMessage = "Generating headers for tests";
-    LOG_S(DEBUG) << logMessage;
-    ExecUtils::doWorkWithProgress(tests, progressWriter, logMessage,
-                                  [this, &stubGen, &selectedTargets](auto &it) {
-        fs::path const &sourceFilePath = it.first;
-        auto &test = const_cast<tests::Tests &>(it.second);
-        auto iterator = selectedTargets.find(sourceFilePath);
-        bool externFromStub =
-            iterator != selectedTargets.end() &&
-            CollectionUtils::contains(stubGen.getStubSources(iterator->second), sourceFilePath);
-        test.headerCode = generateTestHeader(sourceFilePath, test, externFromStub);
-    });
-}
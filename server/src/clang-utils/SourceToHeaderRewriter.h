@@ -62,11 +62,6 @@ public:
     std::string generateStubHeader(const tests::Tests &tests, const fs::path &sourceFilePath);
 
     std::string generateWrapper(const fs::path &sourceFilePath);
-
-    void generateTestHeaders(tests::TestsMap &tests,
-                             const StubGen &stubGen,
-                             const CollectionUtils::MapFileTo<fs::path> &selectedTargets,
-                             ProgressWriter const *progressWriter);
 };
 
 
@@ -0,0 +1,99 @@
+#include "TestHeadersGenerator.h"
+
+#include "RequestEnvironment.h"
+#include "SourceToHeaderRewriter.h"
+#include "exceptions/CancellationException.h"
+#include "utils/ParallelUtils.h"
+#include "utils/ResourceScheduler.h"
+
+#include "loguru.h"
+
+TestHeadersGenerator::TestHeadersGenerator(utbot::ProjectContext projectContext,
+                                           std::shared_ptr<CompilationDatabase> compilationDatabase,
+                                           std::shared_ptr<Fetcher::FileToStringSet> structsToDeclare,
+                                           fs::path serverBuildDir,
+                                           const types::TypesHandler &typesHandler,
+                                           const tests::TestsMap &tests,
+                                           const StubGen &stubGen,
+                                           const CollectionUtils::MapFileTo<fs::path> &selectedTargets)
+    : TestHeadersGenerator(
+          tests, getExternFromStub(tests, stubGen, selectedTargets),
+          [projectContext = std::move(projectContext), compilationDatabase = std::move(compilationDatabase),
+           structsToDeclare = std::move(structsToDeclare), serverBuildDir = std::move(serverBuildDir),
+           &typesHandler]() -> Generate {
+              // rewriter keeps state of the current file, so it is not shared between workers
+              auto rewriter = std::make_shared<SourceToHeaderRewriter>(projectContext, compilationDatabase,
+                                                                       structsToDeclare, serverBuildDir,
+                                                                       typesHandler);
+              return [rewriter](const fs::path &sourceFilePath, const tests::Tests &tests, bool externFromStub) {
+                  return rewriter->generateTestHeader(sourceFilePath, tests, externFromStub);
+              };
+          },
+          ParallelUtils::getWorkersNumber()) {
+}
+
+TestHeadersGenerator::TestHeadersGenerator(const tests::TestsMap &tests,
+                                           const CollectionUtils::FileSet &externFromStub,
+                                           GenerateFactory generateFactory,
+                                           size_t workersNumber)
+    : generateFactory(std::move(generateFactory)) {
+    LOG_S(DEBUG) << "Generating headers for tests in background";
+    headers.reserve(tests.size());
+    for (const auto &[sourceFilePath, test] : tests) {
+        headers.push_back({ sourceFilePath, &test, CollectionUtils::contains(externFromStub, sourceFilePath), {} });
+        codes.emplace(sourceFilePath, headers.back().code.get_future().share());
+    }
+    workersNumber = std::min(workersNumber, headers.size());
+    for (size_t i = 0; i < workersNumber; ++i) {
+        workers.push_back(std::async(std::launch::async, &TestHeadersGenerator::work, this,
+                                     RequestEnvironment::clientId, RequestEnvironment::serverContext));
+    }
+}
+
+CollectionUtils::FileSet
+TestHeadersGenerator::getExternFromStub(const tests::TestsMap &tests,
+                                        const StubGen &stubGen,
+                                        const CollectionUtils::MapFileTo<fs::path> &selectedTargets) {
+    CollectionUtils::FileSet externFromStub;
+    for (const auto &[sourceFilePath, test] : tests) {
+        auto iterator = selectedTargets.find(sourceFilePath);
+        if (iterator != selectedTargets.end() &&
+            CollectionUtils::contains(stubGen.getStubSources(iterator->second), sourceFilePath)) {
+            externFromStub.insert(sourceFilePath);
+        }
+    }
+    return externFromStub;
+}
+
+TestHeadersGenerator::~TestHeadersGenerator() {
+    next = headers.size();
+    for (auto &worker : workers) {
+        worker.wait();
+    }
+}
+
+void TestHeadersGenerator::setTestHeader(tests::Tests &tests) {
+    auto it = codes.find(tests.sourceFilePath);
+    if (it == codes.end()) {
+        return;
+    }
+    tests.headerCode = it->second.get();
+}
+
+void TestHeadersGenerator::work(std::optional<std::string> clientId, grpc::ServerContext *serverContext) {
+    // logs and tokens of the worker are accounted to the client of the request
+    ParallelUtils::setRequestEnvironment(std::move(clientId), serverContext);
+    Generate generate = generateFactory();
+    for (size_t i = next++; i < headers.size(); i = next++) {
+        Header &header = headers[i];
+        try {
+            if (RequestEnvironment::isCancelled()) {
+                throw CancellationException();
+            }
+            auto tokens = ResourceScheduler::getInstance().acquire(ResourceScheduler::Kind::COMPILER_JOB);
+            header.code.set_value(generate(header.sourceFilePath, *header.tests, header.externFromStub));
+        } catch (...) {
+            header.code.set_exception(std::current_exception());
+        }
+    }
+}
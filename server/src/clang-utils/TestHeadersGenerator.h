@@ -0,0 +1,94 @@
+#ifndef UNITTESTBOT_TESTHEADERSGENERATOR_H
+#define UNITTESTBOT_TESTHEADERSGENERATOR_H
+
+#include "ProjectContext.h"
+#include "Tests.h"
+#include "building/CompilationDatabase.h"
+#include "fetchers/Fetcher.h"
+#include "stubs/StubGen.h"
+#include "types/Types.h"
+#include "utils/CollectionUtils.h"
+
+#include <grpcpp/grpcpp.h>
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * Generates headers for tests in background while KLEE runs, instead of a separate stage
+ * before it. Files are taken in order of the tests map, in which KLEE runs for them,
+ * by a bounded number of workers with their own rewriters, so printing of tests
+ * of a file waits only for the header of this file.
+ */
+class TestHeadersGenerator {
+public:
+    /// generates the header for tests of a file, a worker has its own one as it may keep state
+    using Generate =
+        std::function<std::string(const fs::path &sourceFilePath, const tests::Tests &tests, bool externFromStub)>;
+    using GenerateFactory = std::function<Generate()>;
+
+    /**
+     * Starts generation for all files of tests. Tests must not be added or removed until
+     * the generator is destroyed. Workers read typesHandler concurrently, so it must not be
+     * changed until the generator is destroyed either.
+     */
+    TestHeadersGenerator(utbot::ProjectContext projectContext,
+                         std::shared_ptr<CompilationDatabase> compilationDatabase,
+                         std::shared_ptr<Fetcher::FileToStringSet> structsToDeclare,
+                         fs::path serverBuildDir,
+                         const types::TypesHandler &typesHandler,
+                         const tests::TestsMap &tests,
+                         const StubGen &stubGen,
+                         const CollectionUtils::MapFileTo<fs::path> &selectedTargets);
+
+    /**
+     * Starts generation for all files of tests by up to workersNumber workers.
+     * @param externFromStub files whose tests are linked with their own stubs
+     */
+    TestHeadersGenerator(const tests::TestsMap &tests,
+                         const CollectionUtils::FileSet &externFromStub,
+                         GenerateFactory generateFactory,
+                         size_t workersNumber);
+
+    /**
+     * Skips files which are not started yet and waits for the started ones.
+     */
+    ~TestHeadersGenerator();
+
+    TestHeadersGenerator(const TestHeadersGenerator &) = delete;
+    TestHeadersGenerator &operator=(const TestHeadersGenerator &) = delete;
+
+    /**
+     * Waits until the header for tests is generated and sets it to tests.headerCode.
+     * @throws exception thrown while the header was generated
+     */
+    void setTestHeader(tests::Tests &tests);
+
+private:
+    struct Header {
+        fs::path sourceFilePath;
+        const tests::Tests *tests;
+        bool externFromStub;
+        std::promise<std::string> code;
+    };
+
+    const GenerateFactory generateFactory;
+    std::vector<Header> headers;
+    CollectionUtils::MapFileTo<std::shared_future<std::string>> codes;
+    std::atomic<size_t> next = 0;
+    std::vector<std::future<void>> workers;
+
+    static CollectionUtils::FileSet getExternFromStub(const tests::TestsMap &tests,
+                                                      const StubGen &stubGen,
+                                                      const CollectionUtils::MapFileTo<fs::path> &selectedTargets);
+
+    void work(std::optional<std::string> clientId, grpc::ServerContext *serverContext);
+};
+
+
+#endif // UNITTESTBOT_TESTHEADERSGENERATOR_H
@@ -7,6 +7,13 @@
 
 uint32_t Commands::threadsPerUser = 0;
 uint32_t Commands::kleeProcessNumber = 0;
+uint32_t Commands::maxActiveRequests = 0;
+uint32_t Commands::maxJobs = 0;
+uint64_t Commands::memoryLimit = 0;
+uint32_t Commands::sessionCacheSize = 0;
+bool Commands::compileInProcess = false;
+uint64_t Commands::bitcodeCacheSize = 4096;
+std::string Commands::kleeOutputDir;
 
 Commands::MainCommands::MainCommands(CLI::App &app) {
     app.set_help_all_flag("--help-all", "Expand all help");
@@ -55,6 +62,27 @@ Commands::ServerCommandOptions::ServerCommandOptions(CLI::App *command) {
     command->add_option("-j", threadsPerUser, "Maximum number of threads per user.");
     command->add_option("--klee-process-number", kleeProcessNumber,
                         "Number of threads for KLEE in interactive mode");
+    command->add_option("--max-active-requests", maxActiveRequests,
+                        "Maximum number of requests of all users processed at the same time, "
+                        "0 means the number of CPU cores.");
+    command->add_option("--max-jobs", maxJobs,
+                        "Maximum number of compiler, KLEE and test processes of all users run at the same "
+                        "time, 0 means the number of CPU cores.");
+    command->add_option("--memory-limit", memoryLimit,
+                        "Memory in MiB which processes launched by server may use before new KLEE "
+                        "runs are deferred, 0 means 80% of physical memory.");
+    command->add_option("--session-cache-size", sessionCacheSize,
+                        "Number of projects whose build databases and parsed sources are kept in memory "
+                        "between requests, 0 disables the cache.");
+    command->add_flag("--compile-in-process", compileInProcess,
+                      "Compile bitcode for KLEE by clang linked into the server instead of running "
+                      "make and a compiler process for each file.");
+    command->add_option("--bitcode-cache-size", bitcodeCacheSize,
+                        "Size in MiB of the store of compiled bitcode shared by all projects, "
+                        "0 disables the store. The store is used only with --compile-in-process.");
+    command->add_option("--klee-output-dir", kleeOutputDir,
+                        "Directory on a local or in-memory file system, e.g. /dev/shm, where KLEE writes "
+                        "test cases instead of build directories of projects.");
 }
 
 fs::path Commands::MainCommands::getLogPath() {
@@ -77,6 +105,34 @@ unsigned int Commands::ServerCommandOptions::getKleeProcessNumber() {
     return kleeProcessNumber;
 }
 
+unsigned int Commands::ServerCommandOptions::getMaxActiveRequests() {
+    return maxActiveRequests;
+}
+
+unsigned int Commands::ServerCommandOptions::getMaxJobs() {
+    return maxJobs;
+}
+
+uint64_t Commands::ServerCommandOptions::getMemoryLimit() {
+    return memoryLimit;
+}
+
+unsigned int Commands::ServerCommandOptions::getSessionCacheSize() {
+    return sessionCacheSize;
+}
+
+bool Commands::ServerCommandOptions::getCompileInProcess() {
+    return compileInProcess;
+}
+
+uint64_t Commands::ServerCommandOptions::getBitcodeCacheSize() {
+    return bitcodeCacheSize;
+}
+
+std::string Commands::ServerCommandOptions::getKleeOutputDir() {
+    return kleeOutputDir;
+}
+
 const std::map<std::string, loguru::NamedVerbosity> Commands::MainCommands::verbosityMap = {
         {"trace",   loguru::NamedVerbosity::Verbosity_MAX},
         {"debug",   loguru::NamedVerbosity::Verbosity_1},
@@ -272,6 +328,14 @@ Commands::GenerateCommandsOptions::GenerateCommandsOptions(GenerateCommands &gen
     generateCommands.getClassCommand()->add_option(targetFlag, target, targetDescription);
     generateCommands.getAssertionCommand()->add_option(targetFlag, target, targetDescription);
     generateCommands.getPredicateCommand()->add_option(targetFlag, target, targetDescription);
+
+    // resume
+    generateCommands.getProjectCommand()->add_flag(resumeFlag, resume, resumeDescription);
+    generateCommands.getFolderCommand()->add_flag(resumeFlag, resume, resumeDescription);
+
+    // journal
+    generateCommands.getProjectCommand()->add_flag(journalFlag, journal, journalDescription);
+    generateCommands.getFolderCommand()->add_flag(journalFlag, journal, journalDescription);
 }
 
 std::string Commands::GenerateBaseCommandsOptions::getSrcPaths() const {
@@ -306,6 +370,14 @@ std::optional<std::string> Commands::GenerateBaseCommandsOptions::getTarget() co
     return target;
 }
 
+bool Commands::GenerateBaseCommandsOptions::isResume() const {
+    return resume;
+}
+
+bool Commands::GenerateBaseCommandsOptions::isJournal() const {
+    return journal;
+}
+
 const std::map<std::string, testsgen::ValidationType>
         Commands::GenerateCommandsOptions::validationTypeMap = {
         {"int8",   testsgen::ValidationType::INT8_T},
@@ -397,6 +469,9 @@ Commands::SettingsContextOptionGroup::SettingsContextOptionGroup(CLI::App *comma
     settingsContextOptions->add_flag("--no-stubs", noStubs,
                                      "True, if you don't want UTBot to use generated stubs from "
                                      "<testsDir>/stubs folder instead real files.");
+    settingsContextOptions->add_flag("--incremental", incrementalGeneration,
+                                     "Reuse results of KLEE from the previous generation for functions "
+                                     "whose bitcode, callees and used globals are not changed.");
 }
 
 CLI::Option_group *Commands::SettingsContextOptionGroup::getSettingsCommandsContext() const {
@@ -439,6 +514,10 @@ bool Commands::SettingsContextOptionGroup::getSkipObjectWithoutSource() const {
     return skipObjectWithoutSource;
 }
 
+bool Commands::SettingsContextOptionGroup::isIncrementalGeneration() const {
+    return incrementalGeneration;
+}
+
 Commands::RunTestsCommands::RunTestsCommands(Commands::MainCommands &commands) {
     runCommand = commands.getRunTestsCommand();
 
@@ -531,6 +610,8 @@ Commands::AllCommandOptions::AllCommandOptions(CLI::App *command) : allCommand(c
     allCommand->add_option("--no-coverage", noCoverage, "Flag that controls coverage generation.");
     allCommand->add_option(srcPathsFlag, srcPaths, srcPathsDescription);
     allCommand->add_option(targetFlag, target, targetDescription);
+    allCommand->add_flag(resumeFlag, resume, resumeDescription);
+    allCommand->add_flag(journalFlag, journal, journalDescription);
 }
 
 bool Commands::AllCommandOptions::withCoverage() const {
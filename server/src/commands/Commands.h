@@ -15,6 +15,13 @@ using namespace ::testsgen;
 namespace Commands {
     extern uint32_t threadsPerUser;
     extern uint32_t kleeProcessNumber;
+    extern uint32_t maxActiveRequests;
+    extern uint32_t maxJobs;
+    extern uint64_t memoryLimit;
+    extern uint32_t sessionCacheSize;
+    extern bool compileInProcess;
+    extern uint64_t bitcodeCacheSize;
+    extern std::string kleeOutputDir;
 
     struct MainCommands {
         explicit MainCommands(CLI::App &app);
@@ -51,6 +58,20 @@ namespace Commands {
 
         unsigned int getKleeProcessNumber();
 
+        unsigned int getMaxActiveRequests();
+
+        unsigned int getMaxJobs();
+
+        uint64_t getMemoryLimit();
+
+        unsigned int getSessionCacheSize();
+
+        bool getCompileInProcess();
+
+        uint64_t getBitcodeCacheSize();
+
+        std::string getKleeOutputDir();
+
     private:
         unsigned int port = 0;
     };
@@ -120,6 +141,10 @@ namespace Commands {
 
         [[nodiscard]] std::optional<std::string> getTarget() const;
 
+        [[nodiscard]] bool isResume() const;
+
+        [[nodiscard]] bool isJournal() const;
+
         // source paths
         std::string srcPaths;
         const std::string srcPathsDescription = "Relative paths to directories, containing source files. "
@@ -130,6 +155,19 @@ namespace Commands {
         std::optional<std::string> target;
         const std::string targetDescription = "Name or full path of target.";
         const std::string targetFlag = "--target";
+
+        // resume
+        bool resume = false;
+        const std::string resumeDescription = "Continue interrupted generation, files whose tests "
+                                              "were generated are not passed to KLEE again.";
+        const std::string resumeFlag = "--resume";
+
+        // journal
+        bool journal = false;
+        const std::string journalDescription = "Keep output of KLEE for every file as soon as it is ready, "
+                                               "so that an interrupted generation can be continued "
+                                               "with --resume.";
+        const std::string journalFlag = "--journal";
     };
 
     struct GenerateCommandsOptions : public GenerateBaseCommandsOptions {
@@ -281,6 +319,8 @@ namespace Commands {
 
         [[nodiscard]] bool getSkipObjectWithoutSource() const;
 
+        [[nodiscard]] bool isIncrementalGeneration() const;
+
     private:
         CLI::Option_group *settingsContextOptions;
         bool generateForStaticFunctions = true;
@@ -292,6 +332,7 @@ namespace Commands {
         ErrorMode errorMode = ErrorMode::FAILING;
         bool differentVariablesOfTheSameType = false;
         bool skipObjectWithoutSource = false;
+        bool incrementalGeneration = false;
     };
 };
 
@@ -5,6 +5,7 @@
 #include "utils/FileSystemUtils.h"
 #include "utils/StringUtils.h"
 #include "utils/stats/TestsExecutionStats.h"
+#include "utils/stats/StageStats.h"
 
 #include "loguru.h"
 
@@ -33,10 +34,16 @@ grpc::Status CoverageAndResultsGenerator::generate(bool withCoverage,
                                                    utbot::SettingsContext &settingsContext) {
     MEASURE_FUNCTION_EXECUTION_TIME
     try {
-        init(withCoverage);
-        runTests(withCoverage, settingsContext.timeoutPerTest);
+        {
+            MEASURE_STAGE_EXECUTION_TIME("test run")
+            init(withCoverage);
+            runTests(withCoverage, settingsContext.timeoutPerTest);
+        }
         if (withCoverage) {
-            collectCoverage();
+            {
+                MEASURE_STAGE_EXECUTION_TIME("coverage")
+                collectCoverage();
+            }
             StatsUtils::TestsExecutionStatsFileMap testsExecutionStats(projectContext, testResultMap, coverageMap);
             printer::CSVPrinter printer = testsExecutionStats.toCSV();
             FileSystemUtils::writeToFile(Paths::getExecutionStatsCSVPath(projectContext), printer.getStream().str());
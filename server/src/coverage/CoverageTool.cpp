@@ -3,6 +3,7 @@
 #include "GcovCoverageTool.h"
 #include "LlvmCoverageTool.h"
 #include "exceptions/CoverageGenerationException.h"
+#include "utils/CollectionUtils.h"
 #include "utils/CompilationUtils.h"
 #include "utils/StringUtils.h"
 
@@ -33,10 +34,15 @@ std::unique_ptr<CoverageTool> getCoverageTool(const std::string &compileCommands
     }
 }
 
-std::string CoverageTool::getGTestFlags(const UnitTest &unitTest) const {
-    std::string gtestFilterFlag = StringUtils::stringFormat("\"--gtest_filter=*.%s\"", unitTest.testname);
-    std::string gtestOutputFlag = StringUtils::stringFormat("\"--gtest_output=json:%s\"",
+std::vector<std::string> CoverageTool::getGTestArguments(const UnitTest &unitTest) const {
+    std::string gtestFilterFlag = StringUtils::stringFormat("--gtest_filter=*.%s", unitTest.testname);
+    std::string gtestOutputFlag = StringUtils::stringFormat("--gtest_output=json:%s",
                                                             Paths::getGTestResultsJsonPath(projectContext));
-    std::vector<std::string> gtestFlagsList = { gtestFilterFlag, gtestOutputFlag };
+    return { gtestFilterFlag, gtestOutputFlag };
+}
+
+std::string CoverageTool::getGTestFlags(const UnitTest &unitTest) const {
+    std::vector<std::string> gtestFlagsList = CollectionUtils::transform(
+        getGTestArguments(unitTest), [](std::string const &flag) { return "\"" + flag + "\""; });
     return StringUtils::joinWith(gtestFlagsList, " ");
 }
@@ -15,6 +15,9 @@ struct BuildRunCommand {
     UnitTest unitTest;
     MakefileUtils::MakefileCommand buildCommand;
     MakefileUtils::MakefileCommand runCommand;
+    /// arguments and environment for launching the test binary without make
+    std::vector<std::string> gtestArguments;
+    std::vector<std::string> runEnv;
 };
 
 class CoverageTool {
@@ -22,6 +25,8 @@ protected:
     ProgressWriter const *progressWriter;
     const utbot::ProjectContext projectContext;
 
+    [[nodiscard]] std::vector<std::string> getGTestArguments(const UnitTest &unitTest) const;
+
     [[nodiscard]] std::string getGTestFlags(const UnitTest &unitTest) const;
 
 public:
@@ -45,7 +45,7 @@ GcovCoverageTool::getBuildRunCommands(const std::vector<UnitTest> &testsToLaunch
                                                                gtestFlags);
             auto runCommand = MakefileUtils::MakefileCommand(projectContext, makefile,
                                                              printer::DefaultMakefilePrinter::TARGET_RUN, gtestFlags);
-            result.push_back({testToLaunch, buildCommand, runCommand});
+            result.push_back({testToLaunch, buildCommand, runCommand, getGTestArguments(testToLaunch), {}});
         });
     return result;
 }
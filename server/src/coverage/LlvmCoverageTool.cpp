@@ -45,7 +45,8 @@ LlvmCoverageTool::getBuildRunCommands(const std::vector<UnitTest> &testsToLaunch
         auto runCommand = MakefileUtils::MakefileCommand(projectContext, makefilePath,
                                                          printer::DefaultMakefilePrinter::TARGET_RUN,
                                                          gtestFlags, profileEnv);
-        return BuildRunCommand{testToLaunch, buildCommand, runCommand};
+        return BuildRunCommand{testToLaunch, buildCommand, runCommand,
+                               getGTestArguments(testToLaunch), profileEnv};
     });
 }
 
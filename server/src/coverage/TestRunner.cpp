@@ -8,10 +8,13 @@
 #include "TimeExecStatistics.h"
 #include "utils/FileSystemUtils.h"
 #include "utils/JsonUtils.h"
+#include "utils/ResourceScheduler.h"
 #include "utils/StringUtils.h"
 
 #include "loguru.h"
 
+#include <cstdlib>
+
 using grpc::ServerWriter;
 using grpc::Status;
 
@@ -59,6 +62,7 @@ std::vector<UnitTest> TestRunner::getTestsFromMakefile(const fs::path &makefile,
         LOG_S(ERROR) << err;
         throw ExecutionProcessException(err, logFilePath.value());
     }
+    loadRunManifest(makefile);
     if (out.empty()) {
         LOG_S(WARNING)
         << "Running gtest with flag --gtest_list_tests returns empty output. Does file contain main function?";
@@ -117,7 +121,8 @@ std::vector<UnitTest> TestRunner::getTestsToLaunch() {
                             if (!StringUtils::endsWith(testFilePath.stem().c_str(), Paths::TEST_SUFFIX) &&
                                 !StringUtils::endsWith(testFilePath.stem().c_str(), Paths::STUB_SUFFIX) &&
                                 !StringUtils::endsWith(testFilePath.stem().c_str(), Paths::MAKE_WRAPPER_SUFFIX) &&
-                                !StringUtils::endsWith(testFilePath.c_str(), Paths::MAKEFILE_EXTENSION)) {
+                                !StringUtils::endsWith(testFilePath.c_str(), Paths::MAKEFILE_EXTENSION) &&
+                                !StringUtils::endsWith(testFilePath.c_str(), Paths::RUN_MANIFEST_EXTENSION)) {
                                 LOG_S(WARNING) << "Found extra file in test directory: " << testFilePath;
                             }
                         }
@@ -219,7 +224,16 @@ size_t TestRunner::buildTests(const utbot::ProjectContext &projectContext, const
 testsgen::TestResultObject TestRunner::runTest(const BuildRunCommand &command,
                                                const std::optional<std::chrono::seconds> &testTimeout) {
     fs::remove(Paths::getGTestResultsJsonPath(projectContext));
-    auto res = command.runCommand.run(projectContext.getBuildDirAbsPath(), true, true, testTimeout);
+    ExecUtils::ExecutionResult res;
+    if (auto directRun = getDirectRunParameters(command); directRun.has_value()) {
+        auto &[params, workingDir] = directRun.value();
+        // make takes its own tokens in the other branch
+        auto tokens = ResourceScheduler::getInstance().acquire(ResourceScheduler::Kind::TEST_PROCESS);
+        res = ShellExecTask::runShellCommandTask(params, workingDir, projectContext.projectName,
+                                                 true, false, true, testTimeout);
+    } else {
+        res = command.runCommand.run(projectContext.getBuildDirAbsPath(), true, true, testTimeout);
+    }
     GTestLogger::log(res.output);
     testsgen::TestResultObject testRes;
     testRes.set_testfilepath(command.unitTest.testFilePath);
@@ -250,6 +264,75 @@ testsgen::TestResultObject TestRunner::runTest(const BuildRunCommand &command,
     return testRes;
 }
 
+void TestRunner::loadRunManifest(const fs::path &makefile) {
+    fs::path manifestPath = Paths::getRunManifestPath(makefile);
+    if (!fs::exists(manifestPath)) {
+        LOG_S(DEBUG) << "Run manifest not found, tests will be launched via make: " << manifestPath;
+        return;
+    }
+    try {
+        runManifests[makefile] = JsonUtils::getJsonFromFile(manifestPath);
+    } catch (const std::exception &e) {
+        LOG_S(WARNING) << "Cannot read run manifest " << manifestPath << ": " << e.what();
+    }
+}
+
+std::optional<std::pair<ShellExecTask::ExecutionParameters, fs::path>>
+TestRunner::getDirectRunParameters(const BuildRunCommand &command) const {
+    fs::path sourcePath = Paths::testPathToSourcePath(projectContext, command.unitTest.testFilePath);
+    fs::path makefile = Paths::getMakefilePathFromSourceFilePath(projectContext, sourcePath);
+    auto it = runManifests.find(makefile);
+    fs::path manifestPath = Paths::getRunManifestPath(makefile);
+    if (it == runManifests.end() || !fs::exists(manifestPath)) {
+        return std::nullopt;
+    }
+    try {
+        // the run target launches the first variant that builds, so the freshest binary
+        // not older than the manifest is the one make would have run
+        auto manifestTime = fs::last_write_time(manifestPath);
+        std::optional<nlohmann::json> chosen;
+        fs::file_time_type chosenTime;
+        for (const nlohmann::json &variant : it->second.at("variants")) {
+            fs::path binary = variant.at("binary").get<std::string>();
+            if (!fs::exists(binary)) {
+                continue;
+            }
+            auto binaryTime = fs::last_write_time(binary);
+            if (binaryTime >= manifestTime && (!chosen.has_value() || binaryTime > chosenTime)) {
+                chosen = variant;
+                chosenTime = binaryTime;
+            }
+        }
+        if (!chosen.has_value()) {
+            return std::nullopt;
+        }
+        fs::path workingDir = chosen->at("workingDir").get<std::string>();
+        auto appendToVariable = [](const std::string &name, const std::string &value) {
+            const char *current = std::getenv(name.c_str());
+            if (current == nullptr || *current == '\0') {
+                return name + "=" + value;
+            }
+            return StringUtils::stringFormat("%s=%s:%s", name, value, current);
+        };
+        std::vector<std::string> env = command.runEnv;
+        const char *path = std::getenv("PATH");
+        env.push_back(StringUtils::stringFormat("PATH=%s:%s", path == nullptr ? "" : path, workingDir));
+        env.push_back(appendToVariable("LD_LIBRARY_PATH", chosen->at("libraryPath").get<std::string>()));
+        if (chosen->contains("preload")) {
+            env.push_back(appendToVariable("LD_PRELOAD", chosen->at("preload").get<std::string>()));
+        }
+        for (const auto &variable : chosen->at("env").items()) {
+            env.push_back(variable.key() + "=" + variable.value().get<std::string>());
+        }
+        fs::path binary = chosen->at("binary").get<std::string>();
+        ShellExecTask::ExecutionParameters params(binary.string(), command.gtestArguments, env);
+        return std::make_pair(params, workingDir);
+    } catch (const std::exception &e) {
+        LOG_S(WARNING) << "Cannot use run manifest " << manifestPath << ", falling back to make: " << e.what();
+        return std::nullopt;
+    }
+}
+
 const Coverage::TestResultMap &TestRunner::getTestResultMap() const {
     return testResultMap;
 }
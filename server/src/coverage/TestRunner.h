@@ -7,6 +7,7 @@
 #include "exceptions/ExecutionProcessException.h"
 #include "utils/path/FileSystemPath.h"
 #include "streams/IStreamWriter.h"
+#include "utils/CollectionUtils.h"
 #include "streams/coverage/CoverageAndResultsWriter.h"
 #include "streams/coverage/ServerCoverageAndResultsWriter.h"
 #include "Tests.h"
@@ -75,6 +76,21 @@ private:
     testsgen::TestResultObject runTest(const BuildRunCommand &command,
                                        const std::optional<std::chrono::seconds> &testTimeout);
 
+    /**
+     * Remembers run manifest of the makefile whose test binary has just been built,
+     * so that its tests can be launched without make.
+     */
+    void loadRunManifest(const fs::path &makefile);
+
+    /**
+     * Returns parameters and working directory for launching the test binary directly,
+     * or std::nullopt if the binary is not known to be up to date and make should be used.
+     */
+    std::optional<std::pair<ShellExecTask::ExecutionParameters, fs::path>>
+    getDirectRunParameters(const BuildRunCommand &command) const;
+
+    CollectionUtils::MapFileTo<nlohmann::json> runManifests;
+
     ServerCoverageAndResultsWriter writer{nullptr};
 
     void cleanCoverage();
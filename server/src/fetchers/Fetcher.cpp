@@ -4,6 +4,7 @@
 #include "FunctionDeclsMatchCallback.h"
 #include "GlobalVariableUsageMatchCallback.h"
 #include "IncludeFetchSourceFileCallback.h"
+#include "LineIndexMatchCallback.h"
 #include "Paths.h"
 #include "ReturnStmtFetcherMatchCallback.h"
 #include "SingleFileParseModeCallback.h"
@@ -47,6 +48,11 @@ Fetcher::Fetcher(Options options,
         addMatcher<ArraySubscriptFetcherMatchCallback>(arraySubscriptMatcher);
         addMatcher<ReturnStmtFetcherMatchCallback>(returnMatcher);
     }
+    if (options.has(Options::Value::LINE_INDEX)) {
+        addMatcher<LineIndexMatchCallback>(constructorDefinitionMatcher);
+        addMatcher<LineIndexMatchCallback>(memberConstructorDefinitionMatcher);
+        addMatcher<LineIndexMatchCallback>(functionDefinitionMatcher);
+    }
     if (options.has(Options::Value::INCLUDE)) {
         auto callback = std::make_unique<IncludeFetchSourceFileCallback>(this);
         sourceFileCallbacks.add(std::move(callback));
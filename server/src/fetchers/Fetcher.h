@@ -31,6 +31,7 @@ public:
     friend class GlobalVariableUsageMatchCallback;
     friend class ArraySubscriptFetcherMatchCallback;
     friend class ReturnStmtFetcherMatchCallback;
+    friend class LineIndexMatchCallback;
     friend class IncludeFetchSourceFileCallbacks;
     friend class IncludeFetchPPCallbacks;
 
@@ -47,6 +48,7 @@ public:
             FUNCTION_NAMES_ONLY = (1 << 5),
             RETURN_TYPE_NAMES_ONLY = (1 << 6),
             WRAPPER = (1 << 7),
+            LINE_INDEX = (1 << 8),
             ALL = TYPE | FUNCTION | GLOBAL_VARIABLE_USAGE | ARRAY_USAGE | INCLUDE
         } value;
 
@@ -0,0 +1,86 @@
+#include "LineIndexMatchCallback.h"
+
+#include "Fetcher.h"
+#include "clang-utils/ClangUtils.h"
+
+#include <clang/Lex/Lexer.h>
+
+using namespace clang;
+
+void LineIndexMatchCallback::run(const MatchFinder::MatchResult &Result) {
+    ExecUtils::throwIfCancelled();
+    const FunctionDecl *FS = ClangUtils::getFunctionOrConstructor(Result);
+    if (FS == nullptr || FS->getBody() == nullptr) {
+        return;
+    }
+    const SourceManager &sourceManager = Result.Context->getSourceManager();
+    // constructor matchers are not restricted to the main file, while lines of definitions
+    // in included headers must not be mixed with lines of the source file
+    if (!sourceManager.isInMainFile(sourceManager.getExpansionLoc(FS->getBeginLoc()))) {
+        return;
+    }
+    const LangOptions &langOptions = Result.Context->getLangOpts();
+    fs::path sourceFilePath = ClangUtils::getSourceFilePath(sourceManager);
+    auto tests = parent->projectTests->find(sourceFilePath);
+    if (tests == parent->projectTests->end()) {
+        return;
+    }
+    std::string scopeName;
+    if (auto namedParent = dyn_cast<NamedDecl>(FS->getParent())) {
+        scopeName = namedParent->getNameAsString();
+    } else {
+        scopeName = sourceFilePath.stem().string();
+    }
+    LineIndex &lineIndex = tests.value().lineIndex;
+    uint32_t body = lineIndex.addFunction(FS->getQualifiedNameAsString(), scopeName,
+                                          getBorders(FS->getSourceRange(), sourceManager, langOptions),
+                                          getBorders(FS->getBody()->getSourceRange(), sourceManager,
+                                                     langOptions));
+    addChildren(lineIndex, body, FS->getBody(), sourceManager, langOptions);
+}
+
+void LineIndexMatchCallback::addChildren(LineIndex &lineIndex, uint32_t parentIndex, const Stmt *stmt,
+                                         const SourceManager &sourceManager,
+                                         const LangOptions &langOptions) {
+    std::vector<const Stmt *> children;
+    std::vector<LineIndex::StatementBorders> childrenBorders;
+    for (const Stmt *child : stmt->children()) {
+        if (child == nullptr) {
+            continue;
+        }
+        auto kind = LineIndex::StatementKind::OTHER;
+        if (isa<IfStmt>(child) || isa<ForStmt>(child) || isa<WhileStmt>(child)) {
+            kind = LineIndex::StatementKind::BRANCH;
+        } else if (isa<ReturnStmt>(child)) {
+            kind = LineIndex::StatementKind::RETURN;
+        }
+        children.push_back(child);
+        childrenBorders.emplace_back(kind, getBorders(child->getSourceRange(), sourceManager, langOptions));
+    }
+    if (children.empty()) {
+        return;
+    }
+    uint32_t first = lineIndex.addChildren(parentIndex, childrenBorders);
+    for (size_t i = 0; i < children.size(); ++i) {
+        addChildren(lineIndex, first + i, children[i], sourceManager, langOptions);
+    }
+}
+
+LineIndex::Borders LineIndexMatchCallback::getBorders(const SourceRange &sourceRange,
+                                                      const SourceManager &sourceManager,
+                                                      const LangOptions &langOptions) {
+    LineIndex::Borders borders;
+    borders.beginLine = sourceManager.getExpansionLineNumber(sourceRange.getBegin());
+    borders.endLine = sourceManager.getExpansionLineNumber(sourceRange.getEnd());
+    // the same text as ASTPrinter::getSourceText gives
+    auto beginLoc = sourceManager.getExpansionLoc(sourceRange.getBegin());
+    auto endLoc = Lexer::getLocForEndOfToken(sourceManager.getExpansionLoc(sourceRange.getEnd()), 0,
+                                             sourceManager, langOptions);
+    FileID mainFileId = sourceManager.getMainFileID();
+    if (endLoc.isValid() && sourceManager.getFileID(beginLoc) == mainFileId &&
+        sourceManager.getFileID(endLoc) == mainFileId) {
+        borders.beginOffset = sourceManager.getFileOffset(beginLoc);
+        borders.endOffset = sourceManager.getFileOffset(endLoc);
+    }
+    return borders;
+}
@@ -0,0 +1,36 @@
+#ifndef UNITTESTBOT_LINEINDEXMATCHCALLBACK_H
+#define UNITTESTBOT_LINEINDEXMATCHCALLBACK_H
+
+#include "LineIndex.h"
+
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+
+class Fetcher;
+
+/**
+ * Records borders of function definitions and of statements in their bodies to the line index
+ * of the source file.
+ */
+class LineIndexMatchCallback : public clang::ast_matchers::MatchFinder::MatchCallback {
+    using MatchFinder = clang::ast_matchers::MatchFinder;
+
+public:
+    explicit LineIndexMatchCallback(const Fetcher *parent) : parent(parent) {
+    }
+
+    void run(const MatchFinder::MatchResult &Result) override;
+
+private:
+    Fetcher const *const parent;
+
+    static void addChildren(LineIndex &lineIndex, uint32_t parentIndex, const clang::Stmt *stmt,
+                            const clang::SourceManager &sourceManager,
+                            const clang::LangOptions &langOptions);
+
+    static LineIndex::Borders getBorders(const clang::SourceRange &sourceRange,
+                                         const clang::SourceManager &sourceManager,
+                                         const clang::LangOptions &langOptions);
+};
+
+
+#endif // UNITTESTBOT_LINEINDEXMATCHCALLBACK_H
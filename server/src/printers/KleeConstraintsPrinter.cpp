@@ -59,7 +59,7 @@ void KleeConstraintsPrinter::noConstraints(const std::string &cause) {
 }
 
 void KleeConstraintsPrinter::genConstraintsForEnum(const ConstraintsState &state) {
-    types::EnumInfo enumInfo = typesHandler->getEnumInfo(state.curType);
+    const types::EnumInfo &enumInfo = typesHandler->getEnumInfo(state.curType);
 
     std::stringstream _ss;
     for (auto it = enumInfo.namesToEntries.begin(); it != enumInfo.namesToEntries.end(); ++it) {
@@ -117,7 +117,7 @@ void KleeConstraintsPrinter::genConstraintsForPointerInStruct(const ConstraintsS
 }
 
 void KleeConstraintsPrinter::genConstraintsForStruct(const ConstraintsState &state) {
-    StructInfo curStruct = typesHandler->getStructInfo(state.curType);
+    const StructInfo &curStruct = typesHandler->getStructInfo(state.curType);
     bool isStruct = curStruct.subType == SubType::Struct;
     for (const auto &field: curStruct.fields) {
         auto access = PrinterUtils::getFieldAccess(state.curElement, field);
@@ -538,11 +538,9 @@ void KleePrinter::genKleePathSymbolicIfNeeded(
                                                                const types::Type &type) {
     const types::Type baseType = type.baseTypeObj();
     if (typesHandler->isStructLike(baseType)) {
-        auto filepath = typesHandler->getStructInfo(baseType).filePath;
         headers.insert(typesHandler->getStructInfo(baseType).filePath);
     }
     if (typesHandler->isEnum(baseType)) {
-        auto filepath = typesHandler->getEnumInfo(baseType).filePath;
         headers.insert(typesHandler->getEnumInfo(baseType).filePath);
     }
 }
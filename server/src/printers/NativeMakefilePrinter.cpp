@@ -11,10 +11,16 @@
 #include "utils/ArgumentsUtils.h"
 #include "utils/CompilationUtils.h"
 #include "utils/DynamicLibraryUtils.h"
+#include "utils/HashUtils.h"
 #include "utils/LinkerUtils.h"
 #include "utils/SanitizerUtils.h"
 #include "utils/StringUtils.h"
 
+#include "loguru.h"
+
+#include <filesystem>
+#include <utility>
+
 namespace printer {
     using namespace DynamicLibraryUtils;
     using StringUtils::stringFormat;
@@ -23,6 +29,7 @@ namespace printer {
     static const std::string STUB_OBJECT_FILES = "$(" + STUB_OBJECT_FILES_NAME + ")";
 
     static const std::string FPIC_FLAG = "-fPIC";
+    static const std::string GTEST_STANDARD_FLAG = "-std=c++11";
     static const std::vector<std::string> SANITIZER_NEEDED_FLAGS = {
             "-g", "-fno-omit-frame-pointer", "-fno-optimize-sibling-calls"
     };
@@ -159,13 +166,13 @@ namespace printer {
 
         comment("{ gtest");
 
-        fs::path gtestBuildDirectory = getRelativePath(buildDirectory / "googletest");
+        fs::path gtestBuildDirectory = getRelativePath(getGtestCacheDirectory());
         fs::path defaultPath = "default.c";
         std::vector<std::string> defaultGtestCompileCommandLine{
             getRelativePathForLinker(primaryCxxCompiler),
             bits32Flag,
             "-c",
-            "-std=c++11",
+            GTEST_STANDARD_FLAG,
             FPIC_FLAG,
             defaultPath };
         utbot::CompileCommand defaultGtestCompileCommand{ defaultGtestCompileCommandLine,
@@ -187,49 +194,84 @@ namespace printer {
                Paths::addExtension(relativePath, ".d");
     }
 
-    void NativeMakefilePrinter::gtestAllTargets(const utbot::CompileCommand &defaultCompileCommand,
-                                                const fs::path &gtestBuildDir) {
+    fs::path NativeMakefilePrinter::getGtestCacheDirectory() const {
+        // gtest objects depend only on the compiler, its flags and gtest sources,
+        // so they are built once and shared between all projects
+        std::vector<std::string> configuration{ primaryCxxCompiler.string(),
+                                                CompilationUtils::getCompilerVersion(primaryCxxCompiler),
+                                                bits32Flag, GTEST_STANDARD_FLAG, FPIC_FLAG,
+                                                Paths::getGtestLibPath().string() };
+        fs::path gtestCacheDirectory = Paths::getGtestCacheDir(HashUtils::sha1(configuration));
+        touchGtestCache(gtestCacheDirectory);
+        return gtestCacheDirectory;
+    }
+
+    void NativeMakefilePrinter::touchGtestCache(const fs::path &usedDirectory) {
+        std::error_code errorCode;
+        std::filesystem::create_directories(usedDirectory.string(), errorCode);
+        std::filesystem::last_write_time(usedDirectory.string(), std::filesystem::file_time_type::clock::now(),
+                                         errorCode);
+    }
+
+    void NativeMakefilePrinter::trimGtestCache(const fs::path &cacheDirectory) {
+        std::error_code errorCode;
+        std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> directories;
+        for (std::filesystem::directory_iterator it(cacheDirectory.string(), errorCode), end;
+             !errorCode && it != end; it.increment(errorCode)) {
+            auto time = it->last_write_time(errorCode);
+            if (errorCode) {
+                errorCode.clear();
+                continue;
+            }
+            directories.emplace_back(time, it->path());
+        }
+        if (directories.size() <= GTEST_CACHE_CAPACITY) {
+            return;
+        }
+        std::sort(directories.begin(), directories.end());
+        for (size_t i = 0; i + GTEST_CACHE_CAPACITY < directories.size(); ++i) {
+            LOG_S(DEBUG) << "Remove gtest objects built for old configuration " << directories[i].second;
+            std::filesystem::remove_all(directories[i].second, errorCode);
+        }
+    }
+
+    void NativeMakefilePrinter::gtestObjectTarget(const utbot::CompileCommand &defaultCompileCommand,
+                                                  const fs::path &gtestBuildDir,
+                                                  const std::string &sourceFileName,
+                                                  const std::string &variableName) {
         const fs::path gtestLib = Paths::getGtestLibPath();
-        fs::path gtestAllSourceFile = gtestLib / "googletest" / "src" / "gtest-all.cc";
-        fs::path gtestAllObjectFile = gtestBuildDir / "gtest-all.cc.o";
+        fs::path gtestSourceFile = gtestLib / "googletest" / "src" / sourceFileName;
+        fs::path gtestObjectFile = gtestBuildDir / (sourceFileName + ".o");
+        // several makefiles may build the same cached object concurrently,
+        // so each of them compiles to its own file and renames it atomically
+        fs::path temporaryObjectFile = gtestObjectFile.string() + ".$$$$";
 
         auto gtestCompilationArguments = defaultCompileCommand;
-        gtestCompilationArguments.setSourcePath(getRelativePath(gtestAllSourceFile));
-        gtestCompilationArguments.setOutput(gtestAllObjectFile);
+        gtestCompilationArguments.setSourcePath(getRelativePath(gtestSourceFile));
+        gtestCompilationArguments.setOutput(temporaryObjectFile);
         gtestCompilationArguments.addFlagsToBegin(
             { CompilationUtils::getIncludePath(getRelativePath(gtestLib) / "googletest" / "include"),
               CompilationUtils::getIncludePath(getRelativePath(gtestLib) / "googletest") });
 
-        declareTarget(gtestAllObjectFile, { gtestCompilationArguments.getSourcePath() },
-                      { gtestCompilationArguments.toStringWithChangingDirectory() });
-        declareShellVariable("GTEST_ALL", gtestAllObjectFile,
+        declareTarget(gtestObjectFile, { gtestCompilationArguments.getSourcePath() },
+                      { stringFormat("%s && mv -f %s %s",
+                                     gtestCompilationArguments.toStringWithChangingDirectory(),
+                                     temporaryObjectFile, gtestObjectFile) });
+        declareShellVariable(variableName, gtestObjectFile,
                              [&](const std::string& arg1, const std::string& arg2) {
             declareVariable(arg1, arg2);
         });
+        // cached objects are not artifacts of the project, so `clean` leaves them
+    }
 
-        artifacts.push_back(gtestAllObjectFile);
+    void NativeMakefilePrinter::gtestAllTargets(const utbot::CompileCommand &defaultCompileCommand,
+                                                const fs::path &gtestBuildDir) {
+        gtestObjectTarget(defaultCompileCommand, gtestBuildDir, "gtest-all.cc", "GTEST_ALL");
     }
 
     void NativeMakefilePrinter::gtestMainTargets(const utbot::CompileCommand &defaultCompileCommand,
                                                  const fs::path &gtestBuildDir) {
-        const fs::path gtestLib = Paths::getGtestLibPath();
-        fs::path gtestMainSourceFile = gtestLib / "googletest" / "src" / "gtest_main.cc";
-        fs::path gtestMainObjectFile = gtestBuildDir / "gtest_main.cc.o";
-
-        auto gtestCompilationArguments = defaultCompileCommand;
-        gtestCompilationArguments.addFlagsToBegin(
-                {CompilationUtils::getIncludePath(getRelativePath(gtestLib / "googletest" / "include")),
-                 CompilationUtils::getIncludePath(getRelativePath(gtestLib / "googletest"))});
-        gtestCompilationArguments.setSourcePath(getRelativePath(gtestMainSourceFile));
-        gtestCompilationArguments.setOutput(gtestMainObjectFile);
-        declareTarget(gtestMainObjectFile, { gtestCompilationArguments.getSourcePath() },
-                      { gtestCompilationArguments.toStringWithChangingDirectory() });
-        declareShellVariable("GTEST_MAIN", gtestMainObjectFile,
-                             [&](const std::string& arg1, const std::string& arg2) {
-            declareVariable(arg1, arg2);
-        });
-
-        artifacts.push_back(gtestMainObjectFile);
+        gtestObjectTarget(defaultCompileCommand, gtestBuildDir, "gtest_main.cc", "GTEST_MAIN");
     }
 
     void NativeMakefilePrinter::addCompileTarget(
@@ -472,6 +514,16 @@ namespace printer {
         declareTarget(TARGET_RUN, { TARGET_BUILD },
                       { testRunCommand.toStringWithChangingDirectory() });
 
+        runManifestEntry = { { "binary", testExecutablePath.string() },
+                             { "workingDir", buildDirectory.string() },
+                             { "libraryPath", sharedOutput.value().parent_path().string() },
+                             { "env",
+                               { { SanitizerUtils::UBSAN_OPTIONS_NAME, SanitizerUtils::UBSAN_OPTIONS_VALUE },
+                                 { SanitizerUtils::ASAN_OPTIONS_NAME, SanitizerUtils::ASAN_OPTIONS_VALUE } } } };
+        if (primaryCompilerName == CompilationUtils::CompilerName::GCC) {
+            runManifestEntry["preload"] = Paths::getAsanLibraryPath().string();
+        }
+
         close();
     }
 
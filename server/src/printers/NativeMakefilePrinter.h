@@ -6,6 +6,7 @@
 #include "printers/RelativeMakefilePrinter.h"
 #include "testgens/BaseTestGen.h"
 
+#include "json.hpp"
 #include "utils/path/FileSystemPath.h"
 #include <vector>
 
@@ -36,10 +37,23 @@ namespace printer {
 
         std::optional<fs::path> sharedOutput;
 
+        /// how to launch the test binary of this makefile directly, filled for a concrete source file
+        nlohmann::json runManifestEntry;
+
         fs::path getTemporaryDependencyFile(fs::path const &file);
 
         fs::path getDependencyFile(fs::path const &file);
 
+        fs::path getGtestCacheDirectory() const;
+
+        /// marks the directory of gtest objects as used, the time of the last use is what trimGtestCache sorts by
+        static void touchGtestCache(const fs::path &usedDirectory);
+
+        void gtestObjectTarget(const utbot::CompileCommand &defaultCompileCommand,
+                               const fs::path &gtestBuildDir,
+                               const std::string &sourceFileName,
+                               const std::string &variableName);
+
         void gtestAllTargets(const utbot::CompileCommand &defaultCompileCommand,
                              const fs::path &gtestBuildDir);
 
@@ -85,6 +99,15 @@ namespace printer {
         void addStubs(const CollectionUtils::FileSet &stubsSet);
 
         void tryChangeToRelativePath(std::string& argument) const;
+
+        /// number of compiler configurations whose gtest objects are kept
+        static const size_t GTEST_CACHE_CAPACITY = 8;
+
+        /**
+         * Removes gtest objects of the least recently used configurations above the capacity.
+         * Makefiles of running requests may use any configuration, so it is called at server start only.
+         */
+        static void trimGtestCache(const fs::path &cacheDirectory);
     };
 }
 
@@ -10,6 +10,8 @@
 
 #include "loguru.h"
 
+#include <algorithm>
+
 namespace printer {
     using StringUtils::stringFormat;
 
@@ -26,6 +28,27 @@ namespace printer {
         tabsDepth = 0;
     }
 
+    const std::string &printer::Printer::LINE_INDENT() const {
+        static const int CACHED_INDENTS = 32;
+        static const auto indents = [] {
+            std::vector<std::string> result;
+            for (int depth = 0; depth < CACHED_INDENTS; ++depth) {
+                result.push_back(StringUtils::repeat(TAB, depth));
+            }
+            for (int depth = 0; depth < CACHED_INDENTS; ++depth) {
+                result.push_back(StringUtils::repeat(TAB, depth) + "// ");
+            }
+            return result;
+        }();
+        int depth = std::max(0, tabsDepth);
+        bool inComment = commentDepth > 0;
+        if (depth < CACHED_INDENTS) {
+            return indents[depth + (inComment ? CACHED_INDENTS : 0)];
+        }
+        deepIndent = StringUtils::repeat(TAB, depth) + (inComment ? "// " : "");
+        return deepIndent;
+    }
+
     std::string printer::Printer::LB(bool startsWithSpace) {
         tabsDepth++;
         return std::string(startsWithSpace ? " " : "") + "{\n";
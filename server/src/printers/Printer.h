@@ -11,6 +11,8 @@
 #include <cstdio>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -50,12 +52,11 @@ namespace printer {
 
         std::string RB(bool needSC = false);
 
-        inline std::string LINE_INDENT() const {
-            std::string tabs = StringUtils::repeat(TAB, tabsDepth);
-            return commentDepth <= 0
-                   ? tabs
-                   : tabs + "// ";
-        }
+        /**
+         * Returns indentation for the current tabsDepth and commentDepth.
+         * Indentations of reasonable depth are built once and shared by all printers.
+         */
+        const std::string &LINE_INDENT() const;
 
         // all functions which return std::stringstream start with `str` prefix.
         // all functions which return std::string start with `constr` prefix.
@@ -165,9 +166,9 @@ namespace printer {
 
         template<typename... Args>
         static std::string concat(Args &&... args) {
-            std::stringstream cc_ss;
-            (cc_ss << ... << args);
-            return cc_ss.str();
+            std::string result;
+            (appendToString(result, args), ...);
+            return result;
         }
 
         [[nodiscard]] std::string recursiveIteratorName(SRef prefix) const;
@@ -242,6 +243,23 @@ namespace printer {
         void genTearDownCall(const tests::Tests::MethodDescription &testMethod);
 
     private:
+        mutable std::string deepIndent;
+
+        template<typename T>
+        static void appendToString(std::string &result, const T &arg) {
+            if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+                result.append(std::string_view(arg));
+            } else if constexpr (std::is_same_v<T, char>) {
+                result.push_back(arg);
+            } else if constexpr (std::is_integral_v<T> && sizeof(T) > sizeof(char)) {
+                result.append(std::to_string(arg));
+            } else {
+                std::stringstream cc_ss;
+                cc_ss << arg;
+                result.append(cc_ss.str());
+            }
+        }
+
         Stream strMemcpyImpl(std::string_view dest, std::string_view src, bool needDereference);
 
         void printAlignmentIfExists(const std::optional<uint64_t> &alignment);
@@ -1,7 +1,6 @@
 #include "StubsPrinter.h"
 
 #include "Paths.h"
-#include "utils/TimeUtils.h"
 
 using printer::StubsPrinter;
 
@@ -14,11 +13,6 @@ Stubs printer::StubsPrinter::genStubFile(const tests::Tests &tests,
     resetStream();
     Stubs stubFile;
     stubFile.filePath = Paths::sourcePathToStubPath(projectContext, tests.sourceFilePath);
-    long long creationTime = TimeUtils::convertFileToSystemClock(fs::file_time_type::clock::now())
-                                 .time_since_epoch()
-                                 .count();
-    strComment(std::to_string(creationTime));
-    strComment("Please, do not change the line above") << printer::NL;
     writeCopyrightHeader();
     ss << "#ifdef " << PrinterUtils::KLEE_MODE << printer::NL;
     ss << LINE_INDENT() << "extern void klee_make_symbolic(void *addr, unsigned long long nbytes, const char *name);" << printer::NL;
@@ -21,13 +21,16 @@ namespace printer {
         FileSystemUtils::writeToFile(sharedMakefilePath, sharedMakefileContent);
         fs::path objMakefilePath = getMakefilePathForObject(path);
         FileSystemUtils::writeToFile(objMakefilePath, objMakefileContent);
+        FileSystemUtils::writeToFile(Paths::getRunManifestPath(path), runManifestContent);
     }
 
     TestMakefilesContent::TestMakefilesContent(fs::path path, std::string generalMakefileStr,
                                                std::string sharedMakefileStr,
-                                               std::string objMakefileStr) :
+                                               std::string objMakefileStr,
+                                               std::string runManifestStr) :
             path(std::move(path)), generalMakefileContent(std::move(generalMakefileStr)),
-            sharedMakefileContent(std::move(sharedMakefileStr)), objMakefileContent(std::move(objMakefileStr)) {
+            sharedMakefileContent(std::move(sharedMakefileStr)), objMakefileContent(std::move(objMakefileStr)),
+            runManifestContent(std::move(runManifestStr)) {
     }
 
     TestMakefilesPrinter::TestMakefilesPrinter(const BaseTestGen *testGen,
@@ -121,9 +124,16 @@ namespace printer {
                         MakefileUtils::getMakeCommand(objMakefilePathRelative, "clean", true), " ")
         });
 
+        NativeMakefilePrinter sharedPrinter(sharedMakefilePrinter, sourcePath);
+        NativeMakefilePrinter objPrinter(objMakefilePrinter, sourcePath);
+        // variants are listed in the order the run target tries them
+        nlohmann::json runManifest = {
+                { "variants", { sharedPrinter.runManifestEntry, objPrinter.runManifestEntry } } };
+
         return {generalMakefilePath,
                 generalMakefilePrinter.ss.str(),
-                NativeMakefilePrinter(sharedMakefilePrinter, sourcePath).ss.str(),
-                NativeMakefilePrinter(objMakefilePrinter, sourcePath).ss.str()};
+                sharedPrinter.ss.str(),
+                objPrinter.ss.str(),
+                runManifest.dump(4)};
     }
 }
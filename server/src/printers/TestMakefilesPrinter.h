@@ -11,10 +11,12 @@ namespace printer {
         std::string generalMakefileContent;
         std::string sharedMakefileContent;
         std::string objMakefileContent;
+        std::string runManifestContent;
 
     public:
         TestMakefilesContent(fs::path path, std::string generalMakefileStr,
-                             std::string sharedMakefileStr, std::string objMakefileStr);
+                             std::string sharedMakefileStr, std::string objMakefileStr,
+                             std::string runManifestStr);
 
         void write() const;
     };
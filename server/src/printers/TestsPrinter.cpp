@@ -84,9 +84,14 @@ void TestsPrinter::joinToFinalCode(Tests &tests, const fs::path& generatedHeader
 
 void TestsPrinter::printFinalCodeAndAlterJson(Tests &tests) {
     int line_count = 0;
-    std::string line;
-    while (getline(ss, line)) {
-        if (line.rfind(sarif::PREFIX_FOR_JSON_PATH, 0) != 0) {
+    const std::string text = ss.str();
+    tests.code.reserve(tests.code.size() + text.size() + 1);
+    size_t lineStart = 0;
+    while (lineStart < text.size()) {
+        size_t lineEnd = std::min(text.find('\n', lineStart), text.size());
+        std::string_view line(text.data() + lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+        if (!StringUtils::startsWith(line, sarif::PREFIX_FOR_JSON_PATH)) {
             // ordinal string
             tests.code.append(line);
             tests.code.append("\n");
@@ -94,7 +99,7 @@ void TestsPrinter::printFinalCodeAndAlterJson(Tests &tests) {
         } else {
             // anchor for SARIF
             std::string nameAndTestIndex =
-                line.substr(sarif::PREFIX_FOR_JSON_PATH.size());
+                std::string(line.substr(sarif::PREFIX_FOR_JSON_PATH.size()));
             size_t pos = nameAndTestIndex.find(',');
             if (pos != std::string::npos) {
                 std::string name = nameAndTestIndex.substr(0, pos);
@@ -367,7 +372,7 @@ void TestsPrinter::printStubVariablesForParam(const Tests::MethodDescription &me
         types::Type stubType = testCase.stubParamTypes[i].type;
         std::string bufferSuffix = "_buffer";
         std::string buffer = stub.name + bufferSuffix;
-        strDeclareArrayVar(stubType, buffer, types::PointerUsage::PARAMETER, stub.view->getEntryValue(this));
+        strDeclareArrayVar(stubType, buffer, types::PointerUsage::PARAMETER, getSizedArrayEntryValue(*stub.view));
         strMemcpy(stub.name, buffer, false);
     }
 }
@@ -672,6 +677,13 @@ void TestsPrinter::globalParamsAsserts(const Tests::MethodDescription &methodDes
     }
 }
 
+std::string TestsPrinter::getSizedArrayEntryValue(const tests::AbstractValueView &view) {
+    if (const auto *arrayView = dynamic_cast<const tests::PrimitiveArrayValueView *>(&view)) {
+        return arrayView->getEntryValue(this, true);
+    }
+    return view.getEntryValue(this);
+}
+
 void TestsPrinter::printPointerParameter(const Tests::MethodDescription &methodDescription,
                                          const Tests::MethodTestCase &testCase,
                                          int param_num) {
@@ -698,7 +710,7 @@ void TestsPrinter::printPointerParameter(const Tests::MethodDescription &methodD
             auto paramName =
                 param.type.isTwoDimensionalPointer() ? param.underscoredName() : param.name;
             strDeclareArrayVar(arrayType, paramName, types::PointerUsage::PARAMETER,
-                               value.view->getEntryValue(this), param.alignment, true);
+                               getSizedArrayEntryValue(*value.view), param.alignment, true);
         }
     }
     if (param.type.isTwoDimensionalPointer()) {
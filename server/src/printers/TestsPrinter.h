@@ -124,6 +124,9 @@ namespace printer {
 
         static bool paramNeedsMathHeader(const Tests::TestCaseParamValue &paramValue);
 
+        /// value of an array declared with explicit sizes, so elements left out of it are zero-filled
+        std::string getSizedArrayEntryValue(const tests::AbstractValueView &view);
+
         void
         parametrizedInitializeGlobalVariables(const Tests::MethodDescription &methodDescription,
                                               const Tests::MethodTestCase &testCase);
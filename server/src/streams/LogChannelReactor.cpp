@@ -0,0 +1,89 @@
+#include "LogChannelReactor.h"
+
+#include "utils/StringUtils.h"
+
+#include "loguru.h"
+
+LogChannelReactor::LogChannelReactor(uint32_t clientIndex,
+                                     std::function<void()> unregister,
+                                     std::function<void(LogChannelReactor *)> onDone)
+    : clientIndex(clientIndex), entries(BUFFER_CAPACITY), unregister(std::move(unregister)),
+      onDone(std::move(onDone)) {
+}
+
+void LogChannelReactor::push(std::string entry) {
+    entries.push(std::move(entry));
+    acquireAndSend();
+}
+
+void LogChannelReactor::close() {
+    unregisterOnce();
+    closing.store(true);
+    acquireAndSend();
+}
+
+void LogChannelReactor::OnWriteDone(bool ok) {
+    if (!ok) {
+        broken.store(true);
+    }
+    sendNext();
+}
+
+void LogChannelReactor::OnCancel() {
+    broken.store(true);
+    acquireAndSend();
+}
+
+void LogChannelReactor::OnDone() {
+    unregisterOnce();
+    // the owner may delete the reactor together with the callback while it runs
+    auto done = std::move(onDone);
+    done(this);
+}
+
+void LogChannelReactor::unregisterOnce() {
+    if (!unregistered.exchange(true)) {
+        unregister();
+    }
+}
+
+void LogChannelReactor::acquireAndSend() {
+    // pairs with the fence in sendNext: either the owner sees new entries, or we see it has left
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!writing.exchange(true)) {
+        sendNext();
+    }
+}
+
+void LogChannelReactor::sendNext() {
+    std::string message;
+    while (true) {
+        if (!broken.load()) {
+            if (size_t dropped = entries.takeDroppedCount(); dropped > 0) {
+                currentEntry.set_message(StringUtils::stringFormat(
+                    "%zu log entries were dropped, because the client doesn't keep up\n", dropped));
+                StartWrite(&currentEntry);
+                return;
+            }
+            if (entries.tryPop(message)) {
+                currentEntry.set_message(std::move(message));
+                StartWrite(&currentEntry);
+                return;
+            }
+        }
+        if (closing.load() || broken.load()) {
+            // writing is never released, so nobody touches the stream after Finish
+            Finish(grpc::Status::OK);
+            return;
+        }
+        writing.store(false);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        // an entry pushed after the check above could have seen the stream busy
+        if (entries.empty() && !closing.load() && !broken.load()) {
+            return;
+        }
+        if (writing.exchange(true)) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef UNITTESTBOT_LOGCHANNELREACTOR_H
+#define UNITTESTBOT_LOGCHANNELREACTOR_H
+
+#include "utils/LogRingBuffer.h"
+
+#include <grpcpp/grpcpp.h>
+#include <protobuf/testgen.grpc.pb.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/**
+ * Streams log entries of a client via gRPC callback API, so that an open
+ * channel doesn't occupy a server thread. Logging threads only put entries
+ * to the buffer; the next write is started by whoever finds the stream idle.
+ */
+class LogChannelReactor : public grpc::ServerWriteReactor<testsgen::LogEntry> {
+public:
+    /**
+     * @param unregister removes the loguru callbacks which push to the reactor. It is called
+     * once: by close() before the RPC is finished, or by OnDone if the client has gone.
+     * @param onDone is called once the RPC is completed and must release the owner of the
+     * reactor, so nothing may use the reactor after it.
+     */
+    LogChannelReactor(uint32_t clientIndex,
+                      std::function<void()> unregister,
+                      std::function<void(LogChannelReactor *)> onDone);
+
+    const uint32_t clientIndex;
+
+    /**
+     * Never blocks, so it can be called from loguru callbacks.
+     */
+    void push(std::string entry);
+
+    /**
+     * Stops logging to the client, sends the buffered entries and completes the RPC.
+     * Must not be called from loguru callbacks.
+     */
+    void close();
+
+    void OnWriteDone(bool ok) override;
+
+    void OnCancel() override;
+
+    void OnDone() override;
+
+private:
+    const static size_t BUFFER_CAPACITY = 4096;
+
+    LogRingBuffer entries;
+    testsgen::LogEntry currentEntry;
+    /// set while a write is in flight or is being started, owner is the only one who writes
+    std::atomic_bool writing = false;
+    std::atomic_bool closing = false;
+    std::atomic_bool broken = false;
+    std::atomic_bool unregistered = false;
+    std::function<void()> unregister;
+    std::function<void(LogChannelReactor *)> onDone;
+
+    void unregisterOnce();
+
+    void acquireAndSend();
+
+    void sendNext();
+};
+
+
+#endif // UNITTESTBOT_LOGCHANNELREACTOR_H
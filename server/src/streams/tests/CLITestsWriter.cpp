@@ -24,10 +24,10 @@ void CLITestsWriter::writeTestsWithProgress(tests::TestsMap &testMap,
     LOG_S(INFO) << "total test files generated: " << totalTestsCounter;
 }
 
-void CLITestsWriter::writeReport(const std::string &content,
+void CLITestsWriter::writeReport(const fs::path &reportPath,
                                  const std::string &message,
                                  const fs::path &pathToStore) const {
-    TestsWriter::writeReport(content, message, pathToStore);
+    TestsWriter::writeReport(reportPath, message, pathToStore);
     LOG_S(INFO) << message;
 }
 
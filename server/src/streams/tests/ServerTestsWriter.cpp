@@ -6,6 +6,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <iterator>
 
 void ServerTestsWriter::writeTestsWithProgress(tests::TestsMap &testMap,
                                                const std::string &message,
@@ -65,19 +66,20 @@ bool ServerTestsWriter::writeFileAndSendResponse(const tests::Tests &tests,
     return isAnyTestsGenerated;
 }
 
-void ServerTestsWriter::writeReport(const std::string &content,
+void ServerTestsWriter::writeReport(const fs::path &reportPath,
                                     const std::string &message,
                                     const fs::path &pathToStore) const
 {
     testsgen::TestsResponse response;
-    TestsWriter::writeReport(content, message, pathToStore);
+    TestsWriter::writeReport(reportPath, message, pathToStore);
 
     auto testSource = response.add_testsources();
     testSource->set_filepath(pathToStore);
     if (synchronizeCode) {
         // write the content only for real data transfer
         // `synchronizeCode` is false if client and server share the same FS
-        testSource->set_code(content);
+        std::ifstream report(pathToStore);
+        testSource->set_code(std::string(std::istreambuf_iterator<char>(report), std::istreambuf_iterator<char>()));
     }
     LOG_S(INFO) << message;
     auto progress = GrpcUtils::createProgress(message, 100, false);
@@ -19,7 +19,7 @@ public:
                                 std::function<void(tests::Tests &)> &&prepareTests,
                                 std::function<void()> &&prepareTotal) override;
 
-    void writeReport(const std::string &content,
+    void writeReport(const fs::path &reportPath,
                      const std::string &message,
                      const fs::path &pathToStore) const override;
 
@@ -18,7 +18,7 @@ void TestsWriter::writeCompleted(const tests::TestsMap &testMap, int totalTestsC
     writeProgress(finalMessage, 100.0, true);
 }
 
-void TestsWriter::writeReport(const std::string &content,
+void TestsWriter::writeReport(const fs::path &reportPath,
                               const std::string &message,
                               const fs::path &pathToStore) const
 {
@@ -29,7 +29,13 @@ void TestsWriter::writeReport(const std::string &content,
                      << ": problem in `writeReport` with "
                      << pathToStore;
     }
-    FileSystemUtils::writeToFile(pathToStore, content);
+    fs::create_directories(pathToStore.parent_path());
+    std::error_code ec;
+    std::filesystem::rename(reportPath.string(), pathToStore.string(), ec);
+    if (ec) {
+        // the report is written on another file system
+        FileSystemUtils::copyFile(reportPath, pathToStore);
+    }
 }
 
 template <typename TP>
@@ -20,7 +20,10 @@ public:
                                         std::function<void(tests::Tests &)> &&prepareTests,
                                         std::function<void()> &&prepareTotal) = 0;
 
-    virtual void writeReport(const std::string &content,
+    /**
+     * Moves the written report to its place, the previous report is kept as a backup.
+     */
+    virtual void writeReport(const fs::path &reportPath,
                              const std::string &message,
                              const fs::path &pathToStore) const;
 
@@ -27,12 +27,16 @@ CollectionUtils::FileSet
 StubGen::findStubFilesBySignatures(const std::vector<tests::Tests::MethodDescription> &signatures) {
     fs::path ccJsonDirPath =
             Paths::getUTBotBuildDir(testGen.projectContext) / "stubs_build_files";
-    auto stubFiles = Paths::findFilesInFolder(Paths::getStubsDirPath(testGen.projectContext));
-    stubFiles = Synchronizer::dropHeaders(stubFiles);
-    CollectionUtils::erase_if(stubFiles, [this](fs::path const &stubPath) {
-        fs::path sourcePath = Paths::stubPathToSourcePath(testGen.projectContext, stubPath);
-        return CollectionUtils::contains(testGen.targetSources, sourcePath);
-    });
+    auto index = SynchronizationIndex::getInstance(Paths::getSynchronizationIndexPath(testGen.projectContext));
+    CollectionUtils::FileSet stubFiles;
+    for (const auto &signature : signatures) {
+        for (const fs::path &stubPath : index->findArtifactsBySymbol(signature.name)) {
+            fs::path sourcePath = Paths::stubPathToSourcePath(testGen.projectContext, stubPath);
+            if (!CollectionUtils::contains(testGen.targetSources, sourcePath)) {
+                stubFiles.insert(stubPath);
+            }
+        }
+    }
     if (stubFiles.empty()) {
         return {};
     }
@@ -42,27 +46,27 @@ StubGen::findStubFilesBySignatures(const std::vector<tests::Tests::MethodDescrip
     for (const auto &file : stubFiles) {
         stubFilesMap[file].sourceFilePath = file;
     }
+    // only stubs defining requested functions are parsed to get their return types
     Fetcher::Options::Value options = Fetcher::Options::Value::RETURN_TYPE_NAMES_ONLY;
     Fetcher fetcher(options, stubsCdb, stubFilesMap, nullptr, nullptr, ccJsonDirPath, true);
     fetcher.fetchWithProgress(testGen.progressWriter, "Finding stub files", true);
-    CollectionUtils::FileSet stubFilesSet;
     auto signatureNamesSet = CollectionUtils::transformTo<std::unordered_set<std::string>>(
             signatures,
             [&](const tests::Tests::MethodDescription &signature) { return signature.name; });
     for (const auto &[filePath, stub]: stubFilesMap) {
         for (const auto &[methodName, methodDescription]: stub.methods) {
             if (CollectionUtils::contains(signatureNamesSet, methodName)) {
-                stubFilesSet.insert(filePath);
                 auto stubInfo = std::make_shared<types::FunctionInfo>(methodDescription.toFunctionInfo());
-                for (auto &[_, tests]: testGen.tests) {
-                    for (auto &[_, method]: tests.methods) {
-                        method.stubsStorage->registerStub("", stubInfo, ((fs::path) filePath).replace_extension(".h"));
-                    }
-                }
+                testGen.stubsStorage->registerStub("", stubInfo, ((fs::path) filePath).replace_extension(".h"));
             }
         }
     }
-    return stubFilesSet;
+    for (auto &[_, tests]: testGen.tests) {
+        for (auto it = tests.methods.begin(); it != tests.methods.end(); it++) {
+            it.value().stubsStorage = testGen.stubsStorage;
+        }
+    }
+    return stubFiles;
 }
 
 
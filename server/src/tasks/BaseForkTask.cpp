@@ -26,6 +26,8 @@ public:
     }
 };
 
+std::atomic<uint64_t> BaseForkTask::spawnedProcessesCount = 0;
+
 BaseForkTask::BaseForkTask(std::string processName,
                            const std::optional<std::chrono::seconds> &timeout,
                            fs::path logFilePath,
@@ -38,6 +40,7 @@ BaseForkTask::BaseForkTask(std::string processName,
 
 ExecUtils::ExecutionResult BaseForkTask::run() {
     grpc_prefork();
+    spawnedProcessesCount++;
     switch (pid = fork()) {
         case -1: {
             auto message = processName + " fork failed.";
@@ -89,6 +92,10 @@ bool BaseForkTask::wasInterrupted(int exitCode) {
     return (exitCode == TIMEOUT_CODE);
 }
 
+uint64_t BaseForkTask::getSpawnedProcessesCount() {
+    return spawnedProcessesCount.load();
+}
+
 void BaseForkTask::timeoutMessage() const {
 }
 
@@ -7,6 +7,8 @@
 #include <protobuf/testgen.grpc.pb.h>
 #include <run_klee/run_klee.h>
 
+#include <atomic>
+
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
@@ -34,6 +36,11 @@ public:
      * @param exitCode - the task exit code.
      */
     static bool wasInterrupted(int exitCode);
+    /**
+     * @brief Number of child processes forked by all the tasks
+     * since the server start. Used for performance statistics.
+     */
+    static uint64_t getSpawnedProcessesCount();
 protected:
     explicit BaseForkTask(std::string processName,
                           const std::optional<std::chrono::seconds> &timeout,
@@ -163,6 +170,8 @@ protected:
      * Throws if the watched child process is absent.
      */
     static void throwIfNoSuchProcess();
+private:
+    static std::atomic<uint64_t> spawnedProcessesCount;
 };
 
 
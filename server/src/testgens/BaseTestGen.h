@@ -27,8 +27,9 @@ public:
 
     CollectionUtils::FileSet sourcePaths, testingMethodsSourcePaths;
     tests::TestsMap tests;
-    std::unordered_map<std::string, types::Type> methodNameToReturnTypeMap;
     std::vector<Stubs> synchronizedStubs;
+    /// stubs found for linked objects, shared by all tested methods
+    std::shared_ptr<StubsStorage> stubsStorage = std::make_shared<StubsStorage>();
     types::TypeMaps types;
 
     CollectionUtils::FileSet targetSources;
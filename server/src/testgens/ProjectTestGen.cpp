@@ -1,6 +1,7 @@
 #include "ProjectTestGen.h"
 
 #include "Paths.h"
+#include "SessionCache.h"
 #include "building/BuildDatabase.h"
 #include "exceptions/CompilationDatabaseException.h"
 #include "utils/CompilationUtils.h"
@@ -16,9 +17,9 @@ ProjectTestGen::ProjectTestGen(const testsgen::ProjectRequest &request,
                       testMode), request(&request) {
     fs::create_directories(projectContext.getTestDirAbsPath());
     compileCommandsJsonPath = CompilationUtils::substituteRemotePathToCompileCommandsJsonPath(projectContext);
-    projectBuildDatabase = std::make_shared<ProjectBuildDatabase>(compileCommandsJsonPath, serverBuildDir,
-                                                                  projectContext,
-                                                                  settingsContext.skipObjectWithoutSource);
+    projectBuildDatabase = SessionCache::getInstance().getProjectBuildDatabase(compileCommandsJsonPath, serverBuildDir,
+                                                                               projectContext,
+                                                                               settingsContext.skipObjectWithoutSource);
     if (sourceFile.has_value() && Paths::isSourceFile(sourceFile.value()) &&
         (request.targetpath() == GrpcUtils::UTBOT_AUTO_TARGET_PATH || request.targetpath().empty())) {
         targetBuildDatabase = std::make_shared<TargetBuildDatabase>(projectBuildDatabase.get(), sourceFile.value());
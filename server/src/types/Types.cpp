@@ -13,6 +13,33 @@
 
 #include <climits>
 
+static const std::unordered_map<std::string, types::PrimitiveKind> primitiveKinds = {
+    { "utbot_byte", types::PrimitiveKind::UTBOT_BYTE },
+    { "short", types::PrimitiveKind::SHORT },
+    { "int", types::PrimitiveKind::INT },
+    { "long", types::PrimitiveKind::LONG },
+    { "long long", types::PrimitiveKind::LONG_LONG },
+    { "unsigned short", types::PrimitiveKind::UNSIGNED_SHORT },
+    { "unsigned int", types::PrimitiveKind::UNSIGNED_INT },
+    { "unsigned long", types::PrimitiveKind::UNSIGNED_LONG },
+    { "unsigned long long", types::PrimitiveKind::UNSIGNED_LONG_LONG },
+    { "char", types::PrimitiveKind::CHAR },
+    { "signed char", types::PrimitiveKind::SIGNED_CHAR },
+    { "unsigned char", types::PrimitiveKind::UNSIGNED_CHAR },
+    { "bool", types::PrimitiveKind::BOOL },
+    { "_Bool", types::PrimitiveKind::BOOL },
+    { "float", types::PrimitiveKind::FLOAT },
+    { "double", types::PrimitiveKind::DOUBLE },
+    { "long double", types::PrimitiveKind::LONG_DOUBLE },
+    { "std::uintptr_t", types::PrimitiveKind::UINTPTR },
+    { "uintptr_t", types::PrimitiveKind::UINTPTR }
+};
+
+types::PrimitiveKind types::getPrimitiveKind(const TypeName &typeName) {
+    auto it = primitiveKinds.find(typeName);
+    return it == primitiveKinds.end() ? PrimitiveKind::NONE : it->second;
+}
+
 /*
  * class Type
  */
@@ -29,6 +56,7 @@ types::Type::Type(clang::QualType qualType, TypeName usedTypeName, const clang::
     mKinds = visitor.getKinds();
     dimension = getDimension();
     mBaseType = visitor.getTypes()[dimension];
+    mPrimitiveKind = getPrimitiveKind(mBaseType);
     mTypeId = getIdFromCanonicalType(canonicalType);
     AbstractType *baseType = mKinds[dimension].get();
     if (auto simpleType = dynamic_cast<SimpleType*>(baseType)) {
@@ -62,6 +90,7 @@ types::Type::Type(const types::TypeName& type, size_t pointersNum) {
     mUsedType = mType;
     dimension = pointersNum;
     mBaseType = type;
+    mPrimitiveKind = getPrimitiveKind(mBaseType);
     for (size_t i = 0; i < pointersNum; ++i) {
         mKinds.push_back(std::make_shared<ObjectPointerType>(false));
     }
@@ -84,6 +113,7 @@ types::Type types::Type::createArray(const types::Type &type) {
     res.mType = type.typeName() + "*";
     res.mUsedType = res.mType;
     res.mBaseType = type.baseType();
+    res.mPrimitiveKind = type.mPrimitiveKind;
     res.mKinds = type.mKinds;
     res.mKinds.insert(res.mKinds.begin(), std::shared_ptr<AbstractType>(new ArrayType(
         TypesHandler::getElementsNumberInPointerOneDim(PointerUsage::PARAMETER), false)));
@@ -106,6 +136,10 @@ types::TypeName types::Type::usedType() const {
     return mUsedType;
 }
 
+types::PrimitiveKind types::Type::primitiveKind() const {
+    return mPrimitiveKind;
+}
+
 types::Type types::Type::baseTypeObj(size_t depth) const {
     auto type = *this;
     type.mType = mBaseType;
@@ -396,6 +430,7 @@ void types::Type::replaceTypeNameIfUnnamed(const TypeName &newTypeName) {
     if (isUnnamed()) {
         mBaseType = newTypeName;
         mUsedType = newTypeName;
+        mPrimitiveKind = getPrimitiveKind(mBaseType);
     }
 }
 
@@ -556,22 +591,22 @@ bool types::TypesHandler::skipTypeInReturn(const Type& type) {
 /*
  * Get struct information
  */
-types::StructInfo types::TypesHandler::getStructInfo(const Type &type) const {
+const types::StructInfo &types::TypesHandler::getStructInfo(const Type &type) const {
     return getStructInfo(type.getId());
 }
 
-types::StructInfo types::TypesHandler::getStructInfo(uint64_t id) const {
+const types::StructInfo &types::TypesHandler::getStructInfo(uint64_t id) const {
     return typeFromMap<StructInfo>(id, typeMaps.structs);
 }
 
 /*
  * Get enum information
  */
-types::EnumInfo types::TypesHandler::getEnumInfo(const types::Type &type) const {
+const types::EnumInfo &types::TypesHandler::getEnumInfo(const types::Type &type) const {
     return getEnumInfo(type.getId());
 }
 
-types::EnumInfo types::TypesHandler::getEnumInfo(uint64_t id) const {
+const types::EnumInfo &types::TypesHandler::getEnumInfo(uint64_t id) const {
     return typeFromMap<EnumInfo>(id, typeMaps.enums);
 }
 
@@ -825,12 +860,14 @@ std::string types::TypesHandler::cBoolToCpp(const types::TypeName &type) {
 
 types::TypeSupport
 types::TypesHandler::isSupportedType(const Type &type, TypeUsage usage, int depth) const {
-    auto hashArgument = IsSupportedTypeArguments(type.typeName(), usage);
+    std::lock_guard<std::recursive_mutex> lock(cacheMutex);
+    uint32_t typeNameId = getTypeNameId(type.typeName());
+    uint64_t hashArgument = (static_cast<uint64_t>(typeNameId) << 32) | static_cast<uint32_t>(usage);
     auto writtenValue = isSupportedTypeHash.find(hashArgument);
     if (writtenValue != isSupportedTypeHash.end()) {
         return writtenValue->second;
     }
-    recursiveCheckStarted.insert(type.typeName());
+    recursiveCheckStarted.insert(typeNameId);
     using PredicateWithReason = std::pair<std::string, std::function<bool(Type, TypeUsage)>>;
     std::vector<PredicateWithReason> unsupportedPredicates = {
         {
@@ -843,7 +880,7 @@ types::TypesHandler::isSupportedType(const Type &type, TypeUsage usage, int dept
             "Type has flexible array member",
             [&](const Type &type, TypeUsage usage) {
               if (isStructLike(type)) {
-                  auto structInfo = getStructInfo(type);
+                  const auto &structInfo = getStructInfo(type);
                   if (structInfo.fields.empty()) {
                       return false;
                   }
@@ -890,7 +927,7 @@ types::TypesHandler::isSupportedType(const Type &type, TypeUsage usage, int dept
             [&](const Type &type, TypeUsage usage) {
               auto unsupportedFields = [&](const std::vector<types::Field> &fields) {
                 return std::any_of(fields.begin(), fields.end(), [&](const types::Field &field) {
-                  if (!CollectionUtils::contains(recursiveCheckStarted, field.type.typeName())) {
+                  if (!CollectionUtils::contains(recursiveCheckStarted, getTypeNameId(field.type.typeName()))) {
                       if (field.type.isObjectPointer()) {
                           return false;
                       }
@@ -902,8 +939,7 @@ types::TypesHandler::isSupportedType(const Type &type, TypeUsage usage, int dept
                 });
               };
               if (isStructLike(type)) {
-                  auto structInfo = getStructInfo(type);
-                  return unsupportedFields(structInfo.fields);
+                  return unsupportedFields(getStructInfo(type).fields);
               }
               return false;
             }
@@ -924,28 +960,25 @@ types::TypesHandler::isSupportedType(const Type &type, TypeUsage usage, int dept
 
     for (const auto &[reason, predicate]: unsupportedPredicates) {
         if (predicate(type, usage)) {
-            recursiveCheckStarted.erase(type.typeName());
+            recursiveCheckStarted.erase(typeNameId);
             return {false, reason};
         }
     }
-    recursiveCheckStarted.erase(type.typeName());
+    recursiveCheckStarted.erase(typeNameId);
     types::TypeSupport result = {true, ""};
-    isSupportedTypeHash[IsSupportedTypeArguments(hashArgument)] = result;
+    isSupportedTypeHash[hashArgument] = result;
     return result;
 }
 
-
-types::TypesHandler::IsSupportedTypeArguments::IsSupportedTypeArguments(types::TypeName typeName,
-                                                                        types::TypeUsage usage)
-    : typeName(std::move(typeName)), usage(usage) {
-}
-
-bool types::TypesHandler::IsSupportedTypeArguments::operator==(const types::TypesHandler::IsSupportedTypeArguments &other) const {
-    return typeName == other.typeName && usage == other.usage;
-}
-
-std::size_t types::TypesHandler::IsSupportedTypeArgumentsHash::operator()(const types::TypesHandler::IsSupportedTypeArguments &args) const {
-    return fs::hash_value(args.typeName + std::to_string((int)args.usage));
+uint32_t types::TypesHandler::getTypeNameId(const types::TypeName &typeName) const {
+    std::lock_guard<std::recursive_mutex> lock(cacheMutex);
+    auto it = typeNameIds.find(typeName);
+    if (it != typeNameIds.end()) {
+        return it->second;
+    }
+    auto id = static_cast<uint32_t>(typeNameIds.size());
+    typeNameIds.emplace(typeName, id);
+    return id;
 }
 
 types::Type types::TypesHandler::getReturnTypeToCheck(const types::Type &returnType) const {
@@ -13,6 +13,7 @@
 #include <tsl/ordered_set.h>
 
 #include <cstddef>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -33,6 +34,38 @@ namespace types {
         AS_none
     };
 
+    /**
+     * C types whose values are decoded directly from ktest bytes.
+     * Resolved once from the base type name, so printing a value
+     * does not need to compare type names again.
+     */
+    enum class PrimitiveKind {
+        NONE,
+        UTBOT_BYTE,
+        SHORT,
+        INT,
+        LONG,
+        LONG_LONG,
+        UNSIGNED_SHORT,
+        UNSIGNED_INT,
+        UNSIGNED_LONG,
+        UNSIGNED_LONG_LONG,
+        CHAR,
+        SIGNED_CHAR,
+        UNSIGNED_CHAR,
+        BOOL,
+        FLOAT,
+        DOUBLE,
+        LONG_DOUBLE,
+        UINTPTR,
+        COUNT
+    };
+
+    /**
+     * @return primitive kind that corresponds to typeName or PrimitiveKind::NONE.
+     */
+    PrimitiveKind getPrimitiveKind(const TypeName &typeName);
+
     class Type {
     public:
         Type() = default;
@@ -55,6 +88,11 @@ namespace types {
          */
         [[nodiscard]] TypeName usedType() const;
 
+        /**
+         * @return primitive kind of baseType(), PrimitiveKind::NONE if it is not primitive.
+         */
+        [[nodiscard]] PrimitiveKind primitiveKind() const;
+
         /**
          * Returns vector that stores information about type:
          * pointers/arrays that were applied in the right order.
@@ -273,6 +311,7 @@ namespace types {
         size_t dimension;
         std::optional<uint64_t> mTypeId;
         std::optional<uint64_t> mBaseTypeId;
+        PrimitiveKind mPrimitiveKind = PrimitiveKind::NONE;
 
     public:
         uint64_t getId() const;
@@ -541,22 +580,22 @@ namespace types {
         /**
          * Returns StructInfo by given struct name.
          * For safe usage, please use isStructLike(..) before calling getStructInfo(..).
-         * @return StructInfo for given struct.
+         * @return StructInfo for given struct, which lives as long as the type maps.
          */
-        StructInfo getStructInfo(const Type&) const;
+        const StructInfo &getStructInfo(const Type&) const;
 
         /**
          * Returns EnumInfo bu given enum name.
          * Fir safe usage, please use isEnum(..) before calling getEnumInfo(..).
-         * @return EnumInfo for given enum.
+         * @return EnumInfo for given enum, which lives as long as the type maps.
          */
-        EnumInfo getEnumInfo(const Type&) const;
+        const EnumInfo &getEnumInfo(const Type&) const;
 
         bool isStructLike(uint64_t id) const;
         bool isEnum(uint64_t id) const;
 
-        [[nodiscard]] StructInfo getStructInfo(uint64_t id) const;
-        [[nodiscard]] EnumInfo getEnumInfo(uint64_t id) const;
+        [[nodiscard]] const StructInfo &getStructInfo(uint64_t id) const;
+        [[nodiscard]] const EnumInfo &getEnumInfo(uint64_t id) const;
 
         /**
          * Returns map of constraints for every supported primitive type, that might be used in
@@ -640,24 +679,22 @@ namespace types {
          */
         static std::string removeArrayBrackets(TypeName type);
 
-        struct IsSupportedTypeArguments {
-            IsSupportedTypeArguments(TypeName typeName, TypeUsage usage);
-            const TypeName typeName;
-            types::TypeUsage usage;
-            bool operator==(const IsSupportedTypeArguments & other) const;
-        };
-        struct IsSupportedTypeArgumentsHash {
-            std::size_t operator()(const IsSupportedTypeArguments &args) const;
-        };
-
     private:
         const TypeMaps &typeMaps;
         SizeContext sizeContext;
-        mutable tsl::ordered_set<TypeName> recursiveCheckStarted{};
-        mutable std::unordered_map<IsSupportedTypeArguments,
-                                   types::TypeSupport,
-                                   IsSupportedTypeArgumentsHash>
-            isSupportedTypeHash{};
+        /**
+         * Guards the caches below: one handler is shared by the threads of a request,
+         * e.g. by workers of TestHeadersGenerator. It is recursive, because isSupportedType
+         * checks fields and base types while holding it.
+         */
+        mutable std::recursive_mutex cacheMutex;
+        /// type names are interned once, so that checks below are keyed by integers
+        mutable std::unordered_map<TypeName, uint32_t> typeNameIds{};
+        mutable std::unordered_set<uint32_t> recursiveCheckStarted{};
+        /// maps (type name id, usage) to the result of isSupportedType
+        mutable std::unordered_map<uint64_t, types::TypeSupport> isSupportedTypeHash{};
+
+        uint32_t getTypeNameId(const TypeName &typeName) const;
 
         template<typename T>
         bool typeIsInMap(uint64_t id, const std::unordered_map<uint64_t, T>& someMap) const {
@@ -668,9 +705,10 @@ namespace types {
         }
 
         template<typename T>
-        T typeFromMap(uint64_t id, const std::unordered_map<uint64_t, T>& someMap) const {
-            if (CollectionUtils::containsKey(someMap, id)) {
-                return someMap.at(id);
+        const T &typeFromMap(uint64_t id, const std::unordered_map<uint64_t, T>& someMap) const {
+            auto it = someMap.find(id);
+            if (it != someMap.end()) {
+                return it->second;
             }
             std::string message = StringUtils::stringFormat("Type with id=%llu can't be found.", id);
             LOG_S(ERROR) << message;
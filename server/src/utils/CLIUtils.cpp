@@ -64,7 +64,8 @@ createSettingsContextByOptions(const SettingsContextOptionGroup &settingsContext
             settingsContextOptionGroup.withStubs(),
             settingsContextOptionGroup.getErrorMode(),
             settingsContextOptionGroup.doDifferentVariablesOfTheSameType(),
-            settingsContextOptionGroup.getSkipObjectWithoutSource());
+            settingsContextOptionGroup.getSkipObjectWithoutSource(),
+            settingsContextOptionGroup.isIncrementalGeneration());
 }
 
 std::vector<fs::path> getSourcePaths(const ProjectContextOptionGroup &projectContextOptions,
@@ -131,7 +132,8 @@ void CLIUtils::parse(int argc, char **argv, CLI::App &app) {
 
         auto target = generateCommandsOptions.getTarget();
         auto projectRequest = GrpcUtils::createProjectRequest(
-                std::move(projectContext), std::move(settingsContext), sourcePaths, target);
+                std::move(projectContext), std::move(settingsContext), sourcePaths, target,
+                generateCommandsOptions.isResume(), generateCommandsOptions.isJournal());
 
         if (generateCommands.gotProjectCommand()) {
             createTestsAndWriteStatus<ProjectTestGen, ProjectRequest>(projectRequest.get(),
@@ -234,7 +236,8 @@ void CLIUtils::parse(int argc, char **argv, CLI::App &app) {
         auto target = allCommandsOptions.getTarget();
         auto projectRequest = GrpcUtils::createProjectRequest(
                 std::move(createProjectContextByOptions(projectAllContext)),
-                std::move(createSettingsContextByOptions(settingsAllContext)), sourcePaths, target);
+                std::move(createSettingsContextByOptions(settingsAllContext)), sourcePaths, target,
+                allCommandsOptions.isResume(), allCommandsOptions.isJournal());
         auto [testGen, statusTests] =
                 createTestsByRequest<ProjectTestGen, ProjectRequest>(*projectRequest, ctx.get());
         if (!statusTests.error_message().empty()) {
@@ -10,6 +10,8 @@
 #include "loguru.h"
 
 #include <fstream>
+#include <map>
+#include <mutex>
 
 namespace CompilationUtils {
     std::shared_ptr<CompilationDatabase>
@@ -193,6 +195,23 @@ namespace CompilationUtils {
         }
     }
 
+    std::string getCompilerVersion(const fs::path &compilerPath) {
+        static std::mutex mutex;
+        static std::map<fs::path, std::string> versions;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = versions.find(compilerPath);
+        if (it == versions.end()) {
+            std::string command = StringUtils::stringFormat("%s --version", compilerPath);
+            auto [output, status, outPath] = ShellExecTask::runPlainShellCommand(command);
+            if (status != 0) {
+                LOG_S(WARNING) << "Command for detecting compiler version failed: " << command;
+                output.clear();
+            }
+            it = versions.emplace(compilerPath, std::move(output)).first;
+        }
+        return it->second;
+    }
+
     std::optional<fs::path> getResourceDirectory(const fs::path &buildCompilerPath) {
         auto compilerName = CompilationUtils::getCompilerName(buildCompilerPath);
         switch (compilerName) {
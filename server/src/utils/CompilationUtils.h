@@ -52,6 +52,12 @@ namespace CompilationUtils {
 
     std::optional<fs::path> getResourceDirectory(const fs::path& buildCompilerPath);
 
+    /**
+     * @return output of `--version` of the compiler, which is asked once per server run,
+     * or empty string if the compiler can't be run
+     */
+    std::string getCompilerVersion(const fs::path &compilerPath);
+
     std::string getIncludePath(const fs::path &includePath);
 }
 
@@ -0,0 +1,31 @@
+#include "FairSemaphore.h"
+
+FairSemaphore::FairSemaphore(std::size_t slots) : available(slots) {
+}
+
+void FairSemaphore::lock() {
+    std::unique_lock lk(mutex);
+    const std::size_t request = next++;
+    while (request != curr || available == 0) {
+        cv.wait(lk);
+    }
+    --available;
+    ++curr;
+    cv.notify_all();
+}
+
+bool FairSemaphore::try_lock() {
+    std::lock_guard lk(mutex);
+    if (next != curr || available == 0)
+        return false;
+    --available;
+    ++next;
+    ++curr;
+    return true;
+}
+
+void FairSemaphore::unlock() {
+    std::lock_guard lk(mutex);
+    ++available;
+    cv.notify_all();
+}
@@ -0,0 +1,34 @@
+#ifndef UNITTESTBOT_FAIRSEMAPHORE_H
+#define UNITTESTBOT_FAIRSEMAPHORE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+/**
+ * Counting semaphore which grants slots in the order of requests.
+ * Satisfies Lockable, so it can be held by std::unique_lock.
+ */
+class FairSemaphore {
+    std::size_t available;
+    std::size_t next = 0;
+    std::size_t curr = 0;
+    std::condition_variable cv;
+    std::mutex mutex;
+
+public:
+    explicit FairSemaphore(std::size_t slots);
+    ~FairSemaphore() = default;
+
+    FairSemaphore(const FairSemaphore &) = delete;
+    FairSemaphore &operator=(const FairSemaphore &) = delete;
+
+    void lock();
+
+    bool try_lock();
+
+    void unlock();
+};
+
+
+#endif // UNITTESTBOT_FAIRSEMAPHORE_H
@@ -42,7 +42,8 @@ namespace GrpcUtils {
                           bool useStubs,
                           ErrorMode errorMode,
                           bool differentVariablesOfTheSameType,
-                          bool skipObjectWithoutSource) {
+                          bool skipObjectWithoutSource,
+                          bool incrementalGeneration) {
         auto result = std::make_unique<testsgen::SettingsContext>();
         result->set_generateforstaticfunctions(generateForStaticFunctions);
         result->set_verbose(verbose);
@@ -53,6 +54,7 @@ namespace GrpcUtils {
         result->set_errormode(errorMode);
         result->set_differentvariablesofthesametype(differentVariablesOfTheSameType);
         result->set_skipobjectwithoutsource(skipObjectWithoutSource);
+        result->set_incrementalgeneration(incrementalGeneration);
         return result;
     }
 
@@ -60,7 +62,9 @@ namespace GrpcUtils {
     createProjectRequest(std::unique_ptr<testsgen::ProjectContext> projectContext,
                          std::unique_ptr<testsgen::SettingsContext> settingsContext,
                          const std::vector<fs::path> &sourcePaths,
-                         std::optional<std::string> target) {
+                         std::optional<std::string> target,
+                         bool resume,
+                         bool journal) {
         auto result = std::make_unique<testsgen::ProjectRequest>();
         result->set_allocated_projectcontext(projectContext.release());
         result->set_allocated_settingscontext(settingsContext.release());
@@ -70,6 +74,8 @@ namespace GrpcUtils {
         if (target.has_value()) {
             result->set_targetpath(target.value());
         }
+        result->set_resume(resume);
+        result->set_journal(journal);
         return result;
     }
 
@@ -32,7 +32,8 @@ namespace GrpcUtils {
                           bool useStubs,
                           ErrorMode errorMode,
                           bool differentVariablesOfTheSameType,
-                          bool skipObjectWithoutSource);
+                          bool skipObjectWithoutSource,
+                          bool incrementalGeneration);
 
     std::unique_ptr<testsgen::SnippetRequest>
     createSnippetRequest(std::unique_ptr<testsgen::ProjectContext> projectContext,
@@ -43,7 +44,9 @@ namespace GrpcUtils {
     createProjectRequest(std::unique_ptr<testsgen::ProjectContext> projectContext,
                          std::unique_ptr<testsgen::SettingsContext> settingsContext,
                          const std::vector<fs::path> &sourcePaths,
-                         std::optional<std::string> target = std::nullopt);
+                         std::optional<std::string> target = std::nullopt,
+                         bool resume = false,
+                         bool journal = false);
 
 
     std::unique_ptr<testsgen::FolderRequest>
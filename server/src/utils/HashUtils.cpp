@@ -4,7 +4,25 @@
 
 #include "Synchronizer.h"
 
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Support/SHA1.h>
+
 namespace HashUtils {
+    std::string sha1(std::string_view data) {
+        llvm::SHA1 hasher;
+        hasher.update(llvm::StringRef(data.data(), data.size()));
+        return llvm::toHex(hasher.final(), true);
+    }
+
+    std::string sha1(const std::vector<std::string> &parts) {
+        llvm::SHA1 hasher;
+        for (const auto &part : parts) {
+            hasher.update(part);
+            hasher.update(llvm::StringRef("", 1));
+        }
+        return llvm::toHex(hasher.final(), true);
+    }
+
     std::size_t PathHash::operator()(const fs::path &path) const {
         return fs::hash_value(path);
     }
@@ -2,6 +2,9 @@
 #define UNITTESTBOT_HASHUTILS_H
 
 #include "utils/path/FileSystemPath.h"
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace tests {
     struct TestMethod;
@@ -23,6 +26,18 @@ namespace HashUtils {
         (hashCombine(seed, std::forward<Rest>(rest)), ...);
     }
 
+    /**
+     * SHA-1 of the data as a hex string. Unlike std::hash it doesn't depend on the build
+     * of the server, so it may identify data kept between runs.
+     */
+    std::string sha1(std::string_view data);
+
+    /**
+     * SHA-1 of the strings, each of them is followed by a separator, so that neighbouring
+     * strings are not mixed up.
+     */
+    std::string sha1(const std::vector<std::string> &parts);
+
     struct PathHash {
         std::size_t operator()(const fs::path &path) const;
     };
@@ -101,10 +101,14 @@ namespace KleeUtils {
         return variableName + "_post";
     }
 
-    std::string processNumberOption() {
+    size_t getProcessNumber() {
         if (Commands::kleeProcessNumber != 0) {
-            return "--process-number=" + std::to_string(Commands::kleeProcessNumber);
+            return Commands::kleeProcessNumber;
         }
-        return "--process-number=5";
+        return 5;
+    }
+
+    std::string processNumberOption(size_t processNumber) {
+        return "--process-number=" + std::to_string(processNumber);
     }
 }
@@ -24,7 +24,13 @@ namespace KleeUtils {
 
     std::string postSymbolicVariable(const std::string &variableName);
 
-    std::string processNumberOption();
+    /**
+     * @return number of processes of KLEE in interactive mode: value of --klee-process-number
+     * option of the server or 5 if it is not set.
+     */
+    size_t getProcessNumber();
+
+    std::string processNumberOption(size_t processNumber);
 }
 
 #endif // CORE_KLEEUTIL_H
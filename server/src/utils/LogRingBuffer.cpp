@@ -0,0 +1,81 @@
+#include "LogRingBuffer.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace {
+    std::size_t roundUpToPowerOfTwo(std::size_t value) {
+        std::size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+}
+
+LogRingBuffer::LogRingBuffer(std::size_t capacity)
+    : mask(roundUpToPowerOfTwo(capacity) - 1), cells(new Cell[mask + 1]) {
+    for (std::size_t i = 0; i <= mask; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool LogRingBuffer::tryPush(std::string &entry) {
+    std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    while (true) {
+        Cell &cell = cells[position & mask];
+        std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+        if (diff == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1,
+                                                      std::memory_order_relaxed)) {
+                cell.entry = std::move(entry);
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool LogRingBuffer::tryPop(std::string &entry) {
+    std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    while (true) {
+        Cell &cell = cells[position & mask];
+        std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+        if (diff == 0) {
+            if (dequeuePosition.compare_exchange_weak(position, position + 1,
+                                                      std::memory_order_relaxed)) {
+                entry = std::move(cell.entry);
+                cell.sequence.store(position + mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            position = dequeuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void LogRingBuffer::push(std::string entry) {
+    while (!tryPush(entry)) {
+        std::string oldest;
+        if (tryPop(oldest)) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool LogRingBuffer::empty() const {
+    std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    return cells[position & mask].sequence.load(std::memory_order_acquire) != position + 1;
+}
+
+std::size_t LogRingBuffer::takeDroppedCount() {
+    return droppedCount.exchange(0, std::memory_order_relaxed);
+}
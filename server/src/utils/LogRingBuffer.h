@@ -0,0 +1,58 @@
+#ifndef UNITTESTBOT_LOGRINGBUFFER_H
+#define UNITTESTBOT_LOGRINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/**
+ * Bounded lock-free queue of log entries with many producers and a single consumer.
+ * Based on the bounded MPMC queue by Dmitry Vyukov.
+ * When the buffer is full, the oldest entries are dropped, so that logging threads
+ * never wait for a slow client.
+ */
+class LogRingBuffer {
+public:
+    /**
+     * @param capacity maximal number of kept entries, is rounded up to a power of two.
+     */
+    explicit LogRingBuffer(std::size_t capacity);
+
+    LogRingBuffer(const LogRingBuffer &) = delete;
+    LogRingBuffer &operator=(const LogRingBuffer &) = delete;
+
+    /**
+     * Adds an entry, dropping the oldest ones if there is no room for it. Never blocks.
+     */
+    void push(std::string entry);
+
+    bool tryPop(std::string &entry);
+
+    /**
+     * @return true if there is no entry to take. Entries pushed concurrently may be missed.
+     */
+    bool empty() const;
+
+    /**
+     * @return number of entries dropped since the previous call
+     */
+    std::size_t takeDroppedCount();
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        std::string entry;
+    };
+
+    const std::size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<std::size_t> enqueuePosition = 0;
+    alignas(64) std::atomic<std::size_t> dequeuePosition = 0;
+    std::atomic<std::size_t> droppedCount = 0;
+
+    bool tryPush(std::string &entry);
+};
+
+
+#endif // UNITTESTBOT_LOGRINGBUFFER_H
@@ -8,6 +8,7 @@
 #include "loguru.h"
 
 #include <thread>
+#include <vector>
 
 namespace LogUtils {
     bool isMaxVerbosity() {
@@ -32,28 +33,44 @@ namespace LogUtils {
         return StringUtils::stringFormat("ERRNO: %s", strerror(errno));
     }
 
-    bool logChannelsWatcher(Server &server) {
-        loguru::set_thread_name(LOG_CHANNELS_WATCHER.c_str());
+    void closeOutdatedLogChannels(Server &server, const TimeUtils::systemClockTimePoint &now) {
         auto &service = server.testsService;
-        while (true) {
-            if (server.logChannelsWatcherCancellationToken) {
-                return true;
-            }
-            std::this_thread::sleep_for(TimeUtils::IDLE_TIMEOUT);
-            const std::lock_guard<std::mutex> lock(server.testsService.logChannelOperationsMutex);
-            auto now = TimeUtils::now();
-            std::vector <std::string> outdatedClients;
-            for (const auto& [client, timestamp] : service.linkedWithClient) {
+        std::vector<std::string> outdatedClients;
+        {
+            const std::lock_guard<std::mutex> lock(service.logChannelOperationsMutex);
+            for (const auto &[client, timestamp] : service.linkedWithClient) {
                 if (TimeUtils::isOutdatedTimestamp(now, timestamp)) {
                     LOG_S(INFO) << "Client " << client << " is outdated.";
                     outdatedClients.emplace_back(client);
                 }
             }
-            for (const auto& client : outdatedClients) {
+            for (const auto &client : outdatedClients) {
                 service.linkedWithClient.erase(client);
-                service.openedChannel[client].store(false, std::memory_order_release);
-                service.openedGTestChannel[client].store(false, std::memory_order_release);
             }
         }
+        {
+            // channels may be opened again even if their RPCs are still being completed
+            const std::lock_guard<std::mutex> lock(service.channelStorageMutex);
+            for (const auto &client : outdatedClients) {
+                service.openedChannel[client] = false;
+                service.openedGTestChannel[client] = false;
+            }
+        }
+        // channels are closed without the locks, because an RPC may be completed inline
+        for (const auto &client : outdatedClients) {
+            service.closeLogChannel(Server::logPrefix + client);
+            service.closeLogChannel(Server::gtestLogPrefix + client);
+        }
+    }
+
+    bool logChannelsWatcher(Server &server) {
+        loguru::set_thread_name(LOG_CHANNELS_WATCHER.c_str());
+        while (true) {
+            if (server.logChannelsWatcherCancellationToken) {
+                return true;
+            }
+            std::this_thread::sleep_for(TimeUtils::IDLE_TIMEOUT);
+            closeOutdatedLogChannels(server, TimeUtils::now());
+        }
     }
 }
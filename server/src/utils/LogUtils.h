@@ -25,6 +25,12 @@ namespace LogUtils {
 
     std::string errnoMessage();
 
+    /**
+     * Closes log channels of clients which haven't sent heartbeats for IDLE_TIMEOUT: their
+     * loguru callbacks are removed and the RPCs are finished, so the clients may open them again.
+     */
+    void closeOutdatedLogChannels(Server &server, const TimeUtils::systemClockTimePoint &now);
+
     bool logChannelsWatcher(Server &server);
 }
 
@@ -4,6 +4,7 @@
 #include "ExecUtils.h"
 #include "LogUtils.h"
 #include "Paths.h"
+#include "ResourceScheduler.h"
 #include "StringUtils.h"
 #include "commands/Commands.h"
 #include "environment/EnvironmentPaths.h"
@@ -11,6 +12,8 @@
 
 #include "loguru.h"
 
+#include <algorithm>
+#include <fstream>
 #include <thread>
 
 namespace MakefileUtils {
@@ -48,7 +51,14 @@ namespace MakefileUtils {
         runCommand = ShellExecTask::ExecutionParameters("env", argv);
         printCommand = ShellExecTask::ExecutionParameters("env", argv);
         printCommand.argv.emplace_back("-n");
-        echoCommand = ShellExecTask::ExecutionParameters("echo");
+        // dry run costs an extra make process for every command, so before the run it is done only
+        // for debugging, otherwise recipes are written only after a failure
+        dryRunTrace = LogUtils::isMaxVerbosity();
+    }
+
+    void MakefileCommand::writeTrace(const ShellExecTask::ExecutionParameters &command) const {
+        std::ofstream log(logFile, std::ios::app);
+        log << command.toString() << '\n';
     }
 
     ExecUtils::ExecutionResult
@@ -56,27 +66,33 @@ namespace MakefileUtils {
                          bool redirectStderr,
                          bool ignoreErrors,
                          const std::optional<std::chrono::seconds> &timeout) const {
-        auto print = ShellExecTask::runShellCommandTaskToFile(printCommand, logFile, buildPath);
-        if (print.status != 0) {
-            failedCommand = &printCommand;
-            return print;
-        }
-        // This writes \n to logFile to separate runs.
-        auto echo = ShellExecTask::runShellCommandTaskToFile(echoCommand, logFile, buildPath);
-        if (echo.status != 0) {
-            failedCommand = &echoCommand;
-            return echo;
+        if (dryRunTrace) {
+            auto print = ShellExecTask::runShellCommandTaskToFile(printCommand, logFile, buildPath);
+            if (print.status != 0) {
+                failedCommand = printCommand;
+                return print;
+            }
         }
+        auto tokens = ResourceScheduler::getInstance().acquire(ResourceScheduler::Kind::COMPILER_JOB,
+                                                               getJobsNumber());
+        auto params = runCommand;
+        params.argv[JOBS_FLAG_INDEX] = threadFlag(tokens.count());
+        writeTrace(params);
         auto exec = ShellExecTask::runShellCommandTask(
-                runCommand, buildPath, projectName, redirectStderr, false, ignoreErrors, timeout);
+                params, buildPath, projectName, redirectStderr, false, ignoreErrors, timeout);
         if (exec.status != 0) {
-            failedCommand = &runCommand;
+            failedCommand = params;
+            if (!dryRunTrace) {
+                // recipes are needed to investigate the failure, they are printed only now to spare a process
+                auto print = ShellExecTask::runShellCommandTaskToFile(printCommand, logFile, buildPath);
+                LOG_IF_S(WARNING, print.status != 0) << "Failed to write recipes of failed make to " << logFile;
+            }
         }
         return exec;
     }
 
     std::string MakefileCommand::getFailedCommand() const {
-        if (failedCommand) {
+        if (failedCommand.has_value()) {
             return failedCommand->toString();
         } else {
             LOG_S(ERROR) << "No command failed";
@@ -84,15 +100,18 @@ namespace MakefileUtils {
         }
     }
 
-    std::string threadFlag() {
+    size_t getJobsNumber() {
         if (Commands::threadsPerUser != 0) {
-            return "-j" + std::to_string(Commands::threadsPerUser);
-        }
-        unsigned int threads = std::thread::hardware_concurrency();
-        if (threads == 0) {
-            return "";
-        } else {
-            return "-j" + std::to_string(threads);
+            return Commands::threadsPerUser;
         }
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::string threadFlag(size_t jobsNumber) {
+        return "-j" + std::to_string(jobsNumber);
+    }
+
+    std::string threadFlag() {
+        return threadFlag(getJobsNumber());
     }
 }
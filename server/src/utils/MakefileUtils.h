@@ -7,6 +7,7 @@
 #include "tasks/ShellExecTask.h"
 
 #include "utils/path/FileSystemPath.h"
+#include <optional>
 #include <string>
 
 namespace MakefileUtils {
@@ -14,9 +15,17 @@ namespace MakefileUtils {
         fs::path makefile;
         std::string target;
         std::string projectName;
-        ShellExecTask::ExecutionParameters runCommand, printCommand, echoCommand;
+        ShellExecTask::ExecutionParameters runCommand, printCommand;
         fs::path logFile;
-        mutable ShellExecTask::ExecutionParameters const * failedCommand = nullptr;
+        /// if true, commands of `make -n` are written to makefile.log before every run,
+        /// otherwise they are written after a failed run only
+        bool dryRunTrace = false;
+        /// position of -j flag in runCommand, it is set according to taken resource tokens
+        static const size_t JOBS_FLAG_INDEX = 1;
+        /// the executed command, with -j flag which was actually used
+        mutable std::optional<ShellExecTask::ExecutionParameters> failedCommand;
+
+        void writeTrace(const ShellExecTask::ExecutionParameters &command) const;
     public:
 
         MakefileCommand() = default;
@@ -37,6 +46,14 @@ namespace MakefileUtils {
 
     std::vector<std::string> getMakeCommand(std::string makefile, std::string target, bool nested);
 
+    /**
+     * @return number of make jobs: value of -j option of the server
+     * or number of hardware threads if it is not set.
+     */
+    size_t getJobsNumber();
+
+    std::string threadFlag(size_t jobsNumber);
+
     std::string threadFlag();
 }
 
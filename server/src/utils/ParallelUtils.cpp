@@ -0,0 +1,24 @@
+#include "ParallelUtils.h"
+
+#include "commands/Commands.h"
+
+#include "loguru.h"
+
+#include <thread>
+
+namespace ParallelUtils {
+    size_t getWorkersNumber() {
+        if (Commands::threadsPerUser != 0) {
+            return Commands::threadsPerUser;
+        }
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    void setRequestEnvironment(std::optional<std::string> clientId, grpc::ServerContext *serverContext) {
+        if (clientId.has_value()) {
+            loguru::set_thread_name(clientId->c_str());
+            RequestEnvironment::setClientId(std::move(clientId.value()));
+        }
+        RequestEnvironment::setServerContext(serverContext);
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef UTBOTCPP_PARALLELUTILS_H
+#define UTBOTCPP_PARALLELUTILS_H
+
+#include "RequestEnvironment.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ParallelUtils {
+    /**
+     * @return number of threads one request may use: value of -j option of the server
+     * or number of hardware threads if it is not set.
+     */
+    size_t getWorkersNumber();
+
+    /**
+     * Makes the current thread work for the client of the request: its logs and resources
+     * are accounted to the client, and it sees cancellation of the request.
+     */
+    void setRequestEnvironment(std::optional<std::string> clientId, grpc::ServerContext *serverContext);
+
+    /**
+     * Applies function to each element of items using up to workersNumber threads.
+     * Elements are handed out one by one, so function must not depend on the order of calls.
+     * If function throws, remaining elements are skipped and the first exception is rethrown.
+     */
+    template <typename T, typename Function>
+    void forEach(std::vector<T> &items, size_t workersNumber, Function &&function) {
+        workersNumber = std::min(workersNumber, items.size());
+        if (workersNumber <= 1) {
+            for (auto &item : items) {
+                function(item);
+            }
+            return;
+        }
+        std::atomic<size_t> next = 0;
+        auto worker = [&items, &function, &next]() {
+            try {
+                for (size_t i = next++; i < items.size(); i = next++) {
+                    function(items[i]);
+                }
+            } catch (...) {
+                next = items.size();
+                throw;
+            }
+        };
+        std::vector<std::future<void>> workers;
+        for (size_t i = 1; i < workersNumber; ++i) {
+            workers.push_back(std::async(std::launch::async,
+                                         [&worker](std::optional<std::string> clientId,
+                                                   grpc::ServerContext *serverContext) {
+                                             setRequestEnvironment(std::move(clientId), serverContext);
+                                             worker();
+                                         },
+                                         RequestEnvironment::clientId, RequestEnvironment::serverContext));
+        }
+        std::exception_ptr error;
+        try {
+            worker();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        for (auto &future : workers) {
+            try {
+                future.get();
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * Applies function to each element of items using up to getWorkersNumber() threads.
+     */
+    template <typename T, typename Function>
+    void forEach(std::vector<T> &items, Function &&function) {
+        forEach(items, getWorkersNumber(), std::forward<Function>(function));
+    }
+}
+
+#endif //UTBOTCPP_PARALLELUTILS_H
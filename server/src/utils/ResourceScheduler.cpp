@@ -0,0 +1,218 @@
+#include "ResourceScheduler.h"
+
+#include "RequestEnvironment.h"
+#include "commands/Commands.h"
+
+#include "loguru.h"
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+const std::chrono::seconds ResourceScheduler::MEMORY_CHECK_PERIOD = std::chrono::seconds(1);
+
+namespace {
+    const uint64_t BYTES_IN_MEBIBYTE = 1024 * 1024;
+    const double DEFAULT_MEMORY_LIMIT_PART = 0.8;
+
+    struct ProcessInfo {
+        pid_t pid;
+        pid_t parent;
+        uint64_t rssPages;
+    };
+
+    std::optional<ProcessInfo> readProcessInfo(pid_t pid) {
+        std::ifstream statFile("/proc/" + std::to_string(pid) + "/stat");
+        std::string stat;
+        if (!std::getline(statFile, stat)) {
+            return std::nullopt;
+        }
+        // name of the executable is put in parentheses and may contain spaces
+        size_t nameEnd = stat.rfind(')');
+        if (nameEnd == std::string::npos) {
+            return std::nullopt;
+        }
+        std::istringstream fields(stat.substr(nameEnd + 1));
+        std::string field;
+        ProcessInfo info{pid, 0, 0};
+        // fields after the name start from the 3rd one: state, ppid, ..., rss is the 24th
+        for (int index = 3; index <= 24 && fields >> field; ++index) {
+            if (index == 4) {
+                info.parent = std::stoi(field);
+            } else if (index == 24) {
+                info.rssPages = std::stoull(field);
+                return info;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Sums resident memory of all descendants of the server: make, compilers, KLEE and tests.
+     */
+    uint64_t getChildrenResidentMemory() {
+        std::vector<ProcessInfo> processes;
+        if (DIR *proc = opendir("/proc")) {
+            while (dirent *entry = readdir(proc)) {
+                if (!std::all_of(entry->d_name, entry->d_name + strlen(entry->d_name), ::isdigit)) {
+                    continue;
+                }
+                if (auto info = readProcessInfo(std::stoi(entry->d_name)); info.has_value()) {
+                    processes.push_back(info.value());
+                }
+            }
+            closedir(proc);
+        }
+        std::vector<pid_t> ancestors = {getpid()};
+        uint64_t rssPages = 0;
+        for (size_t i = 0; i < ancestors.size(); ++i) {
+            for (const auto &process : processes) {
+                if (process.parent == ancestors[i]) {
+                    ancestors.push_back(process.pid);
+                    rssPages += process.rssPages;
+                }
+            }
+        }
+        return rssPages * sysconf(_SC_PAGESIZE);
+    }
+}
+
+ResourceScheduler::Tokens::Tokens(ResourceScheduler *scheduler, uint32_t client, size_t count)
+    : scheduler(scheduler), client(client), tokensCount(count) {
+}
+
+ResourceScheduler::Tokens::Tokens(Tokens &&other) noexcept
+    : scheduler(other.scheduler), client(other.client), tokensCount(other.tokensCount) {
+    other.tokensCount = 0;
+}
+
+ResourceScheduler::Tokens::~Tokens() {
+    if (tokensCount > 0) {
+        scheduler->release(client, tokensCount);
+    }
+}
+
+size_t ResourceScheduler::Tokens::count() const {
+    return tokensCount;
+}
+
+ResourceScheduler &ResourceScheduler::getInstance() {
+    static ResourceScheduler instance = []() {
+        size_t capacity = Commands::maxJobs;
+        if (capacity == 0) {
+            capacity = std::max(1u, std::thread::hardware_concurrency());
+        }
+        uint64_t memoryLimit = Commands::memoryLimit * BYTES_IN_MEBIBYTE;
+        if (memoryLimit == 0) {
+            memoryLimit = static_cast<uint64_t>(sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGESIZE) *
+                                                DEFAULT_MEMORY_LIMIT_PART);
+        }
+        LOG_S(INFO) << "Resource scheduler: " << capacity << " jobs, "
+                    << memoryLimit / BYTES_IN_MEBIBYTE << " MiB for child processes";
+        return ResourceScheduler(capacity, memoryLimit);
+    }();
+    return instance;
+}
+
+ResourceScheduler::ResourceScheduler(size_t capacity, uint64_t memoryLimit)
+    : capacity(std::max<size_t>(capacity, 1)), memoryLimit(memoryLimit) {
+}
+
+ResourceScheduler::Tokens ResourceScheduler::acquire(Kind kind, size_t wanted) {
+    return acquire(kind, wanted, RequestEnvironment::getClientIndex());
+}
+
+ResourceScheduler::Tokens ResourceScheduler::acquire(Kind kind, size_t wanted, uint32_t client) {
+    std::unique_lock<std::mutex> lock(mutex);
+    waitingByClient[client]++;
+    size_t granted = 0;
+    while (true) {
+        granted = std::min(std::max<size_t>(wanted, 1), grantable(client));
+        if (granted == 0) {
+            released.wait(lock);
+            continue;
+        }
+        // with no processes running nothing would free memory, so the launch is not deferred
+        if (kind == Kind::KLEE_PROCESS && used > 0 && memoryLimit != 0) {
+            if (isMemorySampleOutdated()) {
+                if (memorySampling) {
+                    released.wait(lock);
+                } else {
+                    sampleMemory(lock);
+                }
+                // tokens may be taken by others while the mutex is released
+                continue;
+            }
+            if (sampledMemory > memoryLimit) {
+                LOG_S(DEBUG) << "Memory limit for child processes is reached, KLEE launch is deferred";
+                released.wait_for(lock, MEMORY_CHECK_PERIOD);
+                continue;
+            }
+        }
+        break;
+    }
+    if (--waitingByClient[client] == 0) {
+        waitingByClient.erase(client);
+    }
+    heldByClient[client] += granted;
+    used += granted;
+    return Tokens(this, client, granted);
+}
+
+size_t ResourceScheduler::grantable(uint32_t client) const {
+    size_t free = capacity - used;
+    if (free == 0) {
+        return 0;
+    }
+    bool othersWaiting = std::any_of(waitingByClient.begin(), waitingByClient.end(),
+                                     [client](const auto &waiting) { return waiting.first != client; });
+    if (!othersWaiting) {
+        return free;
+    }
+    size_t activeClients = waitingByClient.size();
+    for (const auto &[holder, _] : heldByClient) {
+        if (waitingByClient.count(holder) == 0) {
+            activeClients++;
+        }
+    }
+    size_t share = std::max<size_t>(capacity / activeClients, 1);
+    auto held = heldByClient.find(client);
+    size_t heldByThis = held == heldByClient.end() ? 0 : held->second;
+    return heldByThis < share ? std::min(free, share - heldByThis) : 0;
+}
+
+bool ResourceScheduler::isMemorySampleOutdated() const {
+    return !memorySampleTime.has_value() ||
+           std::chrono::steady_clock::now() - memorySampleTime.value() >= MEMORY_CHECK_PERIOD;
+}
+
+void ResourceScheduler::sampleMemory(std::unique_lock<std::mutex> &lock) {
+    memorySampling = true;
+    lock.unlock();
+    uint64_t memory = getChildrenResidentMemory();
+    lock.lock();
+    sampledMemory = memory;
+    memorySampleTime = std::chrono::steady_clock::now();
+    memorySampling = false;
+    released.notify_all();
+}
+
+void ResourceScheduler::release(uint32_t client, size_t count) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        used -= count;
+        if ((heldByClient[client] -= count) == 0) {
+            heldByClient.erase(client);
+        }
+    }
+    released.notify_all();
+}
@@ -0,0 +1,95 @@
+#ifndef UNITTESTBOT_RESOURCESCHEDULER_H
+#define UNITTESTBOT_RESOURCESCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+/**
+ * Hands out tokens for processes launched by requests of all clients, so that
+ * several clients don't oversubscribe the machine. A token stands for one
+ * busy CPU. When several clients compete, each of them gets its fair share
+ * of tokens; a client alone may take all of them. New KLEE processes are
+ * deferred while processes launched by the server use more memory than allowed.
+ */
+class ResourceScheduler {
+public:
+    enum class Kind {
+        COMPILER_JOB, KLEE_PROCESS, TEST_PROCESS
+    };
+
+    /**
+     * Tokens taken by a client, they are given back on destruction.
+     */
+    class Tokens {
+    public:
+        Tokens(Tokens &&other) noexcept;
+        Tokens(const Tokens &) = delete;
+        Tokens &operator=(const Tokens &) = delete;
+        Tokens &operator=(Tokens &&) = delete;
+        ~Tokens();
+
+        [[nodiscard]] size_t count() const;
+
+    private:
+        friend class ResourceScheduler;
+
+        Tokens(ResourceScheduler *scheduler, uint32_t client, size_t count);
+
+        ResourceScheduler *scheduler;
+        uint32_t client;
+        size_t tokensCount;
+    };
+
+    /**
+     * Scheduler shared by all requests. Its limits are taken from server options.
+     */
+    static ResourceScheduler &getInstance();
+
+    /**
+     * @param capacity number of tokens
+     * @param memoryLimit maximal resident memory of child processes in bytes, 0 means no limit
+     */
+    ResourceScheduler(size_t capacity, uint64_t memoryLimit);
+
+    /**
+     * Waits until the current client may take at least one token and takes up to wanted of them.
+     * Callers should adjust parallelism of the launched process to the number of taken tokens.
+     */
+    Tokens acquire(Kind kind, size_t wanted = 1);
+
+    Tokens acquire(Kind kind, size_t wanted, uint32_t client);
+
+private:
+    const size_t capacity;
+    const uint64_t memoryLimit;
+
+    std::mutex mutex;
+    std::condition_variable released;
+    size_t used = 0;
+    std::unordered_map<uint32_t, size_t> heldByClient;
+    std::unordered_map<uint32_t, size_t> waitingByClient;
+
+    static const std::chrono::seconds MEMORY_CHECK_PERIOD;
+
+    /// resident memory of child processes, it is sampled at most once per MEMORY_CHECK_PERIOD
+    uint64_t sampledMemory = 0;
+    std::optional<std::chrono::steady_clock::time_point> memorySampleTime;
+    bool memorySampling = false;
+
+    size_t grantable(uint32_t client) const;
+
+    bool isMemorySampleOutdated() const;
+
+    /// scans /proc with the mutex released, so that other clients are not blocked meanwhile
+    void sampleMemory(std::unique_lock<std::mutex> &lock);
+
+    void release(uint32_t client, size_t count);
+};
+
+
+#endif // UNITTESTBOT_RESOURCESCHEDULER_H
@@ -18,6 +18,17 @@
 namespace ServerUtils {
     using json = nlohmann::json;
 
+    std::optional<std::string> getClientId(const grpc::ServerContextBase *context, bool testMode) {
+        auto it = context->client_metadata().find("clientid");
+        if (it == context->client_metadata().end()) {
+            if (testMode) {
+                return LogUtils::TEST_CLIENT;
+            }
+            return std::nullopt;
+        }
+        return std::string(it->second.begin(), it->second.end());
+    }
+
     void setThreadOptions(grpc::ServerContext *context, bool testMode) {
         if (!CollectionUtils::containsKey(context->client_metadata(), "clientid")) {
             if (testMode) {
@@ -5,7 +5,16 @@
 
 #include <grpcpp/impl/codegen/server_context.h>
 
+#include <optional>
+#include <string>
+
 namespace ServerUtils {
+    /**
+     * Extracts id of the client from request metadata.
+     * @return std::nullopt if client is unnamed and server is not in test mode
+     */
+    std::optional<std::string> getClientId(const grpc::ServerContextBase *context, bool testMode);
+
     void setThreadOptions(grpc::ServerContext *context, bool testMode);
 
     void registerClient(concurrent_set<std::string> &clients, std::string client);
@@ -1,14 +1,47 @@
 #include "KleeStats.h"
 
-#include <vector>
+#include "Paths.h"
+#include "utils/CollectionUtils.h"
+
+#include "loguru.h"
+
+#include <sqlite3.h>
 
-#include "utils/stats/CSVReader.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace StatsUtils {
+    namespace {
+        const std::string RUN_STATS_FILE_NAME = "run.stats";
+
+        using SqliteDatabase = std::unique_ptr<sqlite3, decltype(&sqlite3_close)>;
+        using SqliteStatement = std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)>;
+
+        std::optional<SqliteStatement> prepare(sqlite3 *db, const char *query) {
+            sqlite3_stmt *statement = nullptr;
+            if (sqlite3_prepare_v2(db, query, -1, &statement, nullptr) != SQLITE_OK) {
+                sqlite3_finalize(statement);
+                return std::nullopt;
+            }
+            return SqliteStatement(statement, sqlite3_finalize);
+        }
+
+        // KLEE stores times in microseconds
+        std::chrono::milliseconds toMilliseconds(int64_t microseconds) {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::microseconds(microseconds));
+        }
+    }
+
     KleeStats &KleeStats::operator+=(const KleeStats &other) {
         kleeTime += other.kleeTime;
         solverTime += other.solverTime;
         resolutionTime += other.resolutionTime;
+        solverQueries += other.solverQueries;
+        maxStates = std::max(maxStates, other.maxStates);
         return *this;
     }
 
@@ -17,21 +50,63 @@ namespace StatsUtils {
         return other;
     }
 
-    KleeStats::KleeStats(std::istream &kleeStatsReport) {
-        StatsUtils::CSVTable parsedCSV = StatsUtils::readCSV(kleeStatsReport, ',');
-        std::vector<std::string> keys = {"Time(s)", "TSolver(s)", "TResolve(s)"};
-        std::vector<std::chrono::milliseconds> timeValues;
-        for (const auto &key: keys) {
-            int totalTime = 0;
-            if (CollectionUtils::containsKey(parsedCSV, key)) {
-                totalTime = 1000 * std::stof(parsedCSV[key].back());
-            } else {
-                LOG_S(WARNING) << StringUtils::stringFormat("Key %s not found in klee-stats report", key);
+    std::optional<KleeStats> readRunStats(const fs::path &runStatsPath) {
+        sqlite3 *rawDb = nullptr;
+        int openStatus = sqlite3_open_v2(runStatsPath.c_str(), &rawDb, SQLITE_OPEN_READONLY, nullptr);
+        SqliteDatabase db(rawDb, sqlite3_close);
+        if (openStatus != SQLITE_OK) {
+            LOG_S(WARNING) << "Cannot open KLEE statistics " << runStatsPath << ": " << sqlite3_errmsg(rawDb);
+            return std::nullopt;
+        }
+        // statistics are appended periodically, so the last row holds the final values
+        auto lastRow = prepare(db.get(), "SELECT * FROM stats ORDER BY rowid DESC LIMIT 1");
+        if (!lastRow.has_value() || sqlite3_step(lastRow->get()) != SQLITE_ROW) {
+            LOG_S(WARNING) << "No statistics found in " << runStatsPath;
+            return std::nullopt;
+        }
+        std::unordered_map<std::string, int64_t> values;
+        for (int i = 0; i < sqlite3_column_count(lastRow->get()); ++i) {
+            values[sqlite3_column_name(lastRow->get(), i)] = sqlite3_column_int64(lastRow->get(), i);
+        }
+        auto getValue = [&](const std::string &column) -> int64_t {
+            if (!CollectionUtils::containsKey(values, column)) {
+                LOG_S(WARNING) << "Column " << column << " not found in " << runStatsPath;
+                return 0;
+            }
+            return values.at(column);
+        };
+        int64_t maxStates = 0;
+        if (auto statesQuery = prepare(db.get(), "SELECT MAX(NumStates) FROM stats");
+            statesQuery.has_value() && sqlite3_step(statesQuery->get()) == SQLITE_ROW) {
+            maxStates = sqlite3_column_int64(statesQuery->get(), 0);
+        }
+        return KleeStats(toMilliseconds(getValue("WallTime")), toMilliseconds(getValue("SolverTime")),
+                         toMilliseconds(getValue("ResolveTime")),
+                         static_cast<uint64_t>(getValue("NumQueries")), static_cast<uint64_t>(maxStates));
+    }
+
+    KleeStats readKleeStats(const fs::path &kleeOutDir) {
+        KleeStats total;
+        if (!fs::exists(kleeOutDir)) {
+            return total;
+        }
+        std::vector<fs::path> runDirs;
+        for (const auto &entry : fs::recursive_directory_iterator(kleeOutDir)) {
+            if (entry.is_regular_file() && entry.path().filename().string() == RUN_STATS_FILE_NAME) {
+                runDirs.push_back(entry.path().parent_path());
+            }
+        }
+        for (const auto &runDir : runDirs) {
+            bool isNested = std::any_of(runDirs.begin(), runDirs.end(), [&](const fs::path &other) {
+                return other != runDir && Paths::isSubPathOf(other, runDir);
+            });
+            if (isNested) {
+                continue;
+            }
+            if (auto runStats = readRunStats(runDir / RUN_STATS_FILE_NAME); runStats.has_value()) {
+                total += runStats.value();
             }
-            timeValues.emplace_back(totalTime);
         }
-        kleeTime = timeValues[0];
-        solverTime = timeValues[1];
-        resolutionTime = timeValues[2];
+        return total;
     }
 }
@@ -1,18 +1,21 @@
 #ifndef UTBOTCPP_KLEESTATS_H
 #define UTBOTCPP_KLEESTATS_H
 
+#include "utils/path/FileSystemPath.h"
+
 #include <chrono>
-#include <istream>
+#include <cstdint>
+#include <optional>
 
 namespace StatsUtils {
     class KleeStats {
     public:
         KleeStats() : kleeTime(0), solverTime(0), resolutionTime(0) {}
         KleeStats(std::chrono::milliseconds kleeTime, std::chrono::milliseconds solverTime,
-                  std::chrono::milliseconds resolutionTime) :
-                kleeTime(kleeTime), solverTime(solverTime), resolutionTime(resolutionTime) {}
-
-        explicit KleeStats(std::istream &kleeStatsReport);
+                  std::chrono::milliseconds resolutionTime, uint64_t solverQueries = 0,
+                  uint64_t maxStates = 0) :
+                kleeTime(kleeTime), solverTime(solverTime), resolutionTime(resolutionTime),
+                solverQueries(solverQueries), maxStates(maxStates) {}
 
         KleeStats &operator+=(const KleeStats &other);
 
@@ -30,11 +33,35 @@ namespace StatsUtils {
             return resolutionTime;
         }
 
+        [[nodiscard]] uint64_t getSolverQueries() const {
+            return solverQueries;
+        }
+
+        /**
+         * Maximal number of states a single KLEE run kept at once.
+         */
+        [[nodiscard]] uint64_t getMaxStates() const {
+            return maxStates;
+        }
+
     private:
         std::chrono::milliseconds kleeTime;
         std::chrono::milliseconds solverTime;
         std::chrono::milliseconds resolutionTime;
+        uint64_t solverQueries = 0;
+        uint64_t maxStates = 0;
     };
+
+    /**
+     * Reads statistics of a single KLEE run from its `run.stats` database.
+     */
+    std::optional<KleeStats> readRunStats(const fs::path &runStatsPath);
+
+    /**
+     * Combines statistics of all KLEE runs found in the directory.
+     * Runs nested into directory of another run are considered to be its parts.
+     */
+    KleeStats readKleeStats(const fs::path &kleeOutDir);
 }
 
 #endif //UTBOTCPP_KLEESTATS_H
@@ -0,0 +1,75 @@
+#include "StageStats.h"
+
+#include "tasks/BaseForkTask.h"
+
+#include "loguru.h"
+
+#include <sys/resource.h>
+
+namespace StatsUtils {
+    std::mutex StageTimer::statisticMutex;
+    std::map<std::string, StageStats> StageTimer::statistic;
+
+    StageStats &StageStats::operator+=(const StageStats &other) {
+        wallTime += other.wallTime;
+        calls += other.calls;
+        spawnedProcesses += other.spawnedProcesses;
+        peakRssGrowthKb = std::max(peakRssGrowthKb, other.peakRssGrowthKb);
+        peakChildrenRssGrowthKb = std::max(peakChildrenRssGrowthKb, other.peakChildrenRssGrowthKb);
+        return *this;
+    }
+
+    nlohmann::json StageStats::toJson() const {
+        return {{"wallTimeMs",              wallTime.count()},
+                {"calls",                   calls},
+                {"spawnedProcesses",        spawnedProcesses},
+                {"peakRssGrowthKb",         peakRssGrowthKb},
+                {"peakChildrenRssGrowthKb", peakChildrenRssGrowthKb}};
+    }
+
+    StageTimer::StageTimer(std::string stageName)
+        : stageName(std::move(stageName)), begin(std::chrono::steady_clock::now()),
+          spawnedProcessesBefore(BaseForkTask::getSpawnedProcessesCount()),
+          peakRssBefore(getPeakRssKb(false)), peakChildrenRssBefore(getPeakRssKb(true)) {
+    }
+
+    StageTimer::~StageTimer() {
+        StageStats current;
+        current.wallTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - begin);
+        current.calls = 1;
+        current.spawnedProcesses = BaseForkTask::getSpawnedProcessesCount() - spawnedProcessesBefore;
+        current.peakRssGrowthKb = getPeakRssKb(false) - peakRssBefore;
+        current.peakChildrenRssGrowthKb = getPeakRssKb(true) - peakChildrenRssBefore;
+        LOG_S(MAX) << "Stage '" << stageName << "' took " << current.wallTime.count() << " ms and spawned "
+                   << current.spawnedProcesses << " processes";
+        std::lock_guard<std::mutex> guard(statisticMutex);
+        statistic[stageName] += current;
+    }
+
+    void StageTimer::clearStatistic() {
+        std::lock_guard<std::mutex> guard(statisticMutex);
+        statistic.clear();
+    }
+
+    std::map<std::string, StageStats> StageTimer::getStatistic() {
+        std::lock_guard<std::mutex> guard(statisticMutex);
+        return statistic;
+    }
+
+    nlohmann::json StageTimer::statisticToJson() {
+        nlohmann::json result = nlohmann::json::object();
+        for (const auto &[stageName, stageStats] : getStatistic()) {
+            result[stageName] = stageStats.toJson();
+        }
+        return result;
+    }
+
+    long getPeakRssKb(bool children) {
+        struct rusage usage{};
+        if (getrusage(children ? RUSAGE_CHILDREN : RUSAGE_SELF, &usage) != 0) {
+            return 0;
+        }
+        return usage.ru_maxrss;
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef UTBOTCPP_STAGESTATS_H
+#define UTBOTCPP_STAGESTATS_H
+
+#include "json.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+// add this macro to the beginning of the scope which should be accounted as a pipeline stage
+#define MEASURE_STAGE_EXECUTION_TIME(stage) const StatsUtils::StageTimer stageTimer(stage);
+
+namespace StatsUtils {
+    /*
+     * Resources consumed by one stage of the generation pipeline
+     * (fetch, synchronize, klee files build, link, KLEE, ktest parse, print, test run, coverage),
+     * summed over all the times the stage was entered.
+     */
+    struct StageStats {
+        std::chrono::milliseconds wallTime{0};
+        uint64_t calls = 0;
+        uint64_t spawnedProcesses = 0;
+        // ru_maxrss is kept for the lifetime of the process, so a stage is accounted only for
+        // the largest growth of it during one call, of the server and of its waited-for children
+        long peakRssGrowthKb = 0;
+        long peakChildrenRssGrowthKb = 0;
+
+        StageStats &operator+=(const StageStats &other);
+
+        [[nodiscard]] nlohmann::json toJson() const;
+    };
+
+    class StageTimer {
+    public:
+        explicit StageTimer(std::string stageName);
+
+        ~StageTimer();
+
+        static void clearStatistic();
+
+        static std::map<std::string, StageStats> getStatistic();
+
+        static nlohmann::json statisticToJson();
+
+    private:
+        const std::string stageName;
+        const std::chrono::steady_clock::time_point begin;
+        const uint64_t spawnedProcessesBefore;
+        const long peakRssBefore;
+        const long peakChildrenRssBefore;
+
+        static std::mutex statisticMutex;
+        static std::map<std::string, StageStats> statistic;
+    };
+
+    long getPeakRssKb(bool children);
+}
+
+#endif //UTBOTCPP_STAGESTATS_H
@@ -1,9 +1,21 @@
 #include "TestsGenerationStats.h"
 
 namespace StatsUtils {
+    namespace {
+        std::vector<std::string> kleeTimesToStrings(const KleeStats &kleeStats) {
+            return { StringUtils::stringFormat("%.2f", kleeStats.getKleeTime().count() / 1000.0),
+                     StringUtils::stringFormat("%.2f", kleeStats.getSolverTime().count() / 1000.0),
+                     StringUtils::stringFormat("%.2f", kleeStats.getResolutionTime().count() / 1000.0) };
+        }
 
-    TestsGenerationStats::TestsGenerationStats(const KleeStats &kleeStats, const tests::Tests &tests) :
-            kleeStats(kleeStats) {
+        std::vector<std::string> kleeCountersToStrings(const KleeStats &kleeStats) {
+            return { std::to_string(kleeStats.getSolverQueries()), std::to_string(kleeStats.getMaxStates()) };
+        }
+    }
+
+    TestsGenerationStats::TestsGenerationStats(const KleeStats &kleeStats, const tests::Tests &tests,
+                                               std::map<std::string, KleeStats> methodsKleeStats) :
+            kleeStats(kleeStats), methodsKleeStats(std::move(methodsKleeStats)) {
         numTestsInSuite["regression"] = tests.regressionMethodsNumber;
         numTestsInSuite["error"] = tests.errorMethodsNumber;
         numCoveredFunctions = 0;
@@ -34,9 +46,7 @@ namespace StatsUtils {
         std::vector<std::string> out;
         // Klee-stats
         {
-            out.push_back(StringUtils::stringFormat("%.2f", kleeStats.getKleeTime().count() / 1000.0));
-            out.push_back(StringUtils::stringFormat("%.2f", kleeStats.getSolverTime().count() / 1000.0));
-            out.push_back(StringUtils::stringFormat("%.2f", kleeStats.getResolutionTime().count() / 1000.0));
+            CollectionUtils::extend(out, kleeTimesToStrings(kleeStats));
         }
         // Tests in different suites
         {
@@ -50,12 +60,16 @@ namespace StatsUtils {
             out.push_back(StringUtils::stringFormat("%d", numCoveredFunctions));
             out.push_back(StringUtils::stringFormat("%d", numFunctions));
         }
+        // columns added later go last, so that existing ones keep their positions
+        {
+            CollectionUtils::extend(out, kleeCountersToStrings(kleeStats));
+        }
         return out;
     }
 
     std::vector<std::string> TestsGenerationStatsFileMap::getHeader() {
         return {"Klee Time (s)", "Solver Time (s)", "Resolution Time (s)", "Regression Tests Generated",
-                "Error Tests Generated", "Covered Functions", "Total functions"};
+                "Error Tests Generated", "Covered Functions", "Total functions", "Solver Queries", "Max States"};
     }
 
     std::vector<std::string> TestsGenerationStatsFileMap::getTotalStrings() {
@@ -64,7 +78,25 @@ namespace StatsUtils {
         return out;
     }
 
-    void TestsGenerationStatsFileMap::addFileStats(const KleeStats &kleeStats, const tests::Tests &tests) {
-        statsMap[tests.sourceFilePath] = TestsGenerationStats(kleeStats, tests);
+    printer::CSVPrinter TestsGenerationStatsFileMap::functionsToCSV() {
+        printer::CSVPrinter printer({"File", "Function", "Klee Time (s)", "Solver Time (s)", "Resolution Time (s)",
+                                     "Solver Queries", "Max States"}, ',');
+        for (const auto &[filePath, fileStats]: statsMap) {
+            for (const auto &[methodName, methodKleeStats]: fileStats.methodsKleeStats) {
+                std::vector<std::string> row = {fs::relative(filePath, projectContext.projectPath).string(),
+                                                methodName};
+                CollectionUtils::extend(row, kleeTimesToStrings(methodKleeStats));
+                CollectionUtils::extend(row, kleeCountersToStrings(methodKleeStats));
+                if (!printer.printRow(row)) {
+                    return printer;
+                }
+            }
+        }
+        return printer;
+    }
+
+    void TestsGenerationStatsFileMap::addFileStats(const KleeStats &kleeStats, const tests::Tests &tests,
+                                                   std::map<std::string, KleeStats> methodsKleeStats) {
+        statsMap[tests.sourceFilePath] = TestsGenerationStats(kleeStats, tests, std::move(methodsKleeStats));
     }
 }
@@ -15,9 +15,12 @@ namespace StatsUtils {
     public:
         TestsGenerationStats() = default;
 
-        TestsGenerationStats(const KleeStats &kleeStats, const tests::Tests &tests);
+        TestsGenerationStats(const KleeStats &kleeStats, const tests::Tests &tests,
+                             std::map<std::string, KleeStats> methodsKleeStats = {});
 
         KleeStats kleeStats;
+        // map method name to KLEE statistics of its own run, is not summed up into total
+        std::map<std::string, KleeStats> methodsKleeStats;
         // map test-suite name to number of generated tests in this suite
         std::map<std::string, uint32_t> numTestsInSuite;
         uint32_t numCoveredFunctions = 0;
@@ -37,12 +40,18 @@ namespace StatsUtils {
         TestsGenerationStatsFileMap(utbot::ProjectContext projectContext, std::chrono::milliseconds preprocessingTime)
                 : FileStatsMap(std::move(projectContext)), preprocessingTime(preprocessingTime) {}
 
-        void addFileStats(const KleeStats &kleeStats, const tests::Tests &tests);
+        void addFileStats(const KleeStats &kleeStats, const tests::Tests &tests,
+                          std::map<std::string, KleeStats> methodsKleeStats = {});
 
         std::vector<std::string> getHeader() override;
 
         std::vector<std::string> getTotalStrings() override;
 
+        /**
+         * Prints statistics of KLEE runs of single functions, a row per function.
+         */
+        printer::CSVPrinter functionsToCSV();
+
     private:
         std::chrono::milliseconds preprocessingTime;
     };
@@ -38,12 +38,12 @@ namespace visitor {
         if (!inserted) {
             return;
         }
-        auto structInfo = typesHandler->getStructInfo(type);
+        const auto &structInfo = typesHandler->getStructInfo(type);
         for (const auto &[name, field] : structInfo.functionFields) {
             auto stubName = StubsUtils::getFunctionPointerAsStructFieldStubName(structInfo.name, name, true);
             printer.writeStubForParam(typesHandler, field, structInfo.name, stubName, false, true);
         }
-        for (auto &field : structInfo.fields) {
+        for (const auto &field : structInfo.fields) {
             if (!types::TypesHandler::isPointerToFunction(field.type) &&
                 !types::TypesHandler::isArrayOfPointersToFunction(field.type)) {
                 visitAny(field.type, name, nullptr, access, depth + 1);
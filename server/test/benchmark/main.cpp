@@ -0,0 +1,131 @@
+#include "TestUtils.h"
+#include "Version.h"
+#include "coverage/CoverageAndResultsGenerator.h"
+#include "streams/coverage/ServerCoverageAndResultsWriter.h"
+#include "tasks/BaseForkTask.h"
+#include "utils/CLIUtils.h"
+#include "utils/CompilationUtils.h"
+#include "utils/FileSystemUtils.h"
+#include "utils/JsonUtils.h"
+#include "utils/stats/StageStats.h"
+
+#include "loguru.h"
+
+#include <llvm/Support/Signals.h>
+
+#include <chrono>
+#include <iostream>
+
+namespace {
+    using CompilationUtils::CompilerName;
+
+    const std::string PROJECT_NAME = "benchmark-project";
+
+    std::vector<fs::path> getSrcPaths(const fs::path &suitePath) {
+        std::vector<fs::path> srcPaths = { suitePath };
+        for (const auto &entry : fs::directory_iterator(suitePath)) {
+            const std::string name = entry.path().filename().string();
+            if (entry.is_directory() && !StringUtils::startsWith(name, "build") &&
+                name != Paths::UTBOT_TESTS && name != Paths::UTBOT_REPORT) {
+                srcPaths.emplace_back(entry.path());
+            }
+        }
+        return srcPaths;
+    }
+
+    /*
+     * Runs the whole pipeline for one suite: generation of tests for the project
+     * (fetch, synchronize, klee files build, link, KLEE, ktest parse, print) followed by
+     * test run and coverage collection. Stage statistics are collected by StatsUtils::StageTimer.
+     */
+    nlohmann::json benchmarkSuite(const std::string &suiteName, CompilerName compilerName) {
+        nlohmann::json result;
+        result["suite"] = suiteName;
+        result["compiler"] = CompilationUtils::to_string(compilerName);
+
+        fs::path suiteRelPath = testUtils::getRelativeTestSuitePath(suiteName);
+        fs::path suitePath = fs::current_path().parent_path() / suiteRelPath;
+        std::string buildDirRelPath = CompilationUtils::getBuildDirectoryName(compilerName);
+        testUtils::tryExecGetBuildCommands(suiteRelPath, compilerName);
+        FileSystemUtils::removeAll(suitePath / buildDirRelPath / CompilationUtils::UTBOT_FILES_DIR_NAME);
+        FileSystemUtils::removeAll(suitePath / Paths::UTBOT_TESTS);
+
+        StatsUtils::StageTimer::clearStatistic();
+        uint64_t spawnedProcessesBefore = BaseForkTask::getSpawnedProcessesCount();
+        auto start = std::chrono::steady_clock::now();
+
+        auto writer = std::make_unique<ServerTestsWriter>(nullptr, false);
+        auto request = testUtils::createProjectRequest(PROJECT_NAME, suitePath, buildDirRelPath,
+                                                       getSrcPaths(suitePath));
+        auto testGen = ProjectTestGen(*request, writer.get(), true);
+        Status status = Server::TestsGenServiceImpl::ProcessBaseTestRequest(testGen, writer.get());
+        result["generationStatus"] = status.ok() ? "OK" : status.error_message();
+        result["testsGenerated"] = testUtils::getNumberOfTests(testGen.tests);
+
+        if (status.ok()) {
+            auto runRequest = testUtils::createCoverageAndResultsRequest(
+                PROJECT_NAME, suitePath, suitePath / Paths::UTBOT_TESTS, buildDirRelPath,
+                GrpcUtils::createTestFilterForProject());
+            auto coverageAndResultsWriter = std::make_unique<ServerCoverageAndResultsWriter>(nullptr);
+            CoverageAndResultsGenerator coverageGenerator{ runRequest.get(), coverageAndResultsWriter.get() };
+            utbot::SettingsContext settingsContext{ true, true, 30, 0, true, false, ErrorMode::FAILING, false,
+                                                    false, false };
+            Status runStatus = coverageGenerator.generate(true, settingsContext);
+            result["testRunStatus"] = runStatus.ok() ? "OK" : runStatus.error_message();
+            auto resultMap = coverageGenerator.getTestResultMap();
+            result["testsRun"] = resultMap.getNumberOfTests();
+        }
+
+        result["totalWallTimeMs"] = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                        std::chrono::steady_clock::now() - start).count();
+        result["totalSpawnedProcesses"] = BaseForkTask::getSpawnedProcessesCount() - spawnedProcessesBefore;
+        // peak of the whole benchmark process, stages report only growth of it
+        result["peakRssKb"] = StatsUtils::getPeakRssKb(false);
+        result["peakChildrenRssKb"] = StatsUtils::getPeakRssKb(true);
+        result["stages"] = StatsUtils::StageTimer::statisticToJson();
+        return result;
+    }
+}
+
+//Usage: ./utbot_bench [--suite <name>]... [--compiler clang|gcc] [--output <report.json>]
+int main(int argc, char **argv) {
+    llvm::sys::PrintStackTraceOnErrorSignal(argv[0]);
+
+    CLI::App app{ "Performance benchmark of UTBot generation pipeline", "utbot_bench" };
+    std::vector<std::string> suites = { "server", "coverage", "small-project" };
+    std::string compiler = "clang";
+    std::string outputPath;
+    std::string verbosity = "info";
+    app.add_option("--suite", suites, "Test suites from test/suites to run through the pipeline.");
+    app.add_option("--compiler", compiler, "Compiler used to build the suites.")
+        ->check(CLI::IsMember({ "clang", "gcc" }));
+    app.add_option("--output", outputPath, "Path to JSON report. Report is printed to stdout if omitted.");
+    app.add_option("--verbosity", verbosity, "Logger verbosity.");
+    CLI11_PARSE(app, argc, argv);
+
+    auto ctx = std::make_unique<ServerContext>();
+    ServerUtils::setThreadOptions(ctx.get(), true);
+    CLIUtils::setupLogger("", CLIUtils::getVerbosityLevelFromName(verbosity.c_str()), false);
+
+    CompilerName compilerName = compiler == "gcc" ? CompilerName::GCC : CompilerName::CLANG;
+    nlohmann::json report;
+    report["version"] = UTBOT_BUILD_VERSION;
+    report["suites"] = nlohmann::json::array();
+    try {
+        for (const auto &suite : suites) {
+            LOG_S(INFO) << "Benchmarking suite " << suite;
+            report["suites"].push_back(benchmarkSuite(suite, compilerName));
+        }
+    } catch (const std::exception &e) {
+        LOG_S(ERROR) << "Benchmark failed: " << e.what();
+        return 1;
+    }
+
+    if (outputPath.empty()) {
+        std::cout << report.dump(JsonUtils::INDENT) << std::endl;
+    } else {
+        JsonUtils::writeJsonToFile(outputPath, report);
+        LOG_S(INFO) << "Benchmark report: " << outputPath;
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "gtest/gtest.h"
+
+#include "building/BitcodeCache.h"
+#include "building/InProcessCompiler.h"
+#include "environment/EnvironmentPaths.h"
+#include "utils/FileSystemUtils.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    class BitcodeCache_Test : public testing::Test {
+    protected:
+        fs::path dir = fs::current_path() / "bitcode_cache_test";
+        fs::path storeDir = dir / "store";
+        fs::path sourcePath = dir / "project" / "lib.c";
+        InProcessCompiler compiler{ dir / "compile.log" };
+
+        void SetUp() override {
+            FileSystemUtils::removeAll(dir);
+            FileSystemUtils::writeToFile(sourcePath, "int lib(int x) { return x + 1; }\n");
+        }
+
+        void TearDown() override {
+            FileSystemUtils::removeAll(dir);
+        }
+
+        utbot::CompileCommand getCommand(const fs::path &output) const {
+            return { { Paths::getUTBotClang().string(), "-c", "-O0", sourcePath.string(), "-o", output.string() },
+                     sourcePath.parent_path(),
+                     sourcePath };
+        }
+
+        /// stands for the compilation, contents of the output are not looked into by the store
+        static void compile(const std::vector<BitcodeCache::Entry> &entries, const std::string &bitcode) {
+            for (const auto &entry : entries) {
+                FileSystemUtils::writeToFile(entry.command.getOutput(), bitcode);
+            }
+        }
+
+        static std::string readFile(const fs::path &path) {
+            std::ifstream stream(path.string());
+            return { std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+        }
+    };
+
+    TEST_F(BitcodeCache_Test, Output_Is_Restored_For_Command_With_Another_Output) {
+        BitcodeCache cache(storeDir, 1024 * 1024);
+        auto misses = cache.restore({ getCommand(dir / "first" / "lib.bc") }, compiler);
+        ASSERT_EQ(misses.size(), 1u);
+        ASSERT_TRUE(misses[0].key.has_value());
+        compile(misses, "bitcode");
+        cache.store(misses);
+
+        fs::path secondOutput = dir / "second" / "lib.bc";
+        EXPECT_TRUE(cache.restore({ getCommand(secondOutput) }, compiler).empty());
+        EXPECT_EQ(readFile(secondOutput), "bitcode");
+    }
+
+    TEST_F(BitcodeCache_Test, Key_Is_Stable_And_Depends_On_Source_And_Flags) {
+        BitcodeCache cache(storeDir, 1024 * 1024);
+        auto first = cache.restore({ getCommand(dir / "first" / "lib.bc") }, compiler);
+        auto second = cache.restore({ getCommand(dir / "second" / "lib.bc") }, compiler);
+        ASSERT_EQ(first.size(), 1u);
+        ASSERT_EQ(second.size(), 1u);
+        EXPECT_EQ(first[0].key, second[0].key);
+
+        auto optimized = getCommand(dir / "first" / "lib.bc");
+        optimized.addFlagToBegin("-DOPTIMIZED");
+        auto withFlag = cache.restore({ optimized }, compiler);
+        ASSERT_EQ(withFlag.size(), 1u);
+        EXPECT_NE(withFlag[0].key, first[0].key);
+
+        FileSystemUtils::writeToFile(sourcePath, "int lib(int x) { return x + 2; }\n");
+        auto changed = cache.restore({ getCommand(dir / "first" / "lib.bc") }, compiler);
+        ASSERT_EQ(changed.size(), 1u);
+        EXPECT_NE(changed[0].key, first[0].key);
+    }
+
+    TEST_F(BitcodeCache_Test, Restore_Does_Not_Change_Time_Of_Linked_Outputs) {
+        BitcodeCache cache(storeDir, 1024 * 1024);
+        fs::path firstOutput = dir / "first" / "lib.bc";
+        auto misses = cache.restore({ getCommand(firstOutput) }, compiler);
+        compile(misses, "bitcode");
+        cache.store(misses);
+
+        fs::path secondOutput = dir / "second" / "lib.bc";
+        ASSERT_TRUE(cache.restore({ getCommand(secondOutput) }, compiler).empty());
+        auto time = std::filesystem::last_write_time(secondOutput.string());
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ASSERT_TRUE(cache.restore({ getCommand(dir / "third" / "lib.bc") }, compiler).empty());
+        // make decides whether outputs are outdated by their modification time
+        EXPECT_EQ(std::filesystem::last_write_time(secondOutput.string()), time);
+    }
+
+    TEST_F(BitcodeCache_Test, Trim_Removes_Least_Recently_Used_And_Keeps_Temporary_Files) {
+        const std::string bitcode(600, 'b');
+        BitcodeCache cache(storeDir, 1000);
+        auto first = cache.restore({ getCommand(dir / "first" / "lib.bc") }, compiler);
+        compile(first, bitcode);
+        cache.store(first);
+        // file of another server which is not renamed into place yet
+        fs::path temporaryPath = storeDir / "00" / "in_flight.bc.1.2.tmp";
+        FileSystemUtils::writeToFile(temporaryPath, bitcode);
+
+        FileSystemUtils::writeToFile(sourcePath, "int lib(int x) { return x + 2; }\n");
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        auto second = cache.restore({ getCommand(dir / "second" / "lib.bc") }, compiler);
+        compile(second, bitcode);
+        cache.store(second);
+
+        EXPECT_TRUE(fs::exists(temporaryPath));
+        EXPECT_TRUE(cache.restore({ getCommand(dir / "third" / "lib.bc") }, compiler).empty());
+        FileSystemUtils::writeToFile(sourcePath, "int lib(int x) { return x + 1; }\n");
+        EXPECT_EQ(cache.restore({ getCommand(dir / "fourth" / "lib.bc") }, compiler).size(), 1u);
+    }
+}
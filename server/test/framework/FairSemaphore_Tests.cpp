@@ -0,0 +1,61 @@
+#include "gtest/gtest.h"
+
+#include "utils/FairSemaphore.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    // time for a started thread to enqueue its request
+    const auto QUEUE_DELAY = std::chrono::milliseconds(100);
+
+    TEST(FairSemaphore_Test, TryLockTakesFreeSlotsOnly) {
+        FairSemaphore semaphore(2);
+        EXPECT_TRUE(semaphore.try_lock());
+        EXPECT_TRUE(semaphore.try_lock());
+        EXPECT_FALSE(semaphore.try_lock());
+        semaphore.unlock();
+        EXPECT_TRUE(semaphore.try_lock());
+        semaphore.unlock();
+        semaphore.unlock();
+    }
+
+    TEST(FairSemaphore_Test, SlotsAreGrantedInOrderOfRequests) {
+        FairSemaphore semaphore(1);
+        semaphore.lock();
+        std::mutex orderMutex;
+        std::vector<int> order;
+        std::vector<std::thread> waiters;
+        for (int i = 0; i < 3; ++i) {
+            waiters.emplace_back([&, i]() {
+                std::lock_guard<FairSemaphore> slot(semaphore);
+                std::lock_guard<std::mutex> lock(orderMutex);
+                order.push_back(i);
+            });
+            std::this_thread::sleep_for(QUEUE_DELAY);
+        }
+        semaphore.unlock();
+        for (auto &waiter : waiters) {
+            waiter.join();
+        }
+        EXPECT_EQ(order, (std::vector<int>{ 0, 1, 2 }));
+    }
+
+    TEST(FairSemaphore_Test, TryLockDoesNotOvertakeWaiters) {
+        FairSemaphore semaphore(1);
+        semaphore.lock();
+        std::thread waiter([&]() {
+            std::lock_guard<FairSemaphore> slot(semaphore);
+            std::this_thread::sleep_for(QUEUE_DELAY);
+        });
+        std::this_thread::sleep_for(QUEUE_DELAY);
+        semaphore.unlock();
+        // the slot is free for a moment, but it belongs to the waiting thread
+        EXPECT_FALSE(semaphore.try_lock());
+        waiter.join();
+        EXPECT_TRUE(semaphore.try_lock());
+        semaphore.unlock();
+    }
+}
@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+
+#include "building/InProcessCompiler.h"
+#include "environment/EnvironmentPaths.h"
+#include "tasks/ShellExecTask.h"
+#include "utils/FileSystemUtils.h"
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    class InProcessCompiler_Test : public testing::Test {
+    protected:
+        const std::string projectName = "in_process_compiler_test";
+        fs::path dir = fs::current_path() / projectName;
+        fs::path headerPath = dir / "project" / "lib.h";
+        std::vector<fs::path> sourcePaths = { dir / "project" / "first.c", dir / "project" / "second.c" };
+        InProcessCompiler compiler{ dir / "compile.log" };
+
+        void SetUp() override {
+            FileSystemUtils::removeAll(dir);
+            FileSystemUtils::writeToFile(headerPath, "struct Point { int x; int y; };\n"
+                                                     "#define SCALE(v) ((v) * FACTOR)\n");
+            FileSystemUtils::writeToFile(sourcePaths[0], "#include \"lib.h\"\n"
+                                                         "int first(struct Point p) { return SCALE(p.x); }\n");
+            FileSystemUtils::writeToFile(sourcePaths[1], "#include \"lib.h\"\n"
+                                                         "int second(struct Point *p) { return p ? SCALE(p->y) : 0; }\n");
+        }
+
+        void TearDown() override {
+            FileSystemUtils::removeAll(dir);
+        }
+
+        utbot::CompileCommand getCommand(const fs::path &sourcePath, const fs::path &output) const {
+            return { { Paths::getUTBotClang().string(), "-c", "-emit-llvm", "-O0", "-DFACTOR=3",
+                       sourcePath.string(), "-o", output.string() },
+                     sourcePath.parent_path(),
+                     sourcePath };
+        }
+
+        /// compiles the command by the external compiler and returns its output
+        fs::path compileExternally(const fs::path &sourcePath) const {
+            fs::path output = dir / "external" / sourcePath.filename().replace_extension(".bc");
+            fs::create_directories(output.parent_path());
+            auto result = ShellExecTask::executeUtbotCommand(getCommand(sourcePath, output),
+                                                             sourcePath.parent_path(), projectName);
+            EXPECT_EQ(result.status, 0) << result.output;
+            return output;
+        }
+
+        /// module identifiers and attribute groups are left out, so only code of functions is compared
+        static std::map<std::string, std::string> getFunctions(const fs::path &bitcode) {
+            llvm::LLVMContext context;
+            llvm::SMDiagnostic error;
+            std::unique_ptr<llvm::Module> module = llvm::parseIRFile(bitcode.string(), error, context);
+            EXPECT_NE(module, nullptr) << bitcode;
+            std::map<std::string, std::string> functions;
+            if (module == nullptr) {
+                return functions;
+            }
+            for (const auto &function : *module) {
+                std::string text;
+                llvm::raw_string_ostream stream(text);
+                function.print(stream);
+                functions.emplace(function.getName().str(), stream.str());
+            }
+            return functions;
+        }
+    };
+
+    TEST_F(InProcessCompiler_Test, Bitcode_Matches_External_Compiler) {
+        fs::path output = dir / "in_process" / "first.bc";
+        auto result = compiler.compile(getCommand(sourcePaths[0], output));
+        ASSERT_EQ(result.status, 0) << result.output;
+
+        auto functions = getFunctions(output);
+        EXPECT_EQ(functions.count("first"), 1u);
+        EXPECT_EQ(functions, getFunctions(compileExternally(sourcePaths[0])));
+    }
+
+    TEST_F(InProcessCompiler_Test, Parallel_Compilations_With_Shared_Header_Match_External_Compiler) {
+        std::vector<utbot::CompileCommand> commands;
+        for (const auto &sourcePath : sourcePaths) {
+            commands.push_back(getCommand(sourcePath, dir / "in_process" / sourcePath.filename().replace_extension(".bc")));
+        }
+        auto failure = compiler.compile(commands);
+        ASSERT_FALSE(failure.has_value()) << failure->result.output;
+
+        for (const auto &command : commands) {
+            EXPECT_EQ(getFunctions(command.getOutput()), getFunctions(compileExternally(command.getSourcePath())))
+                << command.getSourcePath();
+        }
+    }
+
+    TEST_F(InProcessCompiler_Test, Failure_Is_Reported_Like_External_Compiler) {
+        FileSystemUtils::writeToFile(sourcePaths[0], "#include \"lib.h\"\n"
+                                                     "int first(struct Point p) { return p.z; }\n");
+        fs::path output = dir / "in_process" / "first.bc";
+        auto result = compiler.compile(getCommand(sourcePaths[0], output));
+        EXPECT_NE(result.status, 0);
+        EXPECT_NE(result.output.find("no member named 'z'"), std::string::npos) << result.output;
+
+        fs::path externalOutput = dir / "external" / "first.bc";
+        auto external = ShellExecTask::executeUtbotCommand(getCommand(sourcePaths[0], externalOutput),
+                                                           sourcePaths[0].parent_path(), projectName);
+        EXPECT_NE(external.status, 0);
+        EXPECT_NE(external.output.find("no member named 'z'"), std::string::npos) << external.output;
+    }
+}
@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+
+#include "RequestEnvironment.h"
+#include "Server.h"
+#include "utils/LogUtils.h"
+
+#include "loguru.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+    using grpc::ClientContext;
+    using grpc::ClientReader;
+    using testsgen::DummyRequest;
+    using testsgen::DummyResponse;
+    using testsgen::HeartbeatResponse;
+    using testsgen::LogChannelRequest;
+    using testsgen::LogEntry;
+    using testsgen::TestsGenService;
+
+    const std::string CLIENT = "log_channel_test_client";
+
+    class LogChannel_Test : public testing::Test {
+    protected:
+        Server server = Server(true);
+        std::unique_ptr<grpc::Server> grpcServer;
+        std::unique_ptr<TestsGenService::Stub> stub;
+
+        void SetUp() override {
+            grpc::ServerBuilder builder;
+            builder.RegisterService(&server.testsService);
+            grpcServer = builder.BuildAndStart();
+            stub = TestsGenService::NewStub(grpcServer->InProcessChannel({}));
+        }
+
+        void TearDown() override {
+            grpcServer->Shutdown();
+        }
+
+        static void setClient(ClientContext &context) {
+            context.AddMetadata("clientid", CLIENT);
+            context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(30));
+        }
+
+        std::unique_ptr<ClientReader<LogEntry>> openLogChannel(ClientContext &context) {
+            setClient(context);
+            LogChannelRequest request;
+            request.set_loglevel("INFO");
+            return stub->OpenLogChannel(&context, request);
+        }
+
+        /**
+         * Logs on behalf of the client until the entry is read from the channel, because
+         * entries reach the channel only after the server has handled the request.
+         */
+        static bool readLoggedEntry(ClientReader<LogEntry> &reader, const std::string &text) {
+            std::atomic_bool received = false;
+            std::thread logger([&]() {
+                RequestEnvironment::setClientId(CLIENT);
+                while (!received) {
+                    LOG_S(INFO) << text;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+            });
+            LogEntry entry;
+            bool found = false;
+            while (!found && reader.Read(&entry)) {
+                found = entry.message().find(text) != std::string::npos;
+            }
+            received = true;
+            logger.join();
+            return found;
+        }
+
+        static grpc::Status readUntilFinished(ClientReader<LogEntry> &reader) {
+            LogEntry entry;
+            while (reader.Read(&entry)) {
+            }
+            return reader.Finish();
+        }
+    };
+
+    TEST_F(LogChannel_Test, Channel_Of_Outdated_Client_Is_Finished_And_Reopened) {
+        ClientContext heartbeatContext;
+        setClient(heartbeatContext);
+        HeartbeatResponse heartbeat;
+        ASSERT_TRUE(stub->Heartbeat(&heartbeatContext, DummyRequest(), &heartbeat).ok());
+
+        ClientContext firstContext;
+        auto first = openLogChannel(firstContext);
+        ASSERT_TRUE(readLoggedEntry(*first, "entry of the first channel"));
+
+        LogUtils::closeOutdatedLogChannels(server, TimeUtils::now() + 2 * TimeUtils::IDLE_TIMEOUT);
+        EXPECT_TRUE(readUntilFinished(*first).ok());
+
+        ClientContext secondContext;
+        auto second = openLogChannel(secondContext);
+        ASSERT_TRUE(readLoggedEntry(*second, "entry of the second channel"));
+
+        ClientContext closeContext;
+        setClient(closeContext);
+        DummyResponse response;
+        ASSERT_TRUE(stub->CloseLogChannel(&closeContext, DummyRequest(), &response).ok());
+        EXPECT_TRUE(readUntilFinished(*second).ok());
+    }
+
+    TEST_F(LogChannel_Test, Second_Open_Of_Open_Channel_Is_Finished_At_Once) {
+        ClientContext firstContext;
+        auto first = openLogChannel(firstContext);
+        ASSERT_TRUE(readLoggedEntry(*first, "entry before the second open"));
+
+        ClientContext secondContext;
+        auto second = openLogChannel(secondContext);
+        EXPECT_TRUE(readUntilFinished(*second).ok());
+        EXPECT_TRUE(readLoggedEntry(*first, "entry after the second open"));
+
+        ClientContext closeContext;
+        setClient(closeContext);
+        DummyResponse response;
+        ASSERT_TRUE(stub->CloseLogChannel(&closeContext, DummyRequest(), &response).ok());
+        EXPECT_TRUE(readUntilFinished(*first).ok());
+    }
+}
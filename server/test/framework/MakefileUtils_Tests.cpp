@@ -0,0 +1,48 @@
+#include "gtest/gtest.h"
+
+#include "Paths.h"
+#include "utils/FileSystemUtils.h"
+#include "utils/MakefileUtils.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace {
+    class MakefileUtils_Test : public testing::Test {
+    protected:
+        const std::string projectName = "makefile_utils_test";
+        fs::path dir = fs::current_path() / projectName;
+        fs::path makefile = dir / "test.mk";
+        utbot::ProjectContext projectContext{ projectName, dir, dir, "tests", "report", "build", "" };
+        fs::path logFile = Paths::getLogDir(projectName) / "makefile.log";
+
+        void SetUp() override {
+            FileSystemUtils::removeAll(dir);
+            fs::remove(logFile);
+            FileSystemUtils::writeToFile(makefile, "fail:\n\techo failing recipe && false\n");
+        }
+
+        void TearDown() override {
+            FileSystemUtils::removeAll(dir);
+        }
+
+        std::string readLog() const {
+            std::ifstream stream(logFile.string());
+            return { std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+        }
+    };
+
+    TEST_F(MakefileUtils_Test, Recipes_And_Executed_Command_Are_Kept_On_Failure) {
+        MakefileUtils::MakefileCommand command(projectContext, makefile, "fail");
+        auto result = command.run(dir, true, true);
+        ASSERT_NE(result.status, 0);
+
+        std::string log = readLog();
+        EXPECT_NE(log.find("echo failing recipe && false"), std::string::npos) << log;
+        // the reported command has the -j flag the run was actually started with
+        std::string failedCommand = command.getFailedCommand();
+        EXPECT_NE(failedCommand.find(" -j"), std::string::npos) << failedCommand;
+        EXPECT_NE(log.find(failedCommand), std::string::npos) << log;
+    }
+}
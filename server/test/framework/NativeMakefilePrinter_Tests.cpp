@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+
+#include "printers/NativeMakefilePrinter.h"
+#include "utils/FileSystemUtils.h"
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+namespace {
+    using printer::NativeMakefilePrinter;
+
+    class NativeMakefilePrinter_Test : public testing::Test {
+    protected:
+        fs::path cacheDirectory = fs::current_path() / "gtest_cache_test";
+
+        void SetUp() override {
+            FileSystemUtils::removeAll(cacheDirectory);
+        }
+
+        void TearDown() override {
+            FileSystemUtils::removeAll(cacheDirectory);
+        }
+
+        /// creates directories of configurations, the first one is the least recently used
+        void createConfigurations(size_t count) const {
+            auto time = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+            for (size_t i = 0; i < count; ++i) {
+                fs::path configuration = cacheDirectory / std::to_string(i);
+                FileSystemUtils::writeToFile(configuration / "gtest-all.cc.o", "object");
+                std::filesystem::last_write_time(configuration.string(), time + std::chrono::minutes(i));
+            }
+        }
+    };
+
+    TEST_F(NativeMakefilePrinter_Test, Gtest_Cache_Keeps_Recently_Used_Configurations) {
+        const size_t count = NativeMakefilePrinter::GTEST_CACHE_CAPACITY + 2;
+        createConfigurations(count);
+        NativeMakefilePrinter::trimGtestCache(cacheDirectory);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(fs::exists(cacheDirectory / std::to_string(i)), i >= 2) << i;
+        }
+    }
+
+    TEST_F(NativeMakefilePrinter_Test, Gtest_Cache_Within_Capacity_Is_Not_Trimmed) {
+        createConfigurations(NativeMakefilePrinter::GTEST_CACHE_CAPACITY);
+        NativeMakefilePrinter::trimGtestCache(cacheDirectory);
+        for (size_t i = 0; i < NativeMakefilePrinter::GTEST_CACHE_CAPACITY; ++i) {
+            EXPECT_TRUE(fs::exists(cacheDirectory / std::to_string(i))) << i;
+        }
+    }
+
+    TEST_F(NativeMakefilePrinter_Test, Missing_Gtest_Cache_Is_Ignored) {
+        NativeMakefilePrinter::trimGtestCache(cacheDirectory);
+        EXPECT_FALSE(fs::exists(cacheDirectory));
+    }
+}
@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+
+#include "utils/ResourceScheduler.h"
+
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+extern char **environ;
+
+namespace {
+    // time for a started thread to start waiting for tokens
+    const auto QUEUE_DELAY = std::chrono::milliseconds(200);
+
+    using Kind = ResourceScheduler::Kind;
+
+    TEST(ResourceScheduler_Test, Client_Alone_Takes_All_Tokens) {
+        ResourceScheduler scheduler(4, 0);
+        auto tokens = scheduler.acquire(Kind::COMPILER_JOB, 8, 1);
+        EXPECT_EQ(tokens.count(), 4u);
+    }
+
+    TEST(ResourceScheduler_Test, Competing_Clients_Get_Fair_Shares) {
+        ResourceScheduler scheduler(4, 0);
+        std::optional<ResourceScheduler::Tokens> held = scheduler.acquire(Kind::COMPILER_JOB, 4, 1);
+        ASSERT_EQ(held->count(), 4u);
+
+        std::atomic<size_t> firstClientTokens = 0, secondClientTokens = 0;
+        std::thread firstClient([&]() {
+            auto tokens = scheduler.acquire(Kind::COMPILER_JOB, 4, 1);
+            firstClientTokens = tokens.count();
+        });
+        std::thread secondClient([&]() {
+            auto tokens = scheduler.acquire(Kind::COMPILER_JOB, 4, 2);
+            secondClientTokens = tokens.count();
+        });
+        std::this_thread::sleep_for(QUEUE_DELAY);
+        EXPECT_EQ(firstClientTokens, 0u);
+        EXPECT_EQ(secondClientTokens, 0u);
+
+        held.reset();
+        firstClient.join();
+        secondClient.join();
+        EXPECT_EQ(firstClientTokens, 2u);
+        EXPECT_EQ(secondClientTokens, 2u);
+    }
+
+    TEST(ResourceScheduler_Test, Klee_Launch_Is_Deferred_While_Memory_Limit_Is_Exceeded) {
+        // any child process exceeds the limit of one byte
+        ResourceScheduler scheduler(2, 1);
+        auto job = scheduler.acquire(Kind::COMPILER_JOB, 1, 1);
+        pid_t child;
+        char sleepCommand[] = "sleep", sleepTime[] = "30";
+        char *argv[] = { sleepCommand, sleepTime, nullptr };
+        ASSERT_EQ(posix_spawnp(&child, "sleep", nullptr, nullptr, argv, environ), 0);
+
+        // compiler jobs are not deferred
+        EXPECT_EQ(scheduler.acquire(Kind::COMPILER_JOB, 1, 2).count(), 1u);
+        std::atomic_bool launched = false;
+        std::thread klee([&]() {
+            auto tokens = scheduler.acquire(Kind::KLEE_PROCESS, 1, 2);
+            launched = true;
+        });
+        std::this_thread::sleep_for(QUEUE_DELAY);
+        EXPECT_FALSE(launched);
+
+        kill(child, SIGKILL);
+        waitpid(child, nullptr, 0);
+        klee.join();
+        EXPECT_TRUE(launched);
+    }
+}
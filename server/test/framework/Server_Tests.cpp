@@ -5,14 +5,22 @@
 #include "ProjectContext.h"
 #include "Server.h"
 #include "clang-utils/SourceToHeaderRewriter.h"
+#include "commands/Commands.h"
 #include "coverage/CoverageAndResultsGenerator.h"
 #include "printers/HeaderPrinter.h"
 #include "printers/TestMakefilesPrinter.h"
 #include "printers/SourceWrapperPrinter.h"
 #include "utils/FileSystemUtils.h"
+#include "utils/HashUtils.h"
+#include "utils/KleeUtils.h"
 #include "utils/ServerUtils.h"
+#include "utils/StringUtils.h"
+#include "utils/stats/CSVReader.h"
 
 #include "utils/path/FileSystemPath.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <tuple>
 
@@ -64,7 +72,7 @@ namespace {
                                                                   Paths::UTBOT_ITF);
 
             auto settingsContext = GrpcUtils::createSettingsContext(true, false, 30, 0, false, false,
-                                                                    ErrorMode::PASSING, false, false);
+                                                                    ErrorMode::PASSING, false, false, false);
 
             auto request = GrpcUtils::createProjectRequest(std::move(projectContext),
                                                            std::move(settingsContext),
@@ -949,6 +957,29 @@ namespace {
         checkAlignment(testGen);
     }
 
+    TEST_F(Server_Test, Klee_Output_Dir_Is_Used_And_Removed_After_Run) {
+        fs::path kleeOutputDir = fs::current_path() / "klee_output_dir_test";
+        FileSystemUtils::removeAll(kleeOutputDir);
+        auto request = createProjectRequest(projectName, suitePath, buildDirRelPath, srcPaths);
+        utbot::ProjectContext projectContext(request->projectcontext());
+        fs::path defaultKleeOutDir = Paths::getKleeOutDir(projectContext);
+        FileSystemUtils::removeAll(defaultKleeOutDir);
+
+        Commands::kleeOutputDir = kleeOutputDir.string();
+        fs::path kleeOutDir = Paths::getKleeOutDir(projectContext);
+        auto [testGen, status] = performFeatureFileTestsRequest(basic_functions_c);
+        Commands::kleeOutputDir.clear();
+        ASSERT_TRUE(status.ok()) << status.error_message();
+        testUtils::checkMinNumberOfTests(testGen.tests, 1);
+
+        // directory of the project is named by the digest of its build directory
+        EXPECT_EQ(kleeOutDir.parent_path(),
+                  kleeOutputDir / (projectName + "_" + HashUtils::sha1(Paths::getUTBotFiles(projectContext).string())));
+        EXPECT_FALSE(fs::exists(kleeOutDir.parent_path())) << "Directory of the project is not removed";
+        EXPECT_FALSE(fs::exists(defaultKleeOutDir)) << "Build directory is used for KLEE output";
+        FileSystemUtils::removeAll(kleeOutputDir);
+    }
+
     class Parameterized_Server_Test : public Server_Test,
                                       public testing::WithParamInterface<std::tuple<CompilerName>> {
     protected:
@@ -1012,6 +1043,71 @@ namespace {
         }
     }
 
+    TEST_P(Parameterized_Server_Test, Project_Test_Resume) {
+        std::string suite = "small-project";
+        setSuite(suite);
+        srcPaths = {suitePath, suitePath / "lib", suitePath / "src"};
+        auto createRequest = [&](bool incrementalGeneration, bool resume) {
+            auto projectContext = GrpcUtils::createProjectContext(
+                projectName, suitePath, Paths::UTBOT_TESTS, Paths::UTBOT_REPORT, buildDirRelPath, "");
+            auto settingsContext = GrpcUtils::createSettingsContext(
+                true, true, 60, 0, false, false, ErrorMode::FAILING, false, false, incrementalGeneration);
+            return GrpcUtils::createProjectRequest(std::move(projectContext), std::move(settingsContext),
+                                                   srcPaths, GrpcUtils::UTBOT_AUTO_TARGET_PATH, resume);
+        };
+
+        // output kept by incremental generation is laid out as the journal of an interrupted generation
+        auto request = createRequest(true, false);
+        auto testGen = ProjectTestGen(*request, writer.get(), TESTMODE);
+        Status status = Server::TestsGenServiceImpl::ProcessBaseTestRequest(testGen, writer.get());
+        ASSERT_TRUE(status.ok()) << status.error_message();
+        fs::path journalDir = Paths::getGenerationJournalDir(testGen.projectContext);
+        FileSystemUtils::removeAll(journalDir);
+        std::filesystem::copy(Paths::getKleeResultsDir(testGen.projectContext).string(), journalDir.string(),
+                              std::filesystem::copy_options::recursive);
+
+        // a journaled function without test cases shows that KLEE is not run for it again
+        fs::path emptiedDir;
+        for (const auto &entry : fs::recursive_directory_iterator(journalDir)) {
+            if (Paths::isKtest(entry.path())) {
+                emptiedDir = entry.path().parent_path();
+                break;
+            }
+        }
+        ASSERT_FALSE(emptiedDir.empty()) << "Output of KLEE is not kept";
+        while (!StringUtils::startsWith(emptiedDir.filename().string(), "klee_entry__")) {
+            emptiedDir = emptiedDir.parent_path();
+        }
+        std::vector<fs::path> ktests;
+        for (const auto &entry : fs::recursive_directory_iterator(emptiedDir)) {
+            if (Paths::isKtest(entry.path())) {
+                ktests.push_back(entry.path());
+            }
+        }
+        for (const auto &ktest : ktests) {
+            fs::remove(ktest);
+        }
+
+        auto resumeRequest = createRequest(false, true);
+        auto resumedTestGen = ProjectTestGen(*resumeRequest, writer.get(), TESTMODE);
+        status = Server::TestsGenServiceImpl::ProcessBaseTestRequest(resumedTestGen, writer.get());
+        ASSERT_TRUE(status.ok()) << status.error_message();
+        EXPECT_FALSE(fs::exists(journalDir)) << "Journal is not removed after generation";
+
+        size_t emptiedMethods = 0;
+        for (const auto &[sourceFilePath, tests] : resumedTestGen.tests) {
+            for (const auto &[methodName, methodDescription] : tests.methods) {
+                if (KleeUtils::entryPointFunction(tests, methodName, true) == emptiedDir.filename().string()) {
+                    EXPECT_TRUE(methodDescription.testCases.empty());
+                    emptiedMethods++;
+                } else {
+                    testUtils::checkMinNumberOfTests(methodDescription.testCases, 2);
+                }
+            }
+        }
+        EXPECT_EQ(1, emptiedMethods);
+    }
+
     TEST_P(Parameterized_Server_Test, Project_Test_Auto_Detect_Src_Paths) {
         std::string suite = "small-project";
         setSuite(suite);
@@ -1315,7 +1411,7 @@ namespace {
             static auto coverageAndResultsWriter =
                 std::make_unique<ServerCoverageAndResultsWriter>(nullptr);
             CoverageAndResultsGenerator coverageGenerator{request.get(), coverageAndResultsWriter.get()};
-            utbot::SettingsContext settingsContext{true, true, 30, 0, true, false, errorMode, false, false};
+            utbot::SettingsContext settingsContext{true, true, 30, 0, true, false, errorMode, false, false, false};
             coverageGenerator.generate(withCoverage, settingsContext);
             EXPECT_FALSE(coverageGenerator.hasExceptions());
             return coverageGenerator;
@@ -1418,6 +1514,56 @@ namespace {
         testUtils::checkStatusesCount(resultMap, tests, expectedStatusCountMap);
     }
 
+    /// runs listed tests separately, so that files can be changed after the tests are built
+    class ManifestTestRunner : public TestRunner {
+    public:
+        using TestRunner::TestRunner;
+        using TestRunner::runTests;
+    };
+
+    TEST_P(TestRunner_Test, Built_Tests_Are_Launched_Without_Make) {
+        ServerCoverageAndResultsWriter progressWriter{ nullptr };
+        ManifestTestRunner testRunner(*projectContext, dependent_functions_test_cpp.string(), "", "", "",
+                                      &progressWriter);
+        testRunner.init(false);
+        fs::path makefile = Paths::getMakefilePathFromSourceFilePath(*projectContext, dependent_functions_c);
+        ASSERT_TRUE(fs::exists(Paths::getRunManifestPath(makefile)));
+
+        // tests pass only if they are not launched by the run target
+        FileSystemUtils::writeToFile(makefile, "run:\n\tfalse\n");
+        testRunner.runTests(false, std::nullopt);
+
+        const auto &results = testRunner.getTestResultMap();
+        ASSERT_EQ(results.count(dependent_functions_test_cpp), 1u);
+        ASSERT_FALSE(results.at(dependent_functions_test_cpp).empty());
+        for (const auto &[testName, result] : results.at(dependent_functions_test_cpp)) {
+            EXPECT_EQ(result.status(), testsgen::TEST_PASSED) << testName;
+        }
+    }
+
+    TEST_P(TestRunner_Test, Tests_Are_Launched_By_Make_If_Manifest_Is_Newer_Than_Binaries) {
+        ServerCoverageAndResultsWriter progressWriter{ nullptr };
+        ManifestTestRunner testRunner(*projectContext, dependent_functions_test_cpp.string(), "", "", "",
+                                      &progressWriter);
+        testRunner.init(false);
+        fs::path makefile = Paths::getMakefilePathFromSourceFilePath(*projectContext, dependent_functions_c);
+        fs::path manifest = Paths::getRunManifestPath(makefile);
+        ASSERT_TRUE(fs::exists(manifest));
+
+        // binaries are not known to be built from the current makefiles, so the run target is used
+        std::filesystem::last_write_time(manifest.string(),
+                                         std::filesystem::file_time_type::clock::now() + std::chrono::hours(1));
+        FileSystemUtils::writeToFile(makefile, "run:\n\tfalse\n");
+        testRunner.runTests(false, std::nullopt);
+
+        const auto &results = testRunner.getTestResultMap();
+        ASSERT_EQ(results.count(dependent_functions_test_cpp), 1u);
+        ASSERT_FALSE(results.at(dependent_functions_test_cpp).empty());
+        for (const auto &[testName, result] : results.at(dependent_functions_test_cpp)) {
+            EXPECT_NE(result.status(), testsgen::TEST_PASSED) << testName;
+        }
+    }
+
     TEST_F(Server_Test, Halt_Test) {
         std::string suite = "halt";
         setSuite(suite);
@@ -1548,7 +1694,7 @@ namespace {
             buildDirRelPath, std::move(testFilter));
         auto coverageAndResultsWriter = std::make_unique<ServerCoverageAndResultsWriter>(nullptr);
         CoverageAndResultsGenerator coverageGenerator{runRequest.get(), coverageAndResultsWriter.get()};
-        utbot::SettingsContext settingsContext{true, true, 45, 0, true, false, ErrorMode::FAILING, false, false};
+        utbot::SettingsContext settingsContext{true, true, 45, 0, true, false, ErrorMode::FAILING, false, false, false};
         coverageGenerator.generate(false, settingsContext);
 
         ASSERT_TRUE(coverageGenerator.getCoverageMap().empty());
@@ -1607,7 +1753,7 @@ namespace {
             buildDirRelPath, std::move(testFilter));
         auto coverageAndResultsWriter = std::make_unique<ServerCoverageAndResultsWriter>(nullptr);
         CoverageAndResultsGenerator coverageGenerator{ runRequest.get(), coverageAndResultsWriter.get() };
-        utbot::SettingsContext settingsContext{ true, true, 45, 0, true, false, ErrorMode::FAILING, false, false};
+        utbot::SettingsContext settingsContext{ true, true, 45, 0, true, false, ErrorMode::FAILING, false, false, false};
         coverageGenerator.generate(false, settingsContext);
 
         ASSERT_TRUE(coverageGenerator.getCoverageMap().empty());
@@ -1654,7 +1800,7 @@ namespace {
                 buildDirRelPath, std::move(testFilter));
         auto coverageAndResultsWriter = std::make_unique<ServerCoverageAndResultsWriter>(nullptr);
         CoverageAndResultsGenerator coverageGenerator{runRequest.get(), coverageAndResultsWriter.get()};
-        utbot::SettingsContext settingsContext{true, true, 30, 0, true, false, ErrorMode::FAILING, false, false};
+        utbot::SettingsContext settingsContext{true, true, 30, 0, true, false, ErrorMode::FAILING, false, false, false};
         coverageGenerator.generate(false, settingsContext);
 
         ASSERT_TRUE(coverageGenerator.getCoverageMap().empty());
@@ -1703,7 +1849,7 @@ namespace {
                 buildDirRelPath, std::move(testFilter));
         auto coverageAndResultsWriter = std::make_unique<ServerCoverageAndResultsWriter>(nullptr);
         CoverageAndResultsGenerator coverageGenerator{runRequest.get(), coverageAndResultsWriter.get()};
-        utbot::SettingsContext settingsContext{true, true, 30, 0, true, false, ErrorMode::PASSING, false, false};
+        utbot::SettingsContext settingsContext{true, true, 30, 0, true, false, ErrorMode::PASSING, false, false, false};
         coverageGenerator.generate(false, settingsContext);
 
         ASSERT_TRUE(coverageGenerator.getCoverageMap().empty());
@@ -1750,7 +1896,7 @@ namespace {
                 buildDirRelPath, std::move(testFilter));
         auto coverageAndResultsWriter = std::make_unique<ServerCoverageAndResultsWriter>(nullptr);
         CoverageAndResultsGenerator coverageGenerator{runRequest.get(), coverageAndResultsWriter.get()};
-        utbot::SettingsContext settingsContext{true, true, 30, 0, true, false, ErrorMode::FAILING, false, false};
+        utbot::SettingsContext settingsContext{true, true, 30, 0, true, false, ErrorMode::FAILING, false, false, false};
         coverageGenerator.generate(false, settingsContext);
 
         ASSERT_TRUE(coverageGenerator.getCoverageMap().empty());
@@ -1797,7 +1943,7 @@ namespace {
                 buildDirRelPath, std::move(testFilter));
         auto coverageAndResultsWriter = std::make_unique<ServerCoverageAndResultsWriter>(nullptr);
         CoverageAndResultsGenerator coverageGenerator{runRequest.get(), coverageAndResultsWriter.get()};
-        utbot::SettingsContext settingsContext{true, true, 30, 0, true, false, ErrorMode::PASSING, false, false};
+        utbot::SettingsContext settingsContext{true, true, 30, 0, true, false, ErrorMode::PASSING, false, false, false};
         coverageGenerator.generate(false, settingsContext);
 
         ASSERT_TRUE(coverageGenerator.getCoverageMap().empty());
@@ -1870,7 +2016,7 @@ namespace {
                 buildDirRelPath, std::move(testFilter));
         auto coverageAndResultsWriter = std::make_unique<ServerCoverageAndResultsWriter>(nullptr);
         CoverageAndResultsGenerator coverageGenerator{request.get(), coverageAndResultsWriter.get()};
-        utbot::SettingsContext settingsContext{true, true, 15, timeout, true, false, ErrorMode::FAILING, false, false};
+        utbot::SettingsContext settingsContext{true, true, 15, timeout, true, false, ErrorMode::FAILING, false, false, false};
         coverageGenerator.generate(false, settingsContext);
 
         ASSERT_TRUE(coverageGenerator.getCoverageMap().empty());
@@ -1931,6 +2077,13 @@ namespace {
 
         Status status = Server::TestsGenServiceImpl::ProcessBaseTestRequest(testGen, writer.get());
         ASSERT_TRUE(status.ok()) << status.error_message();
+
+        fs::path functionStatsPath = Paths::getGenerationFunctionStatsCSVPath(testGen.projectContext);
+        ASSERT_TRUE(fs::exists(functionStatsPath));
+        std::ifstream inputStream(functionStatsPath);
+        StatsUtils::CSVTable csvTable = StatsUtils::readCSV(inputStream, ',');
+        EXPECT_TRUE(CollectionUtils::contains(csvTable["Function"], "my_sqr"));
+        EXPECT_EQ(csvTable["File"].size(), csvTable["Max States"].size());
     }
 
     TEST_F(Server_Test, Run_Tests_For_Linked_List) {
@@ -1956,7 +2109,7 @@ namespace {
         CoverageAndResultsGenerator coverageGenerator{ runRequest.get(),
                                                        coverageAndResultsWriter.get() };
         utbot::SettingsContext settingsContext{
-            true, false, 45, 0, false, false, ErrorMode::FAILING, false, false
+            true, false, 45, 0, false, false, ErrorMode::FAILING, false, false, false
         };
         coverageGenerator.generate(false, settingsContext);
 
@@ -1994,7 +2147,7 @@ namespace {
         CoverageAndResultsGenerator coverageGenerator{ runRequest.get(),
                                                        coverageAndResultsWriter.get() };
         utbot::SettingsContext settingsContext{
-            true, false, 15, 0, false, false, ErrorMode::FAILING, false, false
+            true, false, 15, 0, false, false, ErrorMode::FAILING, false, false, false
         };
         coverageGenerator.generate(false, settingsContext);
 
@@ -2033,7 +2186,7 @@ namespace {
         CoverageAndResultsGenerator coverageGenerator{ runRequest.get(),
                                                        coverageAndResultsWriter.get() };
         utbot::SettingsContext settingsContext{
-            true, false, 45, 0, false, false, ErrorMode::FAILING, false, false
+            true, false, 45, 0, false, false, ErrorMode::FAILING, false, false, false
         };
         coverageGenerator.generate(false, settingsContext);
 
@@ -2085,7 +2238,7 @@ namespace {
         CoverageAndResultsGenerator coverageGenerator{ runRequest.get(),
                                                        coverageAndResultsWriter.get() };
         utbot::SettingsContext settingsContext{
-            true, false, 45, 30, false, false, ErrorMode::FAILING, false, false
+            true, false, 45, 30, false, false, ErrorMode::FAILING, false, false, false
         };
         coverageGenerator.generate(false, settingsContext);
 
@@ -2122,7 +2275,7 @@ namespace {
         CoverageAndResultsGenerator coverageGenerator{ runRequest.get(),
                                                        coverageAndResultsWriter.get() };
         utbot::SettingsContext settingsContext{
-            true, false, 45, 0, false, false, ErrorMode::FAILING, false, false
+            true, false, 45, 0, false, false, ErrorMode::FAILING, false, false, false
         };
         coverageGenerator.generate(false, settingsContext);
 
@@ -2161,7 +2314,7 @@ namespace {
         CoverageAndResultsGenerator coverageGenerator{ runRequest.get(),
                                                        coverageAndResultsWriter.get() };
         utbot::SettingsContext settingsContext{
-            true, false, 45, 0, false, false, ErrorMode::FAILING, false, false
+            true, false, 45, 0, false, false, ErrorMode::FAILING, false, false, false
         };
         coverageGenerator.generate(false, settingsContext);
 
@@ -2200,7 +2353,7 @@ namespace {
         CoverageAndResultsGenerator coverageGenerator{ runRequest.get(),
                                                        coverageAndResultsWriter.get() };
         utbot::SettingsContext settingsContext{
-            true, false, 45, 0, false, false, ErrorMode::FAILING, false, false
+            true, false, 45, 0, false, false, ErrorMode::FAILING, false, false, false
         };
         coverageGenerator.generate(false, settingsContext);
 
@@ -2238,7 +2391,7 @@ namespace {
         CoverageAndResultsGenerator coverageGenerator{ runRequest.get(),
                                                        coverageAndResultsWriter.get() };
         utbot::SettingsContext settingsContext{
-            true, false, 45, 0, false, false, ErrorMode::FAILING, false, false
+            true, false, 45, 0, false, false, ErrorMode::FAILING, false, false, false
         };
         coverageGenerator.generate(false, settingsContext);
 
@@ -2276,7 +2429,7 @@ namespace {
         CoverageAndResultsGenerator coverageGenerator{runRequest.get(),
                                                       coverageAndResultsWriter.get()};
         utbot::SettingsContext settingsContext{
-                true, false, 45, 0, false, false, ErrorMode::FAILING, false, false
+                true, false, 45, 0, false, false, ErrorMode::FAILING, false, false, false
         };
         coverageGenerator.generate(false, settingsContext);
 
@@ -2314,7 +2467,7 @@ namespace {
         CoverageAndResultsGenerator coverageGenerator{runRequest.get(),
                                                       coverageAndResultsWriter.get()};
         utbot::SettingsContext settingsContext{
-                true, false, 45, 0, false, false, ErrorMode::FAILING, false, false
+                true, false, 45, 0, false, false, ErrorMode::FAILING, false, false, false
         };
         coverageGenerator.generate(false, settingsContext);
 
@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+
+#include "BaseTest.h"
+#include "SessionCache.h"
+#include "testgens/ProjectTestGen.h"
+#include "utils/FileSystemUtils.h"
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+namespace {
+    using testUtils::createProjectRequest;
+
+    class SessionCache_Test : public BaseTest {
+    protected:
+        SessionCache_Test() : BaseTest("stub") {}
+
+        fs::path calc = getTestFilePath("lib/calc");
+        fs::path calc_sum_c = calc / "sum.c";
+        fs::path calc_sum_h = calc / "sum.h";
+        fs::path calc_mult_c = calc / "mult.c";
+
+        std::unique_ptr<testsgen::ProjectRequest> request;
+
+        void SetUp() override {
+            clearTestDirectory();
+            clearEnv(CompilationUtils::CompilerName::CLANG);
+            srcPaths = { suitePath, getTestFilePath("lib/literals"), calc };
+            restoreSources();
+            request = createProjectRequest(projectName, suitePath, buildDirRelPath, srcPaths);
+        }
+
+        void TearDown() override {
+            restoreSources();
+        }
+
+        void restoreSources() {
+            FileSystemUtils::copyFile(suitePath / "original" / "sum.h", calc_sum_h);
+            FileSystemUtils::copyFile(suitePath / "original" / "sum.c", calc_sum_c);
+        }
+
+        void addStructToHeader() {
+            std::ifstream stream(calc_sum_h);
+            std::string content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+            stream.close();
+            FileSystemUtils::writeToFile(calc_sum_h, content + "\nstruct sum_pair {\n    int a;\n    int b;\n};\n");
+        }
+
+        /// every request creates its own test generator, as the server does
+        std::unique_ptr<ProjectTestGen> fetch(SessionCache &cache) {
+            auto testGen = std::make_unique<ProjectTestGen>(*request, writer.get(), TESTMODE);
+            size_t maximumAlignment = 0;
+            cache.fetch(*testGen, Fetcher::Options::Value::ALL, &maximumAlignment, "Fetching sources");
+            return testGen;
+        }
+
+        static bool hasStruct(const ProjectTestGen &testGen, const std::string &name) {
+            for (const auto &[id, structInfo] : testGen.types.structs) {
+                if (structInfo.name == name) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    TEST_F(SessionCache_Test, Sources_Are_Fetched_Again_After_Header_Edit) {
+        SessionCache cache(1);
+        auto first = fetch(cache);
+        EXPECT_FALSE(hasStruct(*first, "sum_pair"));
+        ASSERT_EQ(first->tests.at(calc_sum_c).methods.at("sum").params.size(), 2u);
+
+        // the source itself is not changed, only the header it includes
+        addStructToHeader();
+        auto second = fetch(cache);
+        EXPECT_TRUE(hasStruct(*second, "sum_pair"));
+        EXPECT_FALSE(second->tests.at(calc_mult_c).methods.empty());
+
+        FileSystemUtils::copyFile(suitePath / "modified" / "sum.h", calc_sum_h);
+        FileSystemUtils::copyFile(suitePath / "modified" / "sum.c", calc_sum_c);
+        auto third = fetch(cache);
+        EXPECT_EQ(third->tests.at(calc_sum_c).methods.at("sum").params.size(), 3u);
+    }
+
+    TEST_F(SessionCache_Test, Struct_Removed_From_Header_Is_Dropped) {
+        SessionCache cache(1);
+        addStructToHeader();
+        auto first = fetch(cache);
+        ASSERT_TRUE(hasStruct(*first, "sum_pair"));
+
+        restoreSources();
+        auto second = fetch(cache);
+        EXPECT_FALSE(hasStruct(*second, "sum_pair"));
+        EXPECT_FALSE(second->tests.at(calc_sum_c).methods.empty());
+    }
+
+    TEST_F(SessionCache_Test, Cached_Results_Match_Fetch_Without_Cache) {
+        SessionCache disabled(0);
+        auto expected = fetch(disabled);
+        SessionCache cache(1);
+        fetch(cache);
+        auto cached = fetch(cache);
+        ASSERT_EQ(cached->tests.size(), expected->tests.size());
+        for (auto it = expected->tests.begin(); it != expected->tests.end(); ++it) {
+            EXPECT_EQ(cached->tests.at(it.key()).methods.size(), it.value().methods.size()) << it.key();
+        }
+        EXPECT_EQ(cached->types.structs.size(), expected->types.structs.size());
+        EXPECT_EQ(cached->types.enums.size(), expected->types.enums.size());
+    }
+
+    TEST_F(SessionCache_Test, Build_Database_Is_Lent_To_One_Request_At_A_Time) {
+        SessionCache cache(1);
+        auto testGen = std::make_unique<ProjectTestGen>(*request, writer.get(), TESTMODE);
+        auto getDatabase = [&]() {
+            return cache.getProjectBuildDatabase(testGen->compileCommandsJsonPath, testGen->serverBuildDir,
+                                                 testGen->projectContext,
+                                                 testGen->settingsContext.skipObjectWithoutSource);
+        };
+        auto first = getDatabase();
+        auto second = getDatabase();
+        EXPECT_NE(first.get(), second.get());
+
+        ProjectBuildDatabase *cached = first.get();
+        first.reset();
+        second.reset();
+        EXPECT_EQ(getDatabase().get(), cached);
+    }
+}
@@ -63,8 +63,6 @@ namespace {
 
         static void checkStubFileNoChanges(const fs::path& stubFilePath, const std::string& expectedContent) {
             std::ifstream stream(stubFilePath);
-            std::string timestampComment;
-            getline(stream, timestampComment);
             std::string fileContent((std::istreambuf_iterator<char>(stream)),
                                             std::istreambuf_iterator<char>());
             std::string expectedContentCopy = expectedContent;
@@ -75,8 +73,6 @@ namespace {
 
         static void checkStubFileEqualsTo(const fs::path& stubFilePath, const fs::path& expectedFilePath) {
             std::ifstream stream(stubFilePath);
-            std::string timestampComment;
-            getline(stream, timestampComment);
             std::string stubFileContent((std::istreambuf_iterator<char>(stream)),
                                     std::istreambuf_iterator<char>());
             std::ifstream expectedFileStream(expectedFilePath);
@@ -94,13 +90,9 @@ namespace {
             std::string modifiedFileContent((std::istreambuf_iterator<char>(modifiedIStream)),
                                             std::istreambuf_iterator<char>());
 
-            std::ifstream stubIStream(stubFilePath);
-            std::string timestampComment;
-            getline(stubIStream, timestampComment);
-            stubIStream.close();
             std::ofstream stubOStream(stubFilePath);
-            std::string stubContent = timestampComment + modifiedFileContent;
-            stubOStream << stubContent;
+            stubOStream << modifiedFileContent;
+            stubOStream.close();
             auto fsNow = fs::file_time_type::clock::now();
             fs::last_write_time(stubFilePath, fsNow);
             return modifiedFileContent;
@@ -197,7 +189,7 @@ namespace {
         static auto coverageAndResultsWriter =
                 std::make_unique<ServerCoverageAndResultsWriter>(nullptr);
         CoverageAndResultsGenerator coverageGenerator{runRequest.get(), coverageAndResultsWriter.get()};
-        utbot::SettingsContext settingsContext{true, true, 15, 0, true, true, ErrorMode::FAILING, false, false};
+        utbot::SettingsContext settingsContext{true, true, 15, 0, true, true, ErrorMode::FAILING, false, false, false};
         coverageGenerator.generate(true, settingsContext);
         EXPECT_FALSE(coverageGenerator.hasExceptions());
     }
@@ -251,7 +243,7 @@ namespace {
         static auto coverageAndResultsWriter =
             std::make_unique<ServerCoverageAndResultsWriter>(nullptr);
         CoverageAndResultsGenerator coverageGenerator{ runRequest.get(), coverageAndResultsWriter.get() };
-        utbot::SettingsContext settingsContext{ true, true, 15, 0, true, true, ErrorMode::FAILING, false, false};
+        utbot::SettingsContext settingsContext{ true, true, 15, 0, true, true, ErrorMode::FAILING, false, false, false};
         coverageGenerator.generate(true, settingsContext);
         EXPECT_FALSE(coverageGenerator.hasExceptions());
     }
@@ -351,7 +343,7 @@ namespace {
         CoverageAndResultsGenerator coverageGenerator{runRequest.get(),
                                                       coverageAndResultsWriter.get()};
         utbot::SettingsContext settingsContext{
-                true, false, 45, 30, false, true, ErrorMode::FAILING, false, false
+                true, false, 45, 30, false, true, ErrorMode::FAILING, false, false, false
         };
         coverageGenerator.generate(false, settingsContext);
 
@@ -0,0 +1,146 @@
+#include "gtest/gtest.h"
+
+#include "SynchronizationIndex.h"
+#include "utils/FileSystemUtils.h"
+
+#include <chrono>
+#include <filesystem>
+#include <list>
+#include <optional>
+#include <string>
+
+namespace {
+    class SynchronizationIndex_Test : public testing::Test {
+    protected:
+        fs::path dir = fs::current_path() / "synchronization_index_test";
+        fs::path projectPath = dir / "project";
+        fs::path source = projectPath / "source.c";
+        fs::path indexPath = dir / "index.json";
+
+        void SetUp() override {
+            FileSystemUtils::removeAll(dir);
+        }
+
+        void TearDown() override {
+            FileSystemUtils::removeAll(dir);
+        }
+
+        std::optional<std::string> getFingerprint(SynchronizationIndex &index,
+                                                  const std::list<std::string> &commandLine) const {
+            return index.getFingerprint(source, commandLine, projectPath, projectPath);
+        }
+
+        /**
+         * @return true if fingerprint of the source changes when the header is changed
+         */
+        bool tracksHeader(const fs::path &header, const std::list<std::string> &commandLine) const {
+            SynchronizationIndex index(indexPath);
+            auto fingerprint = getFingerprint(index, commandLine);
+            FileSystemUtils::writeToFile(header, "#define CHANGED_HEADER 1\n");
+            auto changedFingerprint = getFingerprint(index, commandLine);
+            return fingerprint.has_value() && changedFingerprint.has_value() && fingerprint != changedFingerprint;
+        }
+    };
+
+    TEST_F(SynchronizationIndex_Test, Unchanged_Touched_Changed_And_Deleted_Files) {
+        fs::path header = projectPath / "header.h";
+        fs::path artifact = dir / "artifact.c";
+        FileSystemUtils::writeToFile(source, "#include \"header.h\"\n");
+        FileSystemUtils::writeToFile(header, "#define A 1\n");
+        FileSystemUtils::writeToFile(artifact, "int a;\n");
+        std::list<std::string> commandLine = { "gcc", "-c", "source.c" };
+
+        std::string fingerprint;
+        {
+            SynchronizationIndex index(indexPath);
+            auto computed = getFingerprint(index, commandLine);
+            ASSERT_TRUE(computed.has_value());
+            fingerprint = computed.value();
+            EXPECT_EQ(fingerprint.size(), 40u);
+            EXPECT_FALSE(index.isUpToDate(artifact, fingerprint));
+            index.update(artifact, fingerprint);
+            index.save();
+        }
+        // unchanged and touched files keep fingerprint of the saved index
+        std::filesystem::last_write_time(header.string(), std::filesystem::last_write_time(header.string()) +
+                                                              std::chrono::seconds(1));
+        {
+            SynchronizationIndex index(indexPath);
+            EXPECT_EQ(getFingerprint(index, commandLine), fingerprint);
+            EXPECT_TRUE(index.isUpToDate(artifact, fingerprint));
+        }
+        FileSystemUtils::writeToFile(header, "#define A 10\n");
+        std::optional<std::string> changedFingerprint;
+        {
+            SynchronizationIndex index(indexPath);
+            changedFingerprint = getFingerprint(index, commandLine);
+            ASSERT_TRUE(changedFingerprint.has_value());
+            EXPECT_NE(changedFingerprint, fingerprint);
+            EXPECT_FALSE(index.isUpToDate(artifact, changedFingerprint.value()));
+        }
+        // the include is not found anymore, so the source is outdated until the header is back
+        fs::remove(header);
+        {
+            SynchronizationIndex index(indexPath);
+            EXPECT_FALSE(getFingerprint(index, commandLine).has_value());
+        }
+        fs::remove(artifact);
+        {
+            SynchronizationIndex index(indexPath);
+            EXPECT_FALSE(index.isUpToDate(artifact, fingerprint));
+        }
+    }
+
+    TEST_F(SynchronizationIndex_Test, Headers_Are_Found_By_All_Include_Flags) {
+        FileSystemUtils::writeToFile(source, "#include <header.h>\n");
+        const std::list<std::list<std::string>> commandLines = {
+            { "gcc", "-Iinclude", "-c", "source.c" },
+            { "gcc", "-I", "include", "-c", "source.c" },
+            { "gcc", "-isystem", "include", "-c", "source.c" },
+            { "gcc", "-isysteminclude", "-c", "source.c" },
+            { "gcc", "-idirafter", "include", "-c", "source.c" },
+            { "clang", "--include-directory=include", "-c", "source.c" },
+            { "clang", "--include-directory", "include", "-c", "source.c" },
+        };
+        fs::path header = projectPath / "include" / "header.h";
+        for (const auto &commandLine : commandLines) {
+            FileSystemUtils::writeToFile(header, "#define HEADER 1\n");
+            EXPECT_TRUE(tracksHeader(header, commandLine)) << commandLine.front() << " " << *std::next(commandLine.begin());
+        }
+    }
+
+    TEST_F(SynchronizationIndex_Test, Forced_Includes_Are_Tracked) {
+        FileSystemUtils::writeToFile(source, "int a;\n");
+        fs::path header = projectPath / "config.h";
+        FileSystemUtils::writeToFile(header, "#define CONFIG 1\n");
+        EXPECT_TRUE(tracksHeader(header, { "gcc", "-include", "config.h", "-c", "source.c" }));
+        EXPECT_TRUE(tracksHeader(header, { "clang", "--include=config.h", "-c", "source.c" }));
+    }
+
+    TEST_F(SynchronizationIndex_Test, Quote_Dirs_Are_Used_Only_For_Quoted_Includes) {
+        fs::path header = projectPath / "quoted" / "header.h";
+        FileSystemUtils::writeToFile(header, "#define HEADER 1\n");
+        FileSystemUtils::writeToFile(source, "#include \"header.h\"\n");
+        EXPECT_TRUE(tracksHeader(header, { "gcc", "-iquote", "quoted", "-c", "source.c" }));
+
+        // a system header which is not found doesn't prevent fingerprinting
+        FileSystemUtils::writeToFile(source, "#include <header.h>\n");
+        SynchronizationIndex index(indexPath);
+        EXPECT_TRUE(getFingerprint(index, { "gcc", "-iquote", "quoted", "-c", "source.c" }).has_value());
+    }
+
+    TEST_F(SynchronizationIndex_Test, Unresolved_Quoted_And_Macro_Includes_Make_Source_Outdated) {
+        std::list<std::string> commandLine = { "gcc", "-c", "source.c" };
+        SynchronizationIndex index(indexPath);
+        FileSystemUtils::writeToFile(source, "#include \"generated.h\"\n");
+        EXPECT_FALSE(getFingerprint(index, commandLine).has_value());
+        FileSystemUtils::writeToFile(source, "#define HEADER \"header.h\"\n#include HEADER\n");
+        EXPECT_FALSE(getFingerprint(index, commandLine).has_value());
+
+        fs::path artifact = dir / "artifact.c";
+        FileSystemUtils::writeToFile(artifact, "int a;\n");
+        index.update(artifact, std::nullopt, { "a" });
+        EXPECT_FALSE(index.isUpToDate(artifact, ""));
+        EXPECT_EQ(index.findArtifactsBySymbol("a").size(), 1u);
+    }
+}
@@ -2770,6 +2770,15 @@ namespace {
         testUtils::checkMinNumberOfTests(testGen.tests.at(constructors_cpp).methods.begin().value().testCases, 2);
     }
 
+    TEST_F(Syntax_Test, Constructor_defined_in_header_is_not_mixed_with_source_lines_cpp) {
+        // Closet5 constructor defined in constructors.h spans the same lines
+        auto [testGen, status] = createTestForFunction(constructors_cpp, 79);
+
+        ASSERT_TRUE(status.ok()) << status.error_message();
+
+        EXPECT_EQ(testGen.tests.at(constructors_cpp).methods.begin().value().name, "Closet3::Closet3");
+    }
+
     TEST_F(Syntax_Test, Constructor_with_if_stmt_cpp) {
         auto [testGen, status] = createTestForFunction(constructors_cpp, 9);
 
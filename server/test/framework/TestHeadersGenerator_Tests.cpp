@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+
+#include "clang-utils/TestHeadersGenerator.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // time for the destructor to skip files which are not started
+    const auto DESTRUCTION_DELAY = std::chrono::milliseconds(200);
+
+    class TestHeadersGenerator_Test : public testing::Test {
+    protected:
+        tests::TestsMap tests;
+        std::vector<fs::path> files = { "/project/c.c", "/project/a.c", "/project/b.c" };
+
+        std::mutex generatedMutex;
+        std::vector<fs::path> generated;
+
+        void SetUp() override {
+            for (const auto &file : files) {
+                tests[file].sourceFilePath = file;
+            }
+        }
+
+        /// generator which records order of files and returns a header naming the file
+        TestHeadersGenerator::GenerateFactory recordingFactory() {
+            return [this]() -> TestHeadersGenerator::Generate {
+                return [this](const fs::path &sourceFilePath, const tests::Tests &, bool externFromStub) {
+                    std::lock_guard<std::mutex> lock(generatedMutex);
+                    generated.push_back(sourceFilePath);
+                    return sourceFilePath.string() + (externFromStub ? " extern" : "");
+                };
+            };
+        }
+    };
+
+    TEST_F(TestHeadersGenerator_Test, Files_Are_Generated_In_Order_Of_Tests) {
+        {
+            TestHeadersGenerator generator(tests, { files[1] }, recordingFactory(), 1);
+            for (auto it = tests.begin(); it != tests.end(); ++it) {
+                generator.setTestHeader(it.value());
+            }
+        }
+        EXPECT_EQ(generated, files);
+        EXPECT_EQ(tests.at(files[0]).headerCode, files[0].string());
+        EXPECT_EQ(tests.at(files[1]).headerCode, files[1].string() + " extern");
+        EXPECT_EQ(tests.at(files[2]).headerCode, files[2].string());
+    }
+
+    TEST_F(TestHeadersGenerator_Test, Exception_Is_Thrown_By_Set_Test_Header_Of_Its_File) {
+        auto factory = [this]() -> TestHeadersGenerator::Generate {
+            return [this](const fs::path &sourceFilePath, const tests::Tests &, bool) -> std::string {
+                if (sourceFilePath == files[1]) {
+                    throw std::runtime_error("failed to generate header");
+                }
+                return sourceFilePath.string();
+            };
+        };
+        TestHeadersGenerator generator(tests, {}, factory, 2);
+        EXPECT_THROW(generator.setTestHeader(tests.at(files[1])), std::runtime_error);
+        EXPECT_NO_THROW(generator.setTestHeader(tests.at(files[0])));
+        EXPECT_NO_THROW(generator.setTestHeader(tests.at(files[2])));
+        EXPECT_EQ(tests.at(files[2]).headerCode, files[2].string());
+
+        // files without tests are ignored
+        tests::Tests other;
+        other.sourceFilePath = "/project/other.c";
+        EXPECT_NO_THROW(generator.setTestHeader(other));
+        EXPECT_TRUE(other.headerCode.empty());
+    }
+
+    TEST_F(TestHeadersGenerator_Test, Destructor_Skips_Files_Which_Are_Not_Started) {
+        std::promise<void> unblock;
+        std::shared_future<void> unblocked = unblock.get_future().share();
+        std::promise<void> started;
+        auto factory = [&]() -> TestHeadersGenerator::Generate {
+            return [&](const fs::path &sourceFilePath, const tests::Tests &, bool) {
+                {
+                    std::lock_guard<std::mutex> lock(generatedMutex);
+                    generated.push_back(sourceFilePath);
+                }
+                if (sourceFilePath == files[0]) {
+                    started.set_value();
+                    unblocked.wait();
+                }
+                return sourceFilePath.string();
+            };
+        };
+        auto generator = std::make_unique<TestHeadersGenerator>(tests, CollectionUtils::FileSet{}, factory, 1);
+        started.get_future().wait();
+        std::thread destroyer([&]() { generator.reset(); });
+        std::this_thread::sleep_for(DESTRUCTION_DELAY);
+        unblock.set_value();
+        destroyer.join();
+        EXPECT_EQ(generated, std::vector<fs::path>{ files[0] });
+    }
+}
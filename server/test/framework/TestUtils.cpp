@@ -236,7 +236,7 @@ namespace testUtils {
                 projectName, projectPath, Paths::UTBOT_TESTS, Paths::UTBOT_REPORT, buildDirRelPath, itfRelPath);
         auto settingsContext =
                 GrpcUtils::createSettingsContext(true, verbose, kleeTimeout, 0, false, useStubs, errorMode,
-                                                 differentVariables, skipPrecompiled);
+                                                 differentVariables, skipPrecompiled, false);
         return GrpcUtils::createProjectRequest(std::move(projectContext),
                                                std::move(settingsContext),
                                                srcPaths,
@@ -300,7 +300,7 @@ namespace testUtils {
                                                               Paths::UTBOT_REPORT, "", Paths::UTBOT_ITF);
         // we actually don't pass all parameters except test directory and project name on client
         auto settingsContext = GrpcUtils::createSettingsContext(true, true, 10, 0, true, false, errorMode, false,
-                                                                false);
+                                                                false, false);
         return GrpcUtils::createSnippetRequest(std::move(projectContext),
                                                std::move(settingsContext), filePath);
     }
@@ -429,6 +429,11 @@ namespace testUtils {
                               const std::vector<fs::path> &containedFiles) {
         EXPECT_TRUE(fs::exists(statsPath));
         std::ifstream inputStream(statsPath);
+        std::string headerLine;
+        std::getline(inputStream, headerLine);
+        EXPECT_EQ(headerLine, StringUtils::joinWith(header, ","));
+        inputStream.clear();
+        inputStream.seekg(0);
         StatsUtils::CSVTable csvTable = StatsUtils::readCSV(inputStream, ',');
         for (const auto &label : header) {
             EXPECT_TRUE(CollectionUtils::containsKey(csvTable, label)) <<
@@ -444,9 +449,10 @@ namespace testUtils {
     }
 
     void checkGenerationStatsCSV(const fs::path &statsPath, const std::vector<fs::path> &containedFiles) {
+        // new columns are appended, consumers of the report may rely on positions of old ones
         std::vector<std::string> header = {"File", "Klee Time (s)", "Solver Time (s)", "Resolution Time (s)",
                                            "Regression Tests Generated", "Error Tests Generated",
-                                           "Covered Functions", "Total functions"};
+                                           "Covered Functions", "Total functions", "Solver Queries", "Max States"};
         checkStatsCSV(statsPath, header, containedFiles);
     }
 
@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+
+#include "BaseTest.h"
+#include "fetchers/Fetcher.h"
+#include "testgens/ProjectTestGen.h"
+#include "types/Types.h"
+
+namespace {
+    using types::TypeUsage;
+
+    TEST(TypesHandler_Test, Support_Is_Checked_Per_Usage) {
+        types::TypeMaps typeMaps;
+        types::TypesHandler typesHandler(typeMaps, types::TypesHandler::SizeContext());
+        auto pointer = types::Type::createSimpleTypeFromName("int", 3);
+
+        // results for one usage are not reused for another
+        for (int i = 0; i < 2; ++i) {
+            auto parameter = typesHandler.isSupportedType(pointer, TypeUsage::PARAMETER);
+            EXPECT_FALSE(parameter.isSupported);
+            EXPECT_EQ(parameter.info, "Dimension of pointer is too big");
+            auto returned = typesHandler.isSupportedType(pointer, TypeUsage::RETURN);
+            EXPECT_TRUE(returned.isSupported) << returned.info;
+        }
+
+        // types of the same name share results
+        auto unknown = typesHandler.isSupportedType(types::Type::createSimpleTypeFromName("struct Unknown"));
+        EXPECT_FALSE(unknown.isSupported);
+        EXPECT_EQ(unknown.info, "Type is unknown");
+        EXPECT_FALSE(typesHandler.isSupportedType(types::Type::createSimpleTypeFromName("struct Unknown")).isSupported);
+    }
+
+    class TypesHandler_Server_Test : public BaseTest {
+    protected:
+        TypesHandler_Server_Test() : BaseTest("server") {}
+
+        fs::path linked_list_c = getTestFilePath("linked_list.c");
+        fs::path complex_structs_c = getTestFilePath("complex_structs.c");
+
+        std::unique_ptr<ProjectTestGen> testGen;
+        types::TypesHandler::SizeContext sizeContext;
+
+        void SetUp() override {
+            clearEnv(CompilationUtils::CompilerName::CLANG);
+            auto request = testUtils::createProjectRequest(projectName, suitePath, buildDirRelPath, srcPaths);
+            testGen = std::make_unique<ProjectTestGen>(*request, writer.get(), TESTMODE);
+            Fetcher fetcher(Fetcher::Options::Value::TYPE | Fetcher::Options::Value::FUNCTION,
+                            testGen->getTargetBuildDatabase()->compilationDatabase, testGen->tests, &testGen->types,
+                            &sizeContext.maximumAlignment, testGen->compileCommandsJsonPath, false);
+            fetcher.fetch();
+        }
+
+        const types::Type &getParamType(const fs::path &sourcePath, const std::string &methodName) const {
+            return testGen->tests.at(sourcePath).methods.at(methodName).params.at(0).type;
+        }
+    };
+
+    TEST_F(TypesHandler_Server_Test, Struct_Info_Is_Returned_From_Type_Maps) {
+        types::TypesHandler typesHandler(testGen->types, sizeContext);
+        const auto &type = getParamType(complex_structs_c, "struct_has_alphabet");
+        ASSERT_TRUE(typesHandler.isStructLike(type));
+
+        const auto &structInfo = typesHandler.getStructInfo(type);
+        EXPECT_EQ(&structInfo, &testGen->types.structs.at(type.getId()));
+        EXPECT_EQ(&structInfo, &typesHandler.getStructInfo(type.getId()));
+        EXPECT_EQ(structInfo.fields.size(), 2u);
+    }
+
+    TEST_F(TypesHandler_Server_Test, Recursive_Structs_Are_Supported) {
+        types::TypesHandler typesHandler(testGen->types, sizeContext);
+        for (const auto &methodName : { "hard_length2", "middle_length2", "length_of_linked_list3" }) {
+            const auto &type = getParamType(linked_list_c, methodName);
+            auto support = typesHandler.isSupportedType(type, TypeUsage::PARAMETER);
+            EXPECT_TRUE(support.isSupported) << methodName << ": " << support.info;
+
+            // recursion guard of the struct is released, so its fields are supported on their own too
+            const auto &structInfo = typesHandler.getStructInfo(type.baseTypeObj());
+            for (const auto &field : structInfo.fields) {
+                auto fieldSupport = typesHandler.isSupportedType(field.type, TypeUsage::PARAMETER);
+                EXPECT_TRUE(fieldSupport.isSupported) << methodName << "." << field.name << ": " << fieldSupport.info;
+            }
+        }
+    }
+}
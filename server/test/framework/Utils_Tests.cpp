@@ -1,16 +1,27 @@
 #include "gtest/gtest.h"
 
+#include "KleeResultsCache.h"
+#include "LineIndex.h"
 #include "TestUtils.h"
 #include "utils/CollectionUtils.h"
 #include "utils/CompilationUtils.h"
 #include "utils/ExecUtils.h"
+#include "utils/FileSystemUtils.h"
+#include "utils/KleeUtils.h"
+#include "utils/LogRingBuffer.h"
+#include "utils/ParallelUtils.h"
+#include "utils/ResourceScheduler.h"
 #include "utils/StringUtils.h"
 
 #include <algorithm>
+#include <chrono>
 #include <climits>
 #include <limits>
+#include <mutex>
 #include <random>
+#include <set>
 #include <string>
+#include <thread>
 
 namespace {
     auto projectPath = fs::current_path().parent_path() / testUtils::getRelativeTestSuitePath("server");
@@ -324,6 +335,66 @@ namespace {
         EXPECT_EQ(tests::readBytesAsValue<unsigned int>(bytes, offset, len), "131071");
     }
 
+    TEST(ReadBytesAsValueTest, ForKindDecodesByKind) {
+        size_t const LEN = 16;
+        std::vector<char> bytes(LEN);
+        bytes[3] = 1;
+        bytes[2] = bytes[1] = bytes[0] = -1;
+        struct Case {
+            std::string typeName;
+            size_t offsetInBits;
+            size_t lenInBits;
+            std::string expected;
+        };
+        const std::vector<Case> cases = { { "int", 0, 32, "33554431" },
+                                          { "unsigned int", 0, 32, "33554431" },
+                                          { "short", 0, 16, "-1" },
+                                          { "unsigned short", 0, 16, "65535" },
+                                          { "long long", 0, 64, "33554431" },
+                                          { "char", 0, 8, "-1" },
+                                          { "unsigned char", 0, 8, "255" },
+                                          { "_Bool", 24, 8, "1" },
+                                          { "std::uintptr_t", 0, 64, "33554431" } };
+        for (const auto &[typeName, offsetInBits, lenInBits, expected] : cases) {
+            types::PrimitiveKind kind = types::getPrimitiveKind(typeName);
+            EXPECT_NE(kind, types::PrimitiveKind::NONE) << typeName;
+            EXPECT_EQ(types::Type::createSimpleTypeFromName(typeName).primitiveKind(), kind) << typeName;
+            EXPECT_EQ(tests::readBytesAsValueForKind(bytes, kind, offsetInBits, lenInBits), expected) << typeName;
+        }
+        EXPECT_EQ(types::getPrimitiveKind("struct S"), types::PrimitiveKind::NONE);
+        EXPECT_EQ(tests::readBytesAsValueForKind(bytes, types::PrimitiveKind::NONE, 0, 16), "");
+    }
+
+    TEST(PrimitiveArrayValueViewTest, ElementsMatchPrimitiveViews) {
+        std::vector<char> bytes(12);
+        bytes[0] = 1;
+        bytes[4] = -1;
+        bytes[5] = -1;
+        bytes[6] = -1;
+        bytes[7] = -1;
+        tests::PrimitiveArrayValueView view(bytes, types::Type::createSimpleTypeFromName("unsigned int"), 32);
+        EXPECT_EQ(view.getEntryValue(nullptr), "{1U, 4294967295U, 0U}");
+        ASSERT_EQ(view.getSubViews().size(), 3u);
+        EXPECT_EQ(view.getSubViews()[1]->getEntryValue(nullptr), "4294967295U");
+        EXPECT_FALSE(view.containsFPSpecialValue());
+    }
+
+    TEST(PrimitiveArrayValueViewTest, TrailingZerosAreTrimmedOnlyOnRequest) {
+        std::vector<char> bytes(12);
+        bytes[0] = 1;
+        tests::PrimitiveArrayValueView view(bytes, types::Type::createSimpleTypeFromName("int"), 32);
+        EXPECT_EQ(view.getEntryValue(nullptr), "{1, 0, 0}");
+        EXPECT_EQ(view.getEntryValue(nullptr, false), "{1, 0, 0}");
+        EXPECT_EQ(view.getEntryValue(nullptr, true), "{1}");
+
+        tests::PrimitiveArrayValueView zeros(std::vector<char>(12), types::Type::createSimpleTypeFromName("int"), 32);
+        EXPECT_EQ(zeros.getEntryValue(nullptr, true), "{0}");
+
+        std::vector<char> characters = { 'a', 0, 0 };
+        tests::PrimitiveArrayValueView string(characters, types::Type::createSimpleTypeFromName("char"), 8);
+        EXPECT_EQ(string.getEntryValue(nullptr, true), string.getEntryValue(nullptr, false));
+    }
+
     template<typename T>
     void readBytesAsValueTestTemplate(T val) {
         size_t const len = sizeof(T);
@@ -537,4 +608,118 @@ namespace {
     TEST(Utils_Test, AddExtension) {
         EXPECT_EQ(Paths::addExtension("/a/b", ".cpp"), "/a/b.cpp");
     }
+
+    TEST(Utils_Test, LogRingBufferDropsOldest) {
+        LogRingBuffer buffer(4);
+        for (int i = 0; i < 6; i++) {
+            buffer.push(std::to_string(i));
+        }
+        EXPECT_EQ(buffer.takeDroppedCount(), 2);
+        EXPECT_EQ(buffer.takeDroppedCount(), 0);
+        std::string entry;
+        for (int i = 2; i < 6; i++) {
+            EXPECT_TRUE(buffer.tryPop(entry));
+            EXPECT_EQ(entry, std::to_string(i));
+        }
+        EXPECT_TRUE(buffer.empty());
+        EXPECT_FALSE(buffer.tryPop(entry));
+    }
+
+    TEST(Utils_Test, ResourceSchedulerGivesAllTokensToSingleClient) {
+        ResourceScheduler scheduler(4, 0);
+        {
+            auto tokens = scheduler.acquire(ResourceScheduler::Kind::COMPILER_JOB, 8, 1);
+            EXPECT_EQ(tokens.count(), 4);
+        }
+        auto first = scheduler.acquire(ResourceScheduler::Kind::KLEE_PROCESS, 3, 1);
+        auto second = scheduler.acquire(ResourceScheduler::Kind::TEST_PROCESS, 3, 1);
+        EXPECT_EQ(first.count(), 3);
+        EXPECT_EQ(second.count(), 1);
+    }
+
+    TEST(Utils_Test, ParallelForEachWorkersHaveClientOfRequest) {
+        std::vector<int> items(64);
+        std::mutex clientsMutex;
+        std::set<std::string> clients;
+        // client is set in a separate thread, so the thread of the test stays without client
+        std::thread request([&]() {
+            RequestEnvironment::setClientId("parallel_client");
+            ParallelUtils::forEach(items, 4, [&](int &) {
+                std::string client = RequestEnvironment::clientId.value_or("");
+                std::lock_guard<std::mutex> lock(clientsMutex);
+                clients.insert(client);
+            });
+        });
+        request.join();
+        EXPECT_EQ(clients, std::set<std::string>{ "parallel_client" });
+    }
+
+    TEST(Utils_Test, LineIndexFindsInnermostStatement) {
+        using Kind = LineIndex::StatementKind;
+        LineIndex lineIndex;
+        uint32_t body = lineIndex.addFunction("f", "file", { 1, 6 }, { 1, 6 });
+        uint32_t first = lineIndex.addChildren(body, { { Kind::OTHER, { 2, 2 } }, { Kind::BRANCH, { 3, 5 } } });
+        uint32_t branch = lineIndex.addChildren(first + 1, { { Kind::OTHER, { 3, 3 } }, { Kind::OTHER, { 3, 5 } } });
+        lineIndex.addChildren(branch + 1, { { Kind::RETURN, { 4, 4 } } });
+
+        LineInfo returnLine = lineIndex.findLine("file.c", 4);
+        EXPECT_TRUE(returnLine.initialized);
+        EXPECT_EQ(returnLine.methodName, "f");
+        EXPECT_EQ(returnLine.begin, 4);
+        EXPECT_TRUE(returnLine.wrapInBrackets);
+        EXPECT_FALSE(returnLine.insertAfter);
+
+        LineInfo branchLine = lineIndex.findLine("file.c", 3);
+        EXPECT_EQ(branchLine.begin, 3);
+        EXPECT_EQ(branchLine.end, 5);
+        EXPECT_FALSE(branchLine.wrapInBrackets);
+
+        EXPECT_FALSE(lineIndex.findLine("file.c", 7).initialized);
+    }
+
+    TEST(Utils_Test, KleeResultsCacheReusesOnlyUnchangedFunctions) {
+        fs::path dir = fs::current_path() / "klee_results_cache_test";
+        FileSystemUtils::removeAll(dir);
+        utbot::ProjectContext projectContext("cache", dir / "project", dir / "project", "tests", "report",
+                                             "build", "");
+        utbot::SettingsContext settingsContext{ true, false, 30, 0, true, false, testsgen::ErrorMode::FAILING,
+                                                false, false, true };
+        tests::Tests tests;
+        tests.sourceFilePath = dir / "project" / "lib" / "sum.c";
+        tests.relativeFileDir = "lib";
+        tests.sourceFileNameNoExt = "sum";
+        fs::path bitcode = dir / "sum.ll";
+        tests::TestMethod sum("sum", bitcode, tests.sourceFilePath, false);
+        tests::TestMethod other("other", bitcode, tests.sourceFilePath, false);
+        auto writeModule = [&](const std::string &calleeBody) {
+            std::string module = "define i32 @callee(i32 %x) {\n" + calleeBody + "\n}\n";
+            for (const auto &method : { sum, other }) {
+                std::string entryPoint = KleeUtils::entryPointFunction(tests, method.methodName, true);
+                std::string callee = method.methodName == "sum" ? "callee" : "other_callee";
+                module += "define i32 @" + entryPoint + "() {\n  %r = call i32 @" + callee +
+                          "(i32 1)\n  ret i32 %r\n}\n";
+            }
+            module += "define i32 @other_callee(i32 %x) {\n  ret i32 %x\n}\n";
+            FileSystemUtils::writeToFile(bitcode, module);
+        };
+        fs::path kleeOut = dir / "klee_out";
+        FileSystemUtils::writeToFile(kleeOut / "test000001.ktest", "");
+
+        writeModule("  ret i32 %x");
+        {
+            KleeResultsCache cache(projectContext, settingsContext, dir / "results");
+            EXPECT_FALSE(cache.find(tests, sum).has_value());
+            cache.save(tests, sum, kleeOut);
+            cache.save(tests, other, kleeOut);
+        }
+        writeModule("  %y = add i32 %x, 1\n  ret i32 %y");
+        {
+            KleeResultsCache cache(projectContext, settingsContext, dir / "results");
+            EXPECT_FALSE(cache.find(tests, sum).has_value());
+            auto reused = cache.find(tests, other);
+            ASSERT_TRUE(reused.has_value());
+            EXPECT_TRUE(fs::exists(reused.value() / "test000001.ktest"));
+        }
+        FileSystemUtils::removeAll(dir);
+    }
 }
@@ -69,5 +69,19 @@ struct Closet4 {
     Closet4(double length_, double width_, double height_);
 };
 
+struct Closet5 {
+    double length;
+    double width;
+    double height;
+    double volume;
+
+    Closet5(double length_, double width_, double height_) {
+        length = length_;
+        width = width_;
+        height = height_;
+        volume = height * width * length;
+    }
+};
+
 
 #endif // UNITTESTBOT_CONSTRUCTORS_H